@@ -0,0 +1,60 @@
+#ifndef _NATIVE_EEPROM_H_
+#define _NATIVE_EEPROM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+// Emulated EEPROM in memory, starts erased (0xff) like a fresh flash page
+class EEPROMClass {
+public:
+  bool begin(size_t size);
+  void end() {}
+  bool commit() { return true; }
+  size_t length() { return data_.size(); }
+  uint8_t* getDataPtr() { return data_.data(); }
+
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+
+  template <typename T>
+  T& get(int address, T& t) {
+    if (address >= 0 && address + sizeof(T) <= data_.size()) {
+      memcpy((void*)&t, &data_[address], sizeof(T));
+    }
+    return t;
+  }
+  template <typename T>
+  const T& put(int address, const T& t) {
+    if (address >= 0 && address + sizeof(T) <= data_.size()) {
+      memcpy(&data_[address], (const void*)&t, sizeof(T));
+    }
+    return t;
+  }
+
+  uint8_t readByte(int address) { return read(address); }
+  uint16_t readUShort(int address) { uint16_t v = 0; return get(address, v); }
+  uint32_t readUInt(int address) { uint32_t v = 0; return get(address, v); }
+  uint32_t readULong(int address) { uint32_t v = 0; return get(address, v); }
+  int64_t readLong64(int address) { int64_t v = 0; return get(address, v); }
+  uint64_t readULong64(int address) { uint64_t v = 0; return get(address, v); }
+  float readFloat(int address) { float v = 0; return get(address, v); }
+  double readDouble(int address) { double v = 0; return get(address, v); }
+
+  size_t writeByte(int address, uint8_t value) { write(address, value); return 1; }
+  size_t writeUShort(int address, uint16_t value) { put(address, value); return sizeof(value); }
+  size_t writeUInt(int address, uint32_t value) { put(address, value); return sizeof(value); }
+  size_t writeULong(int address, uint32_t value) { put(address, value); return sizeof(value); }
+  size_t writeLong64(int address, int64_t value) { put(address, value); return sizeof(value); }
+  size_t writeULong64(int address, uint64_t value) { put(address, value); return sizeof(value); }
+  size_t writeFloat(int address, float value) { put(address, value); return sizeof(value); }
+  size_t writeDouble(int address, double value) { put(address, value); return sizeof(value); }
+
+private:
+  std::vector<uint8_t> data_;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef _NATIVE_ESP_H_
+#define _NATIVE_ESP_H_
+
+#include <stdint.h>
+
+// Heap figures are nominal, the host has no fixed heap
+class EspClass {
+public:
+  uint32_t getHeapSize() { return 320 * 1024; }
+  uint32_t getFreeHeap() { return 200 * 1024; }
+  uint32_t getMinFreeHeap() { return 150 * 1024; }
+  uint32_t getMaxAllocHeap() { return 100 * 1024; }
+  uint32_t getPsramSize() { return 8 * 1024 * 1024; }
+  uint32_t getFreePsram() { return 8 * 1024 * 1024; }
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getCycleCount();
+  const char* getSdkVersion() { return "native"; }
+  void restart();
+};
+
+extern EspClass ESP;
+
+#endif
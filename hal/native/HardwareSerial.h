@@ -0,0 +1,43 @@
+#ifndef _NATIVE_HARDWARESERIAL_H_
+#define _NATIVE_HARDWARESERIAL_H_
+
+#include <deque>
+#include <mutex>
+#include "Stream.h"
+
+#define SERIAL_8N1 0x800001c
+
+// Output goes to stdout (Serial) or is discarded (Serial1, Serial2). Input
+// is whatever inject() queued, e.g. NMEA sentences for the GPS task.
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(int uart) : uart_(uart) {}
+
+  void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rx_pin = -1,
+             int8_t tx_pin = -1, bool invert = false, unsigned long timeout_ms = 20000UL) {}
+  void end() {}
+  operator bool() const { return true; }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t size) override;
+  using Print::write;
+  void flush() override;
+
+  int available() override;
+  int read() override;
+  int peek() override;
+
+  void inject(const uint8_t* data, size_t len);
+  void inject(const char* text) { inject((const uint8_t*)text, strlen(text)); }
+
+private:
+  int uart_;
+  std::mutex rx_mutex_;
+  std::deque<uint8_t> rx_;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+#endif
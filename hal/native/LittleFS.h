@@ -0,0 +1,21 @@
+#ifndef _NATIVE_LITTLEFS_H_
+#define _NATIVE_LITTLEFS_H_
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+  LittleFSFS() : FS("littlefs") {}
+  bool begin(bool format_on_fail = false, const char* base_path = "/littlefs",
+             uint8_t max_open_files = 10, const char* partition_label = "spiffs");
+  bool format();
+  void end() {}
+};
+
+}  // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef _NATIVE_M5UNIFIED_H_
+#define _NATIVE_M5UNIFIED_H_
+
+// Display and input are not part of the native build, this only satisfies
+// headers that include M5Unified without using it
+#include "Arduino.h"
+
+#endif
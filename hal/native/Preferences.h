@@ -0,0 +1,63 @@
+#ifndef _NATIVE_PREFERENCES_H_
+#define _NATIVE_PREFERENCES_H_
+
+#include "Arduino.h"
+#include "nvs.h"
+
+class Preferences {
+public:
+  ~Preferences() { end(); }
+
+  bool begin(const char* name, bool read_only = false, const char* partition_label = nullptr);
+  void end();
+  bool clear();
+  bool remove(const char* key);
+  bool isKey(const char* key);
+
+  size_t putBool(const char* key, bool value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putUChar(const char* key, uint8_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putShort(const char* key, int16_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putUShort(const char* key, uint16_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putInt(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putLong(const char* key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putULong(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putLong64(const char* key, int64_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putULong64(const char* key, uint64_t value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putFloat(const char* key, float value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putDouble(const char* key, double value) { return putBytes(key, &value, sizeof(value)); }
+  size_t putString(const char* key, const char* value);
+  size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+  size_t putBytes(const char* key, const void* value, size_t len);
+
+  bool getBool(const char* key, bool default_value = false) { return get(key, default_value); }
+  uint8_t getUChar(const char* key, uint8_t default_value = 0) { return get(key, default_value); }
+  int16_t getShort(const char* key, int16_t default_value = 0) { return get(key, default_value); }
+  uint16_t getUShort(const char* key, uint16_t default_value = 0) { return get(key, default_value); }
+  int32_t getInt(const char* key, int32_t default_value = 0) { return get(key, default_value); }
+  uint32_t getUInt(const char* key, uint32_t default_value = 0) { return get(key, default_value); }
+  int32_t getLong(const char* key, int32_t default_value = 0) { return get(key, default_value); }
+  uint32_t getULong(const char* key, uint32_t default_value = 0) { return get(key, default_value); }
+  int64_t getLong64(const char* key, int64_t default_value = 0) { return get(key, default_value); }
+  uint64_t getULong64(const char* key, uint64_t default_value = 0) { return get(key, default_value); }
+  float getFloat(const char* key, float default_value = NAN) { return get(key, default_value); }
+  double getDouble(const char* key, double default_value = NAN) { return get(key, default_value); }
+  size_t getString(const char* key, char* value, size_t max_len);
+  String getString(const char* key, const String& default_value = String());
+  size_t getBytesLength(const char* key);
+  size_t getBytes(const char* key, void* buf, size_t max_len);
+
+private:
+  template <typename T>
+  T get(const char* key, T default_value) {
+    T value;
+    return getBytesLength(key) == sizeof(T) && getBytes(key, &value, sizeof(T)) == sizeof(T)
+               ? value : default_value;
+  }
+
+  nvs_handle_t handle_ = 0;
+  bool started_ = false;
+  bool read_only_ = false;
+};
+
+#endif
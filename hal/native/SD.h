@@ -0,0 +1,36 @@
+#ifndef _NATIVE_SD_H_
+#define _NATIVE_SD_H_
+
+#include "FS.h"
+#include "SPI.h"
+
+typedef enum {
+  CARD_NONE,
+  CARD_MMC,
+  CARD_SD,
+  CARD_SDHC,
+  CARD_UNKNOWN
+} sdcard_type_t;
+
+namespace fs {
+
+// The card is present when <root>/sd exists on the host
+class SDFS : public FS {
+public:
+  SDFS() : FS("sd") {}
+  bool begin(uint8_t ss_pin = 0, SPIClass& spi = SPI, uint32_t frequency = 4000000,
+             const char* mountpoint = "/sd", uint8_t max_files = 5, bool format_if_empty = false);
+  void end() { mounted_ = false; }
+  sdcard_type_t cardType() { return mounted_ ? CARD_SDHC : CARD_NONE; }
+  uint64_t cardSize() { return mounted_ ? 4ULL * 1024 * 1024 * 1024 : 0; }
+  uint64_t totalBytes() { return cardSize(); }
+
+private:
+  bool mounted_ = false;
+};
+
+}  // namespace fs
+
+extern fs::SDFS SD;
+
+#endif
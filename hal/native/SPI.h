@@ -0,0 +1,19 @@
+#ifndef _NATIVE_SPI_H_
+#define _NATIVE_SPI_H_
+
+#include <stdint.h>
+
+#define FSPI 0
+#define HSPI 1
+#define VSPI 2
+
+class SPIClass {
+public:
+  explicit SPIClass(uint8_t bus = HSPI) {}
+  void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {}
+  void end() {}
+};
+
+extern SPIClass SPI;
+
+#endif
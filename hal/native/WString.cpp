@@ -0,0 +1,253 @@
+#include "Arduino.h"
+#include <ctype.h>
+
+static std::string formatInteger(unsigned long long value, bool negative, unsigned char base) {
+  if (base < 2 || base > 36) {
+    base = 10;
+  }
+  char buf[66];
+  char* p = buf + sizeof(buf) - 1;
+  *p = '\0';
+  do {
+    unsigned digit = value % base;
+    *--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    value /= base;
+  } while (value > 0);
+  if (negative) {
+    *--p = '-';
+  }
+  return p;
+}
+
+static std::string formatSigned(long long value, unsigned char base) {
+  // Like the Arduino core, only base 10 prints a sign
+  if (base == 10 && value < 0) {
+    return formatInteger(0ULL - (unsigned long long)value, true, base);
+  }
+  return formatInteger((unsigned long long)value, false, base);
+}
+
+static std::string formatDouble(double value, unsigned int decimals) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", (int)decimals, value);
+  return buf;
+}
+
+String::String(const char* cstr) : s_(cstr ? cstr : "") {}
+String::String(const char* cstr, unsigned int length) : s_(cstr ? std::string(cstr, length) : "") {}
+String::String(char c) : s_(1, c) {}
+String::String(unsigned char value, unsigned char base) : s_(formatInteger(value, false, base)) {}
+String::String(int value, unsigned char base) : s_(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base) : s_(formatInteger(value, false, base)) {}
+String::String(long value, unsigned char base) : s_(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base) : s_(formatInteger(value, false, base)) {}
+String::String(long long value, unsigned char base) : s_(formatSigned(value, base)) {}
+String::String(unsigned long long value, unsigned char base) : s_(formatInteger(value, false, base)) {}
+String::String(float value, unsigned int decimals) : s_(formatDouble(value, decimals)) {}
+String::String(double value, unsigned int decimals) : s_(formatDouble(value, decimals)) {}
+
+String& String::operator=(const char* cstr) {
+  s_ = cstr ? cstr : "";
+  return *this;
+}
+
+bool String::reserve(unsigned int size) {
+  s_.reserve(size);
+  return true;
+}
+
+bool String::concat(const String& str) {
+  s_ += str.s_;
+  return true;
+}
+
+bool String::concat(const char* cstr) {
+  if (cstr == nullptr) return false;
+  s_ += cstr;
+  return true;
+}
+
+bool String::concat(const char* cstr, unsigned int length) {
+  if (cstr == nullptr) return false;
+  s_.append(cstr, length);
+  return true;
+}
+
+bool String::concat(char c) {
+  s_ += c;
+  return true;
+}
+
+int String::compareTo(const String& s) const {
+  return s_.compare(s.s_);
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+  if (s_.size() != s.s_.size()) return false;
+  for (size_t i = 0; i < s_.size(); i++) {
+    if (tolower((unsigned char)s_[i]) != tolower((unsigned char)s.s_[i])) return false;
+  }
+  return true;
+}
+
+bool String::startsWith(const String& prefix) const {
+  return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+  if (offset > s_.size() || prefix.s_.size() > s_.size() - offset) return false;
+  return s_.compare(offset, prefix.s_.size(), prefix.s_) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+  if (suffix.s_.size() > s_.size()) return false;
+  return s_.compare(s_.size() - suffix.s_.size(), suffix.s_.size(), suffix.s_) == 0;
+}
+
+void String::setCharAt(unsigned int index, char c) {
+  if (index < s_.size()) {
+    s_[index] = c;
+  }
+}
+
+char& String::operator[](unsigned int index) {
+  static char dummy;
+  if (index >= s_.size()) {
+    dummy = 0;
+    return dummy;
+  }
+  return s_[index];
+}
+
+void String::getBytes(unsigned char* buf, unsigned int size, unsigned int index) const {
+  if (size == 0 || buf == nullptr) return;
+  if (index >= s_.size()) {
+    buf[0] = 0;
+    return;
+  }
+  size_t n = std::min((size_t)size - 1, s_.size() - index);
+  memcpy(buf, s_.data() + index, n);
+  buf[n] = 0;
+}
+
+static int position(size_t pos) {
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(char ch, unsigned int from) const {
+  return position(s_.find(ch, from));
+}
+
+int String::indexOf(const String& str, unsigned int from) const {
+  return position(s_.find(str.s_, from));
+}
+
+int String::lastIndexOf(char ch) const {
+  return position(s_.rfind(ch));
+}
+
+int String::lastIndexOf(char ch, unsigned int from) const {
+  return position(s_.rfind(ch, from));
+}
+
+int String::lastIndexOf(const String& str) const {
+  return position(s_.rfind(str.s_));
+}
+
+int String::lastIndexOf(const String& str, unsigned int from) const {
+  return position(s_.rfind(str.s_, from));
+}
+
+String String::substring(unsigned int begin, unsigned int end) const {
+  if (begin > end) std::swap(begin, end);
+  if (begin >= s_.size()) return String();
+  end = std::min((size_t)end, s_.size());
+  return String(s_.substr(begin, end - begin));
+}
+
+void String::replace(char find, char replace) {
+  std::replace(s_.begin(), s_.end(), find, replace);
+}
+
+void String::replace(const String& find, const String& replace) {
+  if (find.s_.empty()) return;
+  size_t pos = 0;
+  while ((pos = s_.find(find.s_, pos)) != std::string::npos) {
+    s_.replace(pos, find.s_.size(), replace.s_);
+    pos += replace.s_.size();
+  }
+}
+
+void String::remove(unsigned int index) {
+  if (index < s_.size()) {
+    s_.erase(index);
+  }
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index < s_.size()) {
+    s_.erase(index, count);
+  }
+}
+
+void String::toLowerCase() {
+  for (char& c : s_) c = tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+  for (char& c : s_) c = toupper((unsigned char)c);
+}
+
+void String::trim() {
+  size_t first = 0;
+  while (first < s_.size() && isspace((unsigned char)s_[first])) first++;
+  size_t last = s_.size();
+  while (last > first && isspace((unsigned char)s_[last - 1])) last--;
+  s_ = s_.substr(first, last - first);
+}
+
+long String::toInt() const {
+  return atol(s_.c_str());
+}
+
+float String::toFloat() const {
+  return (float)atof(s_.c_str());
+}
+
+double String::toDouble() const {
+  return atof(s_.c_str());
+}
+
+String operator+(const String& lhs, const String& rhs) {
+  String out(lhs);
+  out.concat(rhs);
+  return out;
+}
+
+String operator+(const String& lhs, const char* rhs) {
+  String out(lhs);
+  out.concat(rhs);
+  return out;
+}
+
+String operator+(const char* lhs, const String& rhs) {
+  String out(lhs);
+  out.concat(rhs);
+  return out;
+}
+
+String operator+(const String& lhs, char rhs) {
+  String out(lhs);
+  out.concat(rhs);
+  return out;
+}
+
+String operator+(const String& lhs, unsigned char rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, int rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, unsigned int rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, long rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, unsigned long rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, long long rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, unsigned long long rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, float rhs) { return lhs + String(rhs); }
+String operator+(const String& lhs, double rhs) { return lhs + String(rhs); }
@@ -0,0 +1,8 @@
+#ifndef _NATIVE_WIFI_H_
+#define _NATIVE_WIFI_H_
+
+// The firmware core talks to esp_wifi directly, the Arduino WiFi class is
+// only used by the portal, which is not part of the native build
+#include "esp_wifi.h"
+
+#endif
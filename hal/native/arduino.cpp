@@ -0,0 +1,295 @@
+#include "Arduino.h"
+#include "esp_mac.h"
+#include "hal_native.h"
+#include <random>
+#include <thread>
+
+// ========== Time ==========
+int64_t esp_timer_get_time() {
+  return (int64_t)halClockNowUs();
+}
+
+unsigned long millis() {
+  return (unsigned long)(halClockNowUs() / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)halClockNowUs();
+}
+
+void delay(uint32_t ms) {
+  vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+  if (halClockIsVirtual()) {
+    return;  // Below the tick, it would never be woken
+  }
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+  std::this_thread::yield();
+}
+
+bool getLocalTime(struct tm* info, uint32_t ms) {
+  return false;  // No SNTP, like a device that never got online
+}
+
+// ========== Random ==========
+static std::mt19937& rng() {
+  static std::mt19937 engine(std::random_device{}());
+  return engine;
+}
+
+uint32_t esp_random() {
+  return rng()();
+}
+
+void esp_fill_random(void* buf, size_t len) {
+  uint8_t* p = (uint8_t*)buf;
+  for (size_t i = 0; i < len; i++) {
+    p[i] = (uint8_t)esp_random();
+  }
+}
+
+long random(long max) {
+  return max <= 0 ? 0 : (long)(esp_random() % (unsigned long)max);
+}
+
+long random(long min, long max) {
+  return min >= max ? min : min + random(max - min);
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) {
+    rng().seed(seed);
+  }
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// ========== GPIO ==========
+void pinMode(uint8_t pin, uint8_t mode) {}
+void digitalWrite(uint8_t pin, uint8_t val) {}
+int digitalRead(uint8_t pin) { return LOW; }
+
+// ========== Conversions ==========
+static char* formatUnsigned(unsigned long value, char* str, int base, bool negative) {
+  char buf[66];
+  char* p = buf + sizeof(buf) - 1;
+  *p = '\0';
+  do {
+    unsigned digit = value % base;
+    *--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    value /= base;
+  } while (value > 0);
+  if (negative) *--p = '-';
+  strcpy(str, p);
+  return str;
+}
+
+char* ltoa(long value, char* str, int base) {
+  if (base == 10 && value < 0) {
+    return formatUnsigned(0UL - (unsigned long)value, str, base, true);
+  }
+  return formatUnsigned((unsigned long)value, str, base, false);
+}
+
+char* itoa(int value, char* str, int base) {
+  if (base == 10) return ltoa(value, str, base);
+  return formatUnsigned((unsigned)value, str, base, false);
+}
+
+char* utoa(unsigned value, char* str, int base) {
+  return formatUnsigned(value, str, base, false);
+}
+
+char* ultoa(unsigned long value, char* str, int base) {
+  return formatUnsigned(value, str, base, false);
+}
+
+char* dtostrf(double value, signed char width, unsigned char prec, char* out) {
+  sprintf(out, "%*.*f", width, prec, value);
+  return out;
+}
+
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+extern "C" size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t len = strlen(src);
+  if (size > 0) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+
+extern "C" size_t strlcat(char* dst, const char* src, size_t size) {
+  size_t used = strnlen(dst, size);
+  if (used == size) return size + strlen(src);
+  return used + strlcpy(dst + used, src, size - used);
+}
+#endif
+
+// ========== ESP-IDF odds and ends ==========
+const char* esp_err_to_name(esp_err_t code) {
+  switch (code) {
+    case ESP_OK: return "ESP_OK";
+    case ESP_FAIL: return "ESP_FAIL";
+    case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_WIFI_NOT_INIT: return "ESP_ERR_WIFI_NOT_INIT";
+    case ESP_ERR_WIFI_NOT_STARTED: return "ESP_ERR_WIFI_NOT_STARTED";
+    case ESP_ERR_WIFI_IF: return "ESP_ERR_WIFI_IF";
+    case ESP_ERR_NVS_NOT_FOUND: return "ESP_ERR_NVS_NOT_FOUND";
+    default: return "UNKNOWN ERROR";
+  }
+}
+
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t type) {
+  static const uint8_t base[6] = {0x02, 0x00, 0x00, 0x6e, 0x61, 0x74};
+  memcpy(mac, base, 6);
+  mac[5] += type;
+  return ESP_OK;
+}
+
+void esp_restart() {
+  fflush(stdout);
+  exit(0);
+}
+
+uint32_t esp_get_free_heap_size() {
+  return ESP.getFreeHeap();
+}
+
+uint32_t EspClass::getCycleCount() {
+  return (uint32_t)(halClockNowUs() * getCpuFreqMHz());
+}
+
+void EspClass::restart() {
+  esp_restart();
+}
+
+EspClass ESP;
+
+// ========== Print and Stream ==========
+size_t Print::write(const uint8_t* buf, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    if (!write(*buf++)) break;
+    n++;
+  }
+  return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+  char small[128];
+  va_list ap;
+  va_start(ap, format);
+  int len = vsnprintf(small, sizeof(small), format, ap);
+  va_end(ap);
+  if (len < 0) return 0;
+  if ((size_t)len < sizeof(small)) return write((const uint8_t*)small, len);
+
+  char* big = (char*)malloc(len + 1);
+  if (!big) return 0;
+  va_start(ap, format);
+  vsnprintf(big, len + 1, format, ap);
+  va_end(ap);
+  size_t n = write((const uint8_t*)big, len);
+  free(big);
+  return n;
+}
+
+int Stream::timedRead() {
+  unsigned long start = millis();
+  do {
+    int c = read();
+    if (c >= 0) return c;
+    delay(1);
+  } while (millis() - start < timeout_ms_);
+  return -1;
+}
+
+size_t Stream::readBytes(char* buffer, size_t length) {
+  size_t n = 0;
+  while (n < length) {
+    int c = timedRead();
+    if (c < 0) break;
+    buffer[n++] = (char)c;
+  }
+  return n;
+}
+
+String Stream::readString() {
+  String out;
+  int c;
+  while ((c = timedRead()) >= 0) {
+    out += (char)c;
+  }
+  return out;
+}
+
+String Stream::readStringUntil(char terminator) {
+  String out;
+  int c;
+  while ((c = timedRead()) >= 0 && c != terminator) {
+    out += (char)c;
+  }
+  return out;
+}
+
+// ========== Serial ==========
+static FILE* serial_out = nullptr;  // stdout, which is not a constant
+
+void halSetSerialOutput(FILE* out) {
+  serial_out = out;
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t size) {
+  if (uart_ == 0) {
+    fwrite(buf, 1, size, serial_out != nullptr ? serial_out : stdout);
+  }
+  return size;
+}
+
+void HardwareSerial::flush() {
+  if (uart_ == 0) {
+    fflush(serial_out != nullptr ? serial_out : stdout);
+  }
+}
+
+int HardwareSerial::available() {
+  std::lock_guard<std::mutex> lock(rx_mutex_);
+  return (int)rx_.size();
+}
+
+int HardwareSerial::read() {
+  std::lock_guard<std::mutex> lock(rx_mutex_);
+  if (rx_.empty()) return -1;
+  int c = rx_.front();
+  rx_.pop_front();
+  return c;
+}
+
+int HardwareSerial::peek() {
+  std::lock_guard<std::mutex> lock(rx_mutex_);
+  return rx_.empty() ? -1 : rx_.front();
+}
+
+void HardwareSerial::inject(const uint8_t* data, size_t len) {
+  std::lock_guard<std::mutex> lock(rx_mutex_);
+  rx_.insert(rx_.end(), data, data + len);
+}
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
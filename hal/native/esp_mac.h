@@ -0,0 +1,17 @@
+#ifndef _NATIVE_ESP_MAC_H_
+#define _NATIVE_ESP_MAC_H_
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum {
+  ESP_MAC_WIFI_STA,
+  ESP_MAC_WIFI_SOFTAP,
+  ESP_MAC_BT,
+  ESP_MAC_ETH,
+} esp_mac_type_t;
+
+// A fixed locally administered address, the last byte differs per type
+esp_err_t esp_read_mac(uint8_t* mac, esp_mac_type_t type);
+
+#endif
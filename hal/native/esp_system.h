@@ -0,0 +1,13 @@
+#ifndef _NATIVE_ESP_SYSTEM_H_
+#define _NATIVE_ESP_SYSTEM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+uint32_t esp_random();
+void esp_fill_random(void* buf, size_t len);
+void esp_restart();
+uint32_t esp_get_free_heap_size();
+
+#endif
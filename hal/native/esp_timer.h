@@ -0,0 +1,9 @@
+#ifndef _NATIVE_ESP_TIMER_H_
+#define _NATIVE_ESP_TIMER_H_
+
+#include <stdint.h>
+
+// Microseconds on the HAL clock, see hal_native.h
+int64_t esp_timer_get_time();
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef _NATIVE_EVENT_GROUPS_H_
+#define _NATIVE_EVENT_GROUPS_H_
+
+#include "FreeRTOS.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef _NATIVE_QUEUE_H_
+#define _NATIVE_QUEUE_H_
+
+#include "FreeRTOS.h"
+
+#endif
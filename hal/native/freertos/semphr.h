@@ -0,0 +1,6 @@
+#ifndef _NATIVE_SEMPHR_H_
+#define _NATIVE_SEMPHR_H_
+
+#include "FreeRTOS.h"
+
+#endif
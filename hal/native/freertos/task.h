@@ -0,0 +1,6 @@
+#ifndef _NATIVE_TASK_H_
+#define _NATIVE_TASK_H_
+
+#include "FreeRTOS.h"
+
+#endif
@@ -0,0 +1,241 @@
+#include "FS.h"
+#include "LittleFS.h"
+#include "SD.h"
+#include "hal_native.h"
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::string fs_root;
+
+void halSetFsRoot(const char* dir) {
+  fs_root = dir;
+}
+
+const char* halGetFsRoot() {
+  if (fs_root.empty()) {
+    const char* env = getenv("GOTCHI_FS_ROOT");
+    fs_root = env && *env ? env : "native_fs";
+  }
+  return fs_root.c_str();
+}
+
+static bool makeDirs(const std::string& path) {
+  for (size_t i = 1; i <= path.size(); i++) {
+    if (i == path.size() || path[i] == '/') {
+      std::string part = path.substr(0, i);
+      if (::mkdir(part.c_str(), 0755) != 0 && errno != EEXIST) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool isDir(const std::string& path) {
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+namespace fs {
+
+struct FileImpl {
+  std::string path;       // As the firmware sees it, e.g. "/friends.ndjson"
+  std::string host_path;
+  FILE* file;
+  DIR* dir;
+
+  ~FileImpl() {
+    if (file) fclose(file);
+    if (dir) closedir(dir);
+  }
+};
+
+// ========== File ==========
+size_t File::write(const uint8_t* buf, size_t size) {
+  if (!impl_ || !impl_->file) return 0;
+  return fwrite(buf, 1, size, impl_->file);
+}
+
+int File::available() {
+  if (!impl_ || !impl_->file) return 0;
+  size_t pos = position();
+  size_t len = size();
+  return pos < len ? (int)(len - pos) : 0;
+}
+
+int File::read() {
+  if (!impl_ || !impl_->file) return -1;
+  return fgetc(impl_->file);
+}
+
+int File::peek() {
+  if (!impl_ || !impl_->file) return -1;
+  int c = fgetc(impl_->file);
+  if (c != EOF) ungetc(c, impl_->file);
+  return c;
+}
+
+void File::flush() {
+  if (impl_ && impl_->file) fflush(impl_->file);
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+  if (!impl_ || !impl_->file) return 0;
+  return fread(buf, 1, size, impl_->file);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!impl_ || !impl_->file) return false;
+  int whence = mode == SeekCur ? SEEK_CUR : mode == SeekEnd ? SEEK_END : SEEK_SET;
+  return fseek(impl_->file, pos, whence) == 0;
+}
+
+size_t File::position() const {
+  if (!impl_ || !impl_->file) return 0;
+  long pos = ftell(impl_->file);
+  return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+  if (!impl_) return 0;
+  if (impl_->file) fflush(impl_->file);
+  struct stat st;
+  return stat(impl_->host_path.c_str(), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close() {
+  impl_.reset();
+}
+
+File::operator bool() const {
+  return impl_ && (impl_->file || impl_->dir);
+}
+
+const char* File::path() const {
+  return impl_ ? impl_->path.c_str() : nullptr;
+}
+
+const char* File::name() const {
+  if (!impl_) return nullptr;
+  size_t slash = impl_->path.rfind('/');
+  return impl_->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+bool File::isDirectory() const {
+  return impl_ && impl_->dir;
+}
+
+File File::openNextFile(const char* mode) {
+  if (!impl_ || !impl_->dir) return File();
+  while (struct dirent* entry = readdir(impl_->dir)) {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+    std::string base = impl_->path == "/" ? "" : impl_->path;
+    FileImplPtr child(new FileImpl{base + "/" + entry->d_name,
+                                   impl_->host_path + "/" + entry->d_name, nullptr, nullptr});
+    if (isDir(child->host_path)) {
+      child->dir = opendir(child->host_path.c_str());
+    } else {
+      child->file = fopen(child->host_path.c_str(), "rb");
+    }
+    return File(child);
+  }
+  return File();
+}
+
+void File::rewindDirectory() {
+  if (impl_ && impl_->dir) rewinddir(impl_->dir);
+}
+
+// ========== FS ==========
+std::string FS::hostPath(const char* path) const {
+  std::string p = std::string(halGetFsRoot()) + "/" + subdir_;
+  if (path == nullptr || path[0] != '/') p += "/";
+  return p + (path ? path : "");
+}
+
+bool FS::mount() {
+  return makeDirs(hostPath("/"));
+}
+
+File FS::open(const char* path, const char* mode, const bool create) {
+  std::string host = hostPath(path);
+  if (isDir(host)) {
+    DIR* dir = opendir(host.c_str());
+    return dir ? File(FileImplPtr(new FileImpl{path, host, nullptr, dir})) : File();
+  }
+  if (create && mode[0] != 'r') {
+    size_t slash = host.rfind('/');
+    makeDirs(host.substr(0, slash));
+  }
+  // Binary mode, with "r+" and friends kept as they are
+  std::string m = mode;
+  if (m.find('b') == std::string::npos) m.insert(1, "b");
+  FILE* f = fopen(host.c_str(), m.c_str());
+  return f ? File(FileImplPtr(new FileImpl{path, host, f, nullptr})) : File();
+}
+
+bool FS::exists(const char* path) {
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) {
+  return ::unlink(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char* from, const char* to) {
+  return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+  return ::mkdir(hostPath(path).c_str(), 0755) == 0;
+}
+
+bool FS::rmdir(const char* path) {
+  return ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+static uint64_t treeBytes(const std::string& dir_path) {
+  uint64_t total = 0;
+  DIR* dir = opendir(dir_path.c_str());
+  if (!dir) return 0;
+  while (struct dirent* entry = readdir(dir)) {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+    std::string p = dir_path + "/" + entry->d_name;
+    struct stat st;
+    if (stat(p.c_str(), &st) != 0) continue;
+    total += S_ISDIR(st.st_mode) ? treeBytes(p) : (uint64_t)st.st_size;
+  }
+  closedir(dir);
+  return total;
+}
+
+uint64_t FS::usedBytes() {
+  return treeBytes(hostPath("/"));
+}
+
+// ========== Mounts ==========
+bool LittleFSFS::begin(bool format_on_fail, const char* base_path, uint8_t max_open_files,
+                       const char* partition_label) {
+  return mount();
+}
+
+bool LittleFSFS::format() {
+  std::string cmd = "rm -rf '" + hostPath("/") + "'";
+  return system(cmd.c_str()) == 0 && mount();
+}
+
+bool SDFS::begin(uint8_t ss_pin, SPIClass& spi, uint32_t frequency, const char* mountpoint,
+                 uint8_t max_files, bool format_if_empty) {
+  mounted_ = isDir(hostPath("/"));
+  return mounted_;
+}
+
+}  // namespace fs
+
+fs::LittleFSFS LittleFS;
+fs::SDFS SD;
+SPIClass SPI;
@@ -0,0 +1,48 @@
+#ifndef _HAL_NATIVE_H_
+#define _HAL_NATIVE_H_
+
+// Controls for the host build (pio run -e native). The headers next to this
+// one stand in for the Arduino core, ESP-IDF and FreeRTOS so the firmware
+// core (pwn, db, ai, storage, GPS) compiles and runs on Linux:
+//
+//   - millis(), micros() and esp_timer_get_time() read the HAL clock. It
+//     follows the host's monotonic clock unless switched to virtual time,
+//     where it only moves on halClockAdvance() and every delay or RTOS
+//     timeout waits for it.
+//   - FreeRTOS tasks run as threads, see freertos/FreeRTOS.h.
+//   - LittleFS and SD are directories under the filesystem root.
+//   - Preferences, EEPROM and NVS live in memory for the life of the process.
+//   - The radio is a frame injector: frames handed to halInjectFrame() go to
+//     the callback registered with esp_wifi_set_promiscuous_rx_cb(), and
+//     transmitted frames go to the tx hook.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "esp_wifi_types.h"
+
+// Clock
+void halClockUseVirtual(bool on);  // Virtual time starts where the clock is now
+bool halClockIsVirtual();
+void halClockAdvance(uint64_t us);
+uint64_t halClockNowUs();
+
+// Radio. Returns false when the frame was not delivered (promiscuous mode
+// off, no callback, or filtered out).
+bool halInjectFrame(const uint8_t* frame, size_t len, int8_t rssi, uint8_t channel);
+typedef void (*HalTxHook)(wifi_interface_t ifx, const uint8_t* frame, size_t len);
+void halSetTxHook(HalTxHook hook);
+uint8_t halGetChannel();
+uint32_t halGetTxCount();
+
+// Where Serial writes, stdout by default. Tools that print their own
+// results on stdout move the firmware's output to stderr.
+void halSetSerialOutput(FILE* out);
+
+// Filesystem root, LittleFS is <root>/littlefs and SD is <root>/sd. The SD
+// card is "inserted" when its directory exists. Defaults to $GOTCHI_FS_ROOT
+// or ./native_fs.
+void halSetFsRoot(const char* dir);
+const char* halGetFsRoot();
+
+#endif
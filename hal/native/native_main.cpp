@@ -0,0 +1,120 @@
+// Headless entry point for the native build: boots the firmware core without
+// display, input or portal and runs its periodic jobs on the host clock.
+//
+//   .pio/build/native/program [seconds]
+//   .pio/build/native/program replay <capture> [options]
+//   .pio/build/native/program bench [--filter s] [--min-time ms] [--out file]
+//
+// Frames only arrive through halInjectFrame(), so on its own this mostly
+// exercises boot, storage and the brain; replay (replay.cpp) feeds a capture
+// through the sniffer and bench runs the microbenchmarks (microbench.h). Unit tests build with PIO_UNIT_TESTING and bring
+// their own main().
+#ifndef PIO_UNIT_TESTING
+
+#include "Arduino.h"
+#include "ai.h"
+#include "config.h"
+#include "hal_native.h"
+#include "logger.h"
+#include "microbench.h"
+#include "pwn.h"
+#include "scheduler.h"
+#include "tracer.h"
+
+int replayMain(int argc, char** argv);
+
+// No UI task on the host, moods go nowhere
+bool uiPostMood(const char* face, const char* phrase, bool broken, uint32_t timeout_ms) {
+  return true;
+}
+
+static void goneFriendsJob(void*) {
+  checkPwngridGoneFriends();
+}
+
+static void statsJob(void*) {
+  schedDumpStats();
+}
+
+static bool benchFileSink(void* ctx, const char* data, size_t len) {
+  return fwrite(data, 1, len, (FILE*)ctx) == len;
+}
+
+static int benchMain(int argc, char** argv) {
+  const char* filter = nullptr;
+  const char* out_path = nullptr;
+  uint32_t min_time_ms = 0;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+      min_time_ms = (uint32_t)atol(argv[++i]);
+    } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+      out_path = argv[++i];
+    } else {
+      Serial.println("usage: bench [--filter s] [--min-time ms] [--out file]");
+      return 2;
+    }
+  }
+
+  // Only the JSON goes to stdout, the log and boot messages to stderr
+  FILE* out = out_path != nullptr ? fopen(out_path, "w") : stdout;
+  if (out == nullptr) {
+    Serial.printf("Bench: cannot write %s\n", out_path);
+    return 1;
+  }
+  halSetSerialOutput(stderr);
+  initLog();
+  initConfig();
+  initPwnState();
+  initPwnStorage();
+  initPwnIdentity();
+  bool ok = runMicrobenchmarks(benchFileSink, out, filter, min_time_ms);
+  if (out != stdout) {
+    fclose(out);
+  }
+  fflush(stdout);
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1 && strcmp(argv[1], "replay") == 0) {
+    return replayMain(argc - 1, argv + 1);
+  }
+  if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+    return benchMain(argc - 1, argv + 1);
+  }
+  uint32_t run_ms = argc > 1 ? (uint32_t)atol(argv[1]) * 1000 : 60000;
+
+  Serial.begin(115200);
+  Serial.printf("=== NATIVE BOOT (fs root %s) ===\n", halGetFsRoot());
+  randomSeed(esp_random());
+  initLog();
+  initTrace();
+
+  initConfig();
+  initPwnState();
+  initPwnStorage();
+  initPwnGPS();
+  initPwnIdentity();
+  initPwnRadio();
+  if (getPersonality() == AI) {
+    startBrain();
+  }
+
+  schedEvery("gone-friends", 1000, goneFriendsJob);
+  if (SCHED_STATS_INTERVAL_MS > 0) {
+    schedEvery("sched-stats", SCHED_STATS_INTERVAL_MS, statsJob, nullptr, SCHED_PRIO_LOW);
+  }
+
+  uint32_t start = millis();
+  while (millis() - start < run_ms) {
+    schedIdle(schedRun());
+  }
+
+  Serial.println("=== NATIVE DONE ===");
+  Serial.flush();
+  return 0;
+}
+
+#endif
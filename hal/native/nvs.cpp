@@ -0,0 +1,254 @@
+#include "EEPROM.h"
+#include "Preferences.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+typedef std::vector<uint8_t> NvsValue;
+typedef std::map<std::string, NvsValue> NvsNamespace;
+
+struct NvsHandle {
+  std::string ns;
+  bool read_only;
+};
+
+static std::mutex nvs_mutex;
+static std::map<std::string, NvsNamespace> nvs_data;
+static std::map<nvs_handle_t, NvsHandle> nvs_handles;
+static nvs_handle_t nvs_next_handle = 1;
+
+esp_err_t nvs_flash_init() {
+  return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase() {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_data.clear();
+  return ESP_OK;
+}
+
+esp_err_t nvs_open(const char* name, nvs_open_mode_t mode, nvs_handle_t* out) {
+  if (name == nullptr || strlen(name) > 15) return ESP_ERR_INVALID_ARG;
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  if (mode == NVS_READONLY && nvs_data.find(name) == nvs_data.end()) {
+    return ESP_ERR_NVS_NOT_FOUND;
+  }
+  nvs_data[name];
+  *out = nvs_next_handle++;
+  nvs_handles[*out] = NvsHandle{name, mode == NVS_READONLY};
+  return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  nvs_handles.erase(handle);
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  return nvs_handles.count(handle) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+// Both helpers expect nvs_mutex held
+static NvsNamespace* lookup(nvs_handle_t handle, bool write, esp_err_t* err) {
+  auto it = nvs_handles.find(handle);
+  if (it == nvs_handles.end()) {
+    *err = ESP_ERR_INVALID_ARG;
+    return nullptr;
+  }
+  if (write && it->second.read_only) {
+    *err = ESP_ERR_NOT_SUPPORTED;
+    return nullptr;
+  }
+  *err = ESP_OK;
+  return &nvs_data[it->second.ns];
+}
+
+static esp_err_t setValue(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+  if (key == nullptr || strlen(key) > 15) return ESP_ERR_INVALID_ARG;
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  esp_err_t err;
+  NvsNamespace* ns = lookup(handle, true, &err);
+  if (ns == nullptr) return err;
+  (*ns)[key] = NvsValue((const uint8_t*)value, (const uint8_t*)value + length);
+  return ESP_OK;
+}
+
+// With out == nullptr only reports the length, like nvs_get_blob
+static esp_err_t getValue(nvs_handle_t handle, const char* key, void* out, size_t* length) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  esp_err_t err;
+  NvsNamespace* ns = lookup(handle, false, &err);
+  if (ns == nullptr) return err;
+  auto it = ns->find(key ? key : "");
+  if (it == ns->end()) return ESP_ERR_NVS_NOT_FOUND;
+  if (out == nullptr) {
+    *length = it->second.size();
+    return ESP_OK;
+  }
+  if (*length < it->second.size()) return ESP_ERR_NVS_INVALID_LENGTH;
+  memcpy(out, it->second.data(), it->second.size());
+  *length = it->second.size();
+  return ESP_OK;
+}
+
+template <typename T>
+static esp_err_t getScalar(nvs_handle_t handle, const char* key, T* out) {
+  size_t length = sizeof(T);
+  size_t stored;
+  esp_err_t err = getValue(handle, key, nullptr, &stored);
+  if (err != ESP_OK) return err;
+  if (stored != sizeof(T)) return ESP_ERR_NVS_INVALID_LENGTH;
+  return getValue(handle, key, out, &length);
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  esp_err_t err;
+  NvsNamespace* ns = lookup(handle, true, &err);
+  if (ns == nullptr) return err;
+  return ns->erase(key) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t handle) {
+  std::lock_guard<std::mutex> lock(nvs_mutex);
+  esp_err_t err;
+  NvsNamespace* ns = lookup(handle, true, &err);
+  if (ns == nullptr) return err;
+  ns->clear();
+  return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+  return setValue(handle, key, value, length);
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out, size_t* length) {
+  return getValue(handle, key, out, length);
+}
+
+esp_err_t nvs_set_str(nvs_handle_t handle, const char* key, const char* value) {
+  return setValue(handle, key, value, strlen(value) + 1);
+}
+
+esp_err_t nvs_get_str(nvs_handle_t handle, const char* key, char* out, size_t* length) {
+  return getValue(handle, key, out, length);
+}
+
+esp_err_t nvs_set_u8(nvs_handle_t handle, const char* key, uint8_t value) {
+  return setValue(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_u8(nvs_handle_t handle, const char* key, uint8_t* out) {
+  return getScalar(handle, key, out);
+}
+
+esp_err_t nvs_set_i32(nvs_handle_t handle, const char* key, int32_t value) {
+  return setValue(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_i32(nvs_handle_t handle, const char* key, int32_t* out) {
+  return getScalar(handle, key, out);
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t handle, const char* key, uint32_t value) {
+  return setValue(handle, key, &value, sizeof(value));
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t handle, const char* key, uint32_t* out) {
+  return getScalar(handle, key, out);
+}
+
+// ========== Preferences ==========
+bool Preferences::begin(const char* name, bool read_only, const char* partition_label) {
+  if (started_) return false;
+  if (nvs_open(name, read_only ? NVS_READONLY : NVS_READWRITE, &handle_) != ESP_OK) {
+    return false;
+  }
+  started_ = true;
+  read_only_ = read_only;
+  return true;
+}
+
+void Preferences::end() {
+  if (!started_) return;
+  nvs_close(handle_);
+  started_ = false;
+}
+
+bool Preferences::clear() {
+  return started_ && !read_only_ && nvs_erase_all(handle_) == ESP_OK;
+}
+
+bool Preferences::remove(const char* key) {
+  return started_ && !read_only_ && nvs_erase_key(handle_, key) == ESP_OK;
+}
+
+bool Preferences::isKey(const char* key) {
+  size_t length;
+  return started_ && nvs_get_blob(handle_, key, nullptr, &length) == ESP_OK;
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+  if (!started_ || read_only_ || value == nullptr) return 0;
+  return nvs_set_str(handle_, key, value) == ESP_OK ? strlen(value) : 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+  if (!started_ || read_only_ || value == nullptr || len == 0) return 0;
+  return nvs_set_blob(handle_, key, value, len) == ESP_OK ? len : 0;
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t max_len) {
+  size_t len = 0;
+  if (!started_ || nvs_get_str(handle_, key, nullptr, &len) != ESP_OK || len > max_len) {
+    return 0;
+  }
+  return nvs_get_str(handle_, key, value, &len) == ESP_OK ? len : 0;
+}
+
+String Preferences::getString(const char* key, const String& default_value) {
+  size_t len = 0;
+  if (!started_ || nvs_get_str(handle_, key, nullptr, &len) != ESP_OK || len == 0) {
+    return default_value;
+  }
+  std::vector<char> buf(len);
+  if (nvs_get_str(handle_, key, buf.data(), &len) != ESP_OK) {
+    return default_value;
+  }
+  return String(buf.data());
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  size_t len = 0;
+  if (!started_ || nvs_get_blob(handle_, key, nullptr, &len) != ESP_OK) return 0;
+  return len;
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t max_len) {
+  size_t len = getBytesLength(key);
+  if (len == 0 || buf == nullptr || len > max_len) return 0;
+  return nvs_get_blob(handle_, key, buf, &len) == ESP_OK ? len : 0;
+}
+
+// ========== EEPROM ==========
+bool EEPROMClass::begin(size_t size) {
+  if (size == 0) return false;
+  data_.resize(size, 0xff);
+  return true;
+}
+
+uint8_t EEPROMClass::read(int address) {
+  if (address < 0 || (size_t)address >= data_.size()) return 0;
+  return data_[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  if (address < 0 || (size_t)address >= data_.size()) return;
+  data_[address] = value;
+}
+
+EEPROMClass EEPROM;
@@ -0,0 +1,9 @@
+#ifndef _NATIVE_NVS_FLASH_H_
+#define _NATIVE_NVS_FLASH_H_
+
+#include "nvs.h"
+
+esp_err_t nvs_flash_init();
+esp_err_t nvs_flash_erase();
+
+#endif
@@ -0,0 +1,270 @@
+#include "pcap.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DLT_IEEE802_11 105
+#define DLT_IEEE802_11_RADIO 127
+
+#define RADIOTAP_FLAGS_FCS 0x10
+
+class ByteReader {
+public:
+  ByteReader(const std::vector<uint8_t>& data) : data_(data) {}
+
+  bool has(size_t pos, size_t n) const { return pos <= data_.size() && n <= data_.size() - pos; }
+  const uint8_t* at(size_t pos) const { return &data_[pos]; }
+  size_t size() const { return data_.size(); }
+
+  uint16_t u16(size_t pos) const {
+    uint16_t v;
+    memcpy(&v, &data_[pos], 2);
+    return swap_ ? __builtin_bswap16(v) : v;
+  }
+  uint32_t u32(size_t pos) const {
+    uint32_t v;
+    memcpy(&v, &data_[pos], 4);
+    return swap_ ? __builtin_bswap32(v) : v;
+  }
+  void setSwap(bool swap) { swap_ = swap; }
+
+private:
+  const std::vector<uint8_t>& data_;
+  bool swap_ = false;
+};
+
+static uint16_t le16(const uint8_t* p) {
+  return p[0] | (p[1] << 8);
+}
+
+static uint32_t le32(const uint8_t* p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint8_t freqToChannel(uint16_t mhz) {
+  if (mhz == 2484) return 14;
+  if (mhz >= 2412 && mhz <= 2472) return (mhz - 2407) / 5;
+  if (mhz >= 5000 && mhz <= 5900) return (mhz - 5000) / 5;
+  return 0;
+}
+
+// Alignment and size of the radiotap fields in the first presence word,
+// up to the first one not listed here
+static const uint8_t radiotap_fields[][2] = {
+  {8, 8},   // TSFT
+  {1, 1},   // Flags
+  {1, 1},   // Rate
+  {2, 4},   // Channel
+  {1, 2},   // FHSS
+  {1, 1},   // dBm antenna signal
+  {1, 1},   // dBm antenna noise
+  {2, 2},   // Lock quality
+  {2, 2},   // TX attenuation
+  {2, 2},   // dB TX attenuation
+  {1, 1},   // dBm TX power
+  {1, 1},   // Antenna
+  {1, 1},   // dB antenna signal
+  {1, 1},   // dB antenna noise
+  {2, 2},   // RX flags
+  {2, 2},   // TX flags
+  {1, 1},   // RTS retries
+  {1, 1},   // Data retries
+  {4, 8},   // XChannel
+  {1, 3},   // MCS
+  {4, 8},   // A-MPDU status
+  {2, 12},  // VHT
+  {8, 12},  // Timestamp
+};
+
+// Fills rssi and channel from the header and strips it (and the FCS, when
+// flagged) from the frame. False when the header is malformed.
+static bool parseRadiotap(const uint8_t* p, size_t len, PcapRecord& rec) {
+  if (len < 8 || p[0] != 0) return false;
+  uint16_t hdr_len = le16(p + 2);
+  if (hdr_len < 8 || hdr_len > len) return false;
+
+  // Skip the extended presence words, the fields start after the last one
+  size_t pos = 4;
+  uint32_t present = le32(p + 4);
+  uint32_t word = present;
+  while (word & 0x80000000) {
+    pos += 4;
+    if (pos + 4 > hdr_len) return false;
+    word = le32(p + pos);
+  }
+  pos += 4;
+
+  uint8_t flags = 0;
+  for (uint8_t bit = 0; bit < sizeof(radiotap_fields) / sizeof(radiotap_fields[0]); bit++) {
+    if (!(present & (1u << bit))) continue;
+    uint8_t align = radiotap_fields[bit][0];
+    uint8_t size = radiotap_fields[bit][1];
+    pos = (pos + align - 1) & ~(size_t)(align - 1);
+    if (pos + size > hdr_len) break;
+    switch (bit) {
+      case 1: flags = p[pos]; break;
+      case 3: rec.channel = freqToChannel(le16(p + pos)); break;
+      case 5: rec.rssi = (int8_t)p[pos]; break;
+    }
+    pos += size;
+  }
+
+  size_t frame_len = len - hdr_len;
+  if ((flags & RADIOTAP_FLAGS_FCS) && frame_len >= 4) {
+    frame_len -= 4;
+  }
+  rec.frame.assign(p + hdr_len, p + hdr_len + frame_len);
+  return true;
+}
+
+static bool addRecord(std::vector<PcapRecord>& out, uint32_t linktype, uint64_t ts_us,
+                      const uint8_t* p, size_t len) {
+  PcapRecord rec;
+  rec.ts_us = ts_us;
+  rec.rssi = 0;
+  rec.channel = 0;
+  if (linktype == DLT_IEEE802_11_RADIO) {
+    if (!parseRadiotap(p, len, rec)) return false;
+  } else if (linktype == DLT_IEEE802_11) {
+    rec.frame.assign(p, p + len);
+  } else {
+    return false;
+  }
+  if (rec.frame.size() < 24) return false;
+  out.push_back(std::move(rec));
+  return true;
+}
+
+static bool loadClassic(ByteReader& r, std::vector<PcapRecord>& out, uint32_t* skipped) {
+  uint32_t magic = r.u32(0);
+  bool nanos = false;
+  if (magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1) {
+    r.setSwap(true);
+    magic = r.u32(0);
+  }
+  if (magic == 0xa1b23c4d) {
+    nanos = true;
+  } else if (magic != 0xa1b2c3d4) {
+    return false;
+  }
+  if (!r.has(0, 24)) return false;
+  uint32_t linktype = r.u32(20) & 0x0fffffff;
+
+  size_t pos = 24;
+  while (r.has(pos, 16)) {
+    uint64_t sec = r.u32(pos);
+    uint64_t frac = r.u32(pos + 4);
+    uint32_t caplen = r.u32(pos + 8);
+    pos += 16;
+    if (!r.has(pos, caplen)) break;  // Truncated capture, keep what we have
+    uint64_t ts_us = sec * 1000000 + (nanos ? frac / 1000 : frac);
+    if (!addRecord(out, linktype, ts_us, r.at(pos), caplen)) {
+      (*skipped)++;
+    }
+    pos += caplen;
+  }
+  return true;
+}
+
+struct PcapngInterface {
+  uint32_t linktype;
+  uint64_t units_per_sec;
+};
+
+static uint64_t tsresolUnits(uint8_t tsresol) {
+  uint64_t units = 1;
+  uint8_t exp = tsresol & 0x7f;
+  for (uint8_t i = 0; i < exp && units < (1ULL << 60); i++) {
+    units *= (tsresol & 0x80) ? 2 : 10;
+  }
+  return units;
+}
+
+static bool loadPcapng(ByteReader& r, std::vector<PcapRecord>& out, uint32_t* skipped) {
+  std::vector<PcapngInterface> interfaces;
+  size_t pos = 0;
+  while (r.has(pos, 12)) {
+    uint32_t type = r.u32(pos);
+    if (type == 0x0a0d0d0a) {
+      // Section header, sets the byte order for the section
+      r.setSwap(false);
+      if (r.u32(pos + 8) == 0x4d3c2b1a) {
+        r.setSwap(true);
+      } else if (r.u32(pos + 8) != 0x1a2b3c4d) {
+        return false;
+      }
+      interfaces.clear();
+    }
+    uint32_t block_len = r.u32(pos + 4);
+    if (block_len < 12 || (block_len & 3) || !r.has(pos, block_len)) break;
+    size_t body = pos + 8;
+    size_t body_len = block_len - 12;
+
+    if (type == 1 && body_len >= 8) {
+      // Interface description, options may carry if_tsresol (code 9)
+      PcapngInterface ifc = {r.u16(body), 1000000};
+      size_t opt = body + 8;
+      while (opt + 4 <= body + body_len) {
+        uint16_t code = r.u16(opt);
+        uint16_t len = r.u16(opt + 2);
+        if (code == 0 || opt + 4 + len > body + body_len) break;
+        if (code == 9 && len >= 1) {
+          ifc.units_per_sec = tsresolUnits(*r.at(opt + 4));
+        }
+        opt += 4 + ((len + 3) & ~3);
+      }
+      interfaces.push_back(ifc);
+    } else if (type == 6 && body_len >= 20) {
+      // Enhanced packet
+      uint32_t ifid = r.u32(body);
+      uint64_t ts = ((uint64_t)r.u32(body + 4) << 32) | r.u32(body + 8);
+      uint32_t caplen = r.u32(body + 12);
+      if (ifid >= interfaces.size() || caplen > body_len - 20) {
+        (*skipped)++;
+      } else {
+        const PcapngInterface& ifc = interfaces[ifid];
+        uint64_t ts_us = ts / ifc.units_per_sec * 1000000 +
+                         ts % ifc.units_per_sec * 1000000 / ifc.units_per_sec;
+        if (!addRecord(out, ifc.linktype, ts_us, r.at(body + 20), caplen)) {
+          (*skipped)++;
+        }
+      }
+    } else if (type == 3 && body_len >= 4) {
+      // Simple packet, interface 0 and no timestamp
+      uint32_t len = r.u32(body);
+      if (interfaces.empty() || len > body_len - 4 ||
+          !addRecord(out, interfaces[0].linktype, 0, r.at(body + 4), len)) {
+        (*skipped)++;
+      }
+    }
+    pos += block_len;
+  }
+  return true;
+}
+
+bool loadPcap(const char* path, std::vector<PcapRecord>& out, uint32_t* skipped) {
+  *skipped = 0;
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  std::vector<uint8_t> data;
+  uint8_t chunk[65536];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+    data.insert(data.end(), chunk, chunk + n);
+  }
+  fclose(f);
+  if (data.size() < 8) return false;
+
+  ByteReader r(data);
+  uint32_t magic = le32(data.data());
+  if (magic == 0x0a0d0d0a) {
+    return loadPcapng(r, out, skipped);
+  }
+  if (loadClassic(r, out, skipped)) {
+    return true;
+  }
+  // A bare radiotap frame
+  if (data[0] == 0 && le16(&data[2]) < data.size()) {
+    return addRecord(out, DLT_IEEE802_11_RADIO, 0, data.data(), data.size());
+  }
+  return false;
+}
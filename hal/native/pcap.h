@@ -0,0 +1,21 @@
+#ifndef _NATIVE_PCAP_H_
+#define _NATIVE_PCAP_H_
+
+#include <stdint.h>
+#include <vector>
+
+// One captured 802.11 frame, without radiotap header or FCS
+struct PcapRecord {
+  uint64_t ts_us;
+  int8_t rssi;      // 0 when the capture has no signal field
+  uint8_t channel;  // 0 when unknown
+  std::vector<uint8_t> frame;
+};
+
+// Reads pcap (us or ns) and pcapng captures with radiotap (DLT 127) or bare
+// 802.11 (DLT 105) link types, as written by tcpdump, Wireshark or airodump.
+// A file holding a single raw radiotap frame, like pwngrid_beacon.hexdump,
+// loads as one record. Records of other link types are counted in skipped.
+bool loadPcap(const char* path, std::vector<PcapRecord>& out, uint32_t* skipped);
+
+#endif
@@ -0,0 +1,216 @@
+// Sniffer throughput benchmark: replays a capture through the real
+// pwnSnifferCallback via halInjectFrame() and reports how fast the capture
+// path runs, what it allocates and what ends up in the peer table and the
+// DB queues.
+//
+//   program replay <capture> [--speed X] [--loops N] [--ai|--friendly] [--no-db]
+//
+// --speed 0 (the default) injects back to back; otherwise frames keep the
+// capture's spacing divided by X. --no-db leaves the DB queues undrained, to
+// see where enqueue_packet_from_sniffer() starts dropping. Captures are
+// pcap/pcapng with radiotap; tools/replay_corpus has a ready-made set.
+
+#include "Arduino.h"
+#include "config.h"
+#include "hal_native.h"
+#include "logger.h"
+#include "metrics.h"
+#include "pcap.h"
+#include "pwn.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+
+// ========== Allocation counting ==========
+// The native env links with --wrap for malloc, calloc and realloc, and
+// operator new below goes through malloc, so every heap allocation made by
+// the firmware core and its libraries passes through here. Only the
+// injecting thread's are attributed to frames.
+extern "C" void* __real_malloc(size_t size);
+extern "C" void* __real_calloc(size_t n, size_t size);
+extern "C" void* __real_realloc(void* ptr, size_t size);
+
+static thread_local uint64_t thread_allocs = 0;
+static thread_local uint64_t thread_alloc_bytes = 0;
+
+extern "C" void* __wrap_malloc(size_t size) {
+  thread_allocs++;
+  thread_alloc_bytes += size;
+  return __real_malloc(size);
+}
+
+extern "C" void* __wrap_calloc(size_t n, size_t size) {
+  thread_allocs++;
+  thread_alloc_bytes += n * size;
+  return __real_calloc(n, size);
+}
+
+extern "C" void* __wrap_realloc(void* ptr, size_t size) {
+  thread_allocs++;
+  thread_alloc_bytes += size;
+  return __real_realloc(ptr, size);
+}
+
+void* operator new(size_t size) {
+  void* p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// ========== Replay ==========
+struct ReplayOptions {
+  const char* path;
+  double speed;
+  uint32_t loops;
+  int personality;  // -1 keeps the configured one
+  bool db;
+};
+
+static bool parseOptions(int argc, char** argv, ReplayOptions& opt) {
+  opt = {nullptr, 0, 1, -1, true};
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+      opt.speed = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--loops") == 0 && i + 1 < argc) {
+      opt.loops = max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--ai") == 0) {
+      opt.personality = AI;
+    } else if (strcmp(argv[i], "--friendly") == 0) {
+      opt.personality = FRIENDLY;
+    } else if (strcmp(argv[i], "--no-db") == 0) {
+      opt.db = false;
+    } else if (argv[i][0] != '-' && opt.path == nullptr) {
+      opt.path = argv[i];
+    } else {
+      return false;
+    }
+  }
+  return opt.path != nullptr;
+}
+
+static double percentileUs(std::vector<uint32_t>& sorted_ns, double q) {
+  if (sorted_ns.empty()) return 0;
+  size_t k = (size_t)(q * (sorted_ns.size() - 1) + 0.5);
+  return sorted_ns[k] / 1000.0;
+}
+
+int replayMain(int argc, char** argv) {
+  ReplayOptions opt;
+  if (!parseOptions(argc, argv, opt)) {
+    Serial.println("usage: replay <capture> [--speed X] [--loops N] [--ai|--friendly] [--no-db]");
+    return 2;
+  }
+
+  std::vector<PcapRecord> records;
+  uint32_t skipped = 0;
+  if (!loadPcap(opt.path, records, &skipped) || records.empty()) {
+    Serial.printf("Replay: cannot read frames from %s\n", opt.path);
+    return 1;
+  }
+  uint64_t span_us = records.back().ts_us - records.front().ts_us;
+  Serial.printf("Replay: %u frames from %s (%u skipped), %.1f s of capture\n",
+                (unsigned)records.size(), opt.path, skipped, span_us / 1e6);
+
+  initLog();
+  initConfig();
+  if (opt.personality >= 0) {
+    setPersonality(opt.personality);
+  }
+  initPwnState();
+  if (opt.db) {
+    initPwnStorage();
+  }
+  initPwnRadio();
+  Serial.printf("Replay: %s mode, DB %s, %u loops at %s\n",
+                getPersonalityText().c_str(), opt.db ? "on" : "off", opt.loops,
+                opt.speed > 0 ? String(String(opt.speed, 2) + "x capture timing").c_str()
+                              : "full speed");
+  Serial.flush();
+
+  size_t total = records.size() * opt.loops;
+  std::vector<uint32_t> latency_ns;
+  latency_ns.reserve(total);
+  uint64_t start_frames = getMetricCounter(METRIC_SNIFFER_FRAMES);
+  uint64_t start_beacons = getMetricCounter(METRIC_PWNGRID_BEACONS);
+  uint64_t start_drops = getMetricCounter(METRIC_QUEUE_DROPS);
+  int32_t peak_packets = 0;
+  int32_t peak_friends = 0;
+  uint64_t frame_allocs = 0;
+  uint64_t frame_alloc_bytes = 0;
+  uint64_t max_frame_allocs = 0;
+  uint32_t delivered = 0;
+
+  // Loops follow each other with one mean frame gap in between
+  uint64_t loop_us = span_us + span_us / records.size();
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t loop = 0; loop < opt.loops; loop++) {
+    for (const PcapRecord& rec : records) {
+      if (opt.speed > 0) {
+        uint64_t offset_us = loop * loop_us + (rec.ts_us - records.front().ts_us);
+        std::this_thread::sleep_until(
+            start + std::chrono::microseconds((uint64_t)(offset_us / opt.speed)));
+      }
+      uint64_t allocs = thread_allocs;
+      uint64_t bytes = thread_alloc_bytes;
+      auto t0 = std::chrono::steady_clock::now();
+      bool ok = halInjectFrame(rec.frame.data(), rec.frame.size(), rec.rssi, rec.channel);
+      auto t1 = std::chrono::steady_clock::now();
+      latency_ns.push_back(
+          (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+      allocs = thread_allocs - allocs;
+      frame_allocs += allocs;
+      frame_alloc_bytes += thread_alloc_bytes - bytes;
+      max_frame_allocs = max(max_frame_allocs, allocs);
+      delivered += ok;
+      peak_packets = max(peak_packets, getMetricGauge(METRIC_PACKET_QUEUE_DEPTH));
+      peak_friends = max(peak_friends, getMetricGauge(METRIC_FRIEND_QUEUE_DEPTH));
+    }
+  }
+  double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // Give the DB workers a moment to catch up before reading the outcome
+  if (opt.db) {
+    uint32_t wait_start = millis();
+    while ((getMetricGauge(METRIC_PACKET_QUEUE_DEPTH) > 0 ||
+            getMetricGauge(METRIC_FRIEND_QUEUE_DEPTH) > 0) &&
+           millis() - wait_start < 5000) {
+      delay(10);
+    }
+  }
+
+  std::sort(latency_ns.begin(), latency_ns.end());
+  uint64_t sum_ns = 0;
+  for (uint32_t ns : latency_ns) sum_ns += ns;
+
+  Serial.printf("Replay: %u frames in %.3f s, %.0f frames/s, %u delivered to the callback\n",
+                (unsigned)total, elapsed_s, total / elapsed_s, delivered);
+  Serial.printf("Replay: latency mean %.2f us, p50 %.2f us, p99 %.2f us, max %.2f us\n",
+                sum_ns / 1000.0 / total, percentileUs(latency_ns, 0.50),
+                percentileUs(latency_ns, 0.99), latency_ns.back() / 1000.0);
+  Serial.printf("Replay: %.2f allocations/frame (max %u), %.0f bytes/frame\n",
+                (double)frame_allocs / total, (unsigned)max_frame_allocs,
+                (double)frame_alloc_bytes / total);
+  Serial.printf("Replay: sniffer counted %u frames, %u pwngrid beacons, %u queue drops\n",
+                (unsigned)(getMetricCounter(METRIC_SNIFFER_FRAMES) - start_frames),
+                (unsigned)(getMetricCounter(METRIC_PWNGRID_BEACONS) - start_beacons),
+                (unsigned)(getMetricCounter(METRIC_QUEUE_DROPS) - start_drops));
+  Serial.printf("Replay: queue peak %d packets, %d friends; now %d and %d\n",
+                peak_packets, peak_friends, getMetricGauge(METRIC_PACKET_QUEUE_DEPTH),
+                getMetricGauge(METRIC_FRIEND_QUEUE_DEPTH));
+  Serial.printf("Replay: %u peers this run, %u peer table updates, last \"%s\"\n",
+                (unsigned)getPwngridRunTotalPeers(), getPwngridPeersRevision(),
+                getPwngridLastFriendName().c_str());
+  Serial.flush();
+  return 0;
+}
@@ -0,0 +1,391 @@
+#include "freertos/FreeRTOS.h"
+#include "hal_native.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <string.h>
+
+// One lock and one condition variable for every RTOS object: waiters
+// re-check their own condition on each wakeup. Simple, and lets the
+// virtual clock wake every timed wait when it moves. Never destroyed, so
+// detached task threads still waiting at exit() do not touch freed state.
+static std::mutex& rtos_mutex = *new std::mutex;
+static std::condition_variable& rtos_cv = *new std::condition_variable;
+
+struct NativeTask {
+  std::string name;
+  BaseType_t core;
+  TaskFunction_t fn;
+  void* arg;
+  bool deleted;
+  uint32_t notify;
+};
+
+struct NativeQueue {
+  size_t item_size;
+  size_t length;
+  size_t count;
+  std::deque<std::vector<uint8_t>> items;  // Empty for semaphores
+  NativeTask* owner;                       // Recursive mutexes
+  uint32_t depth;
+};
+
+struct NativeEventGroup {
+  EventBits_t bits;
+};
+
+// Thrown into a task's thread to unwind it on vTaskDelete
+struct NativeTaskExit {};
+
+// ========== Clock ==========
+static const auto clock_start = std::chrono::steady_clock::now();
+static std::atomic<bool> clock_virtual(false);
+static std::atomic<uint64_t> clock_virtual_us(0);
+
+static uint64_t realNowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - clock_start).count();
+}
+
+uint64_t halClockNowUs() {
+  return clock_virtual ? clock_virtual_us.load() : realNowUs();
+}
+
+void halClockUseVirtual(bool on) {
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  if (on && !clock_virtual) {
+    clock_virtual_us = realNowUs();
+  }
+  clock_virtual = on;
+  rtos_cv.notify_all();
+}
+
+bool halClockIsVirtual() {
+  return clock_virtual;
+}
+
+void halClockAdvance(uint64_t us) {
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  clock_virtual_us += us;
+  rtos_cv.notify_all();
+}
+
+// ========== Tasks ==========
+static thread_local NativeTask* current_task = nullptr;
+
+static NativeTask* self() {
+  if (current_task == nullptr) {
+    // A thread the HAL did not start, e.g. main()
+    current_task = new NativeTask{"main", 0, nullptr, nullptr, false, 0};
+  }
+  return current_task;
+}
+
+// Blocks until ready() or the timeout, with rtos_mutex held by `lock`
+template <typename Ready>
+static bool waitFor(std::unique_lock<std::mutex>& lock, TickType_t ticks, Ready ready) {
+  NativeTask* me = self();
+  if (ticks != portMAX_DELAY) {
+    uint64_t deadline = halClockNowUs() + (uint64_t)ticks * 1000;
+    auto real_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ticks);
+    while (!ready() && !me->deleted && halClockNowUs() < deadline) {
+      if (clock_virtual) {
+        rtos_cv.wait(lock);
+      } else {
+        rtos_cv.wait_until(lock, real_deadline);
+      }
+    }
+  } else {
+    rtos_cv.wait(lock, [&] { return ready() || me->deleted; });
+  }
+  if (me->deleted) {
+    lock.unlock();
+    throw NativeTaskExit();
+  }
+  return ready();
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+  NativeTask* task = new NativeTask{name ? name : "", core, fn, arg, false, 0};
+  if (handle) {
+    *handle = task;
+  }
+  std::thread([task] {
+    current_task = task;
+    try {
+      task->fn(task->arg);
+    } catch (const NativeTaskExit&) {
+    }
+  }).detach();
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(fn, name, stack, arg, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (task == nullptr || task == self()) {
+    throw NativeTaskExit();
+  }
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  task->deleted = true;
+  rtos_cv.notify_all();
+}
+
+void vTaskDelay(TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(rtos_mutex);
+  waitFor(lock, ticks, [] { return false; });
+}
+
+void vTaskDelayUntil(TickType_t* previous_wake, TickType_t increment) {
+  *previous_wake += increment;
+  TickType_t now = xTaskGetTickCount();
+  if ((int32_t)(*previous_wake - now) > 0) {
+    vTaskDelay(*previous_wake - now);
+  }
+}
+
+void taskYIELD() {
+  std::this_thread::yield();
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)(halClockNowUs() / 1000);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return self();
+}
+
+char* pcTaskGetName(TaskHandle_t task) {
+  return &(task ? task : self())->name[0];
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  return 0;  // Threads have host sized stacks
+}
+
+BaseType_t xPortGetCoreID() {
+  BaseType_t core = self()->core;
+  return core == tskNO_AFFINITY ? 0 : core;
+}
+
+void xTaskNotifyGive(TaskHandle_t task) {
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  task->notify++;
+  rtos_cv.notify_all();
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) {
+  xTaskNotifyGive(task);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+  NativeTask* me = self();
+  std::unique_lock<std::mutex> lock(rtos_mutex);
+  if (!waitFor(lock, ticks, [me] { return me->notify > 0; })) {
+    return 0;
+  }
+  uint32_t value = me->notify;
+  me->notify = clear ? 0 : value - 1;
+  return value;
+}
+
+// ========== Critical sections ==========
+static std::recursive_mutex& critical_mutex = *new std::recursive_mutex;
+
+void portENTER_CRITICAL(portMUX_TYPE* mux) {
+  critical_mutex.lock();
+}
+
+void portEXIT_CRITICAL(portMUX_TYPE* mux) {
+  critical_mutex.unlock();
+}
+
+// ========== Queues and semaphores ==========
+static NativeQueue* newQueue(size_t length, size_t item_size, size_t count) {
+  return new NativeQueue{item_size, length, count, {}, nullptr, 0};
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+  return newQueue(length, item_size, 0);
+}
+
+void vQueueDelete(QueueHandle_t q) {
+  delete q;
+}
+
+static BaseType_t queuePut(QueueHandle_t q, const void* item, TickType_t ticks, bool front) {
+  std::unique_lock<std::mutex> lock(rtos_mutex);
+  if (!waitFor(lock, ticks, [q] { return q->count < q->length; })) {
+    return errQUEUE_FULL;
+  }
+  if (q->item_size > 0) {
+    std::vector<uint8_t> copy((const uint8_t*)item, (const uint8_t*)item + q->item_size);
+    if (front) {
+      q->items.push_front(std::move(copy));
+    } else {
+      q->items.push_back(std::move(copy));
+    }
+  }
+  q->count++;
+  rtos_cv.notify_all();
+  return pdPASS;
+}
+
+static BaseType_t queueGet(QueueHandle_t q, void* item, TickType_t ticks, bool remove) {
+  std::unique_lock<std::mutex> lock(rtos_mutex);
+  if (!waitFor(lock, ticks, [q] { return q->count > 0; })) {
+    return pdFALSE;
+  }
+  if (q->item_size > 0) {
+    memcpy(item, q->items.front().data(), q->item_size);
+    if (remove) {
+      q->items.pop_front();
+    }
+  }
+  if (remove) {
+    q->count--;
+    rtos_cv.notify_all();
+  }
+  return pdTRUE;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t ticks) {
+  return queuePut(q, item, ticks, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t q, const void* item, TickType_t ticks) {
+  return queuePut(q, item, ticks, true);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t ticks) {
+  return queueGet(q, item, ticks, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t q, void* item, TickType_t ticks) {
+  return queueGet(q, item, ticks, false);
+}
+
+BaseType_t xQueueReset(QueueHandle_t q) {
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  q->items.clear();
+  q->count = 0;
+  rtos_cv.notify_all();
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  return q->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q) {
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  return q->length - q->count;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return newQueue(1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+  return newQueue(1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return newQueue(1, 0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial) {
+  return newQueue(max, 0, initial);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+  return queueGet(s, nullptr, ticks, true);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  return queuePut(s, nullptr, 0, false);
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t ticks) {
+  NativeTask* me = self();
+  {
+    std::lock_guard<std::mutex> lock(rtos_mutex);
+    if (s->owner == me) {
+      s->depth++;
+      return pdTRUE;
+    }
+  }
+  if (xSemaphoreTake(s, ticks) != pdTRUE) {
+    return pdFALSE;
+  }
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  s->owner = me;
+  s->depth = 1;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s) {
+  {
+    std::lock_guard<std::mutex> lock(rtos_mutex);
+    if (s->owner != self()) {
+      return pdFALSE;
+    }
+    if (--s->depth > 0) {
+      return pdTRUE;
+    }
+    s->owner = nullptr;
+  }
+  return xSemaphoreGive(s);
+}
+
+// ========== Event groups ==========
+EventGroupHandle_t xEventGroupCreate() {
+  return new NativeEventGroup{0};
+}
+
+void vEventGroupDelete(EventGroupHandle_t g) {
+  delete g;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t g, EventBits_t bits) {
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  g->bits |= bits;
+  rtos_cv.notify_all();
+  return g->bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t g, EventBits_t bits) {
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  EventBits_t before = g->bits;
+  g->bits &= ~bits;
+  return before;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t g) {
+  std::lock_guard<std::mutex> lock(rtos_mutex);
+  return g->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t g, EventBits_t bits, BaseType_t clear,
+                                BaseType_t wait_all, TickType_t ticks) {
+  std::unique_lock<std::mutex> lock(rtos_mutex);
+  bool met = waitFor(lock, ticks, [&] {
+    return wait_all ? (g->bits & bits) == bits : (g->bits & bits) != 0;
+  });
+  EventBits_t value = g->bits;
+  if (met && clear) {
+    g->bits &= ~bits;
+  }
+  return value;
+}
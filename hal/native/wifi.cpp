@@ -0,0 +1,174 @@
+#include "esp_wifi.h"
+#include "hal_native.h"
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+static std::mutex wifi_mutex;
+static bool wifi_initialized = false;
+static bool wifi_started = false;
+static wifi_mode_t wifi_mode = WIFI_MODE_NULL;
+static wifi_config_t wifi_configs[2];
+static uint8_t wifi_channel = 1;
+static bool promiscuous = false;
+static wifi_promiscuous_cb_t promiscuous_cb = nullptr;
+static uint32_t promiscuous_mask = WIFI_PROMIS_FILTER_MASK_ALL;
+static HalTxHook tx_hook = nullptr;
+static std::atomic<uint32_t> tx_count(0);
+
+extern "C" {
+
+esp_err_t esp_wifi_init(const wifi_init_config_t* config) {
+  wifi_initialized = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_deinit() {
+  wifi_initialized = false;
+  wifi_started = false;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_start() {
+  if (!wifi_initialized) return ESP_ERR_WIFI_NOT_INIT;
+  wifi_started = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_stop() {
+  wifi_started = false;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode) {
+  if (!wifi_initialized) return ESP_ERR_WIFI_NOT_INIT;
+  wifi_mode = mode;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_mode(wifi_mode_t* mode) {
+  if (!wifi_initialized) return ESP_ERR_WIFI_NOT_INIT;
+  *mode = wifi_mode;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_storage(wifi_storage_t storage) {
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_config(wifi_interface_t ifx, wifi_config_t* config) {
+  if (ifx != WIFI_IF_STA && ifx != WIFI_IF_AP) return ESP_ERR_WIFI_IF;
+  wifi_configs[ifx] = *config;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_config(wifi_interface_t ifx, wifi_config_t* config) {
+  if (ifx != WIFI_IF_STA && ifx != WIFI_IF_AP) return ESP_ERR_WIFI_IF;
+  *config = wifi_configs[ifx];
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second) {
+  if (primary < 1 || primary > 14) return ESP_ERR_INVALID_ARG;
+  wifi_channel = primary;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_channel(uint8_t* primary, wifi_second_chan_t* second) {
+  *primary = wifi_channel;
+  if (second) *second = WIFI_SECOND_CHAN_NONE;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_promiscuous(bool enable) {
+  std::lock_guard<std::mutex> lock(wifi_mutex);
+  promiscuous = enable;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_promiscuous(bool* enable) {
+  *enable = promiscuous;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb) {
+  std::lock_guard<std::mutex> lock(wifi_mutex);
+  promiscuous_cb = cb;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_promiscuous_filter(const wifi_promiscuous_filter_t* filter) {
+  std::lock_guard<std::mutex> lock(wifi_mutex);
+  promiscuous_mask = filter->filter_mask;
+  return ESP_OK;
+}
+
+static esp_err_t transmit(wifi_interface_t ifx, const void* buffer, int len) {
+  if (!wifi_started) return ESP_ERR_WIFI_NOT_STARTED;
+  if (len <= 0 || len > 1500) return ESP_ERR_INVALID_ARG;
+  tx_count++;
+  HalTxHook hook = tx_hook;
+  if (hook) {
+    hook(ifx, (const uint8_t*)buffer, len);
+  }
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_80211_tx(wifi_interface_t ifx, const void* buffer, int len, bool en_sys_seq) {
+  return transmit(ifx, buffer, len);
+}
+
+esp_err_t esp_wifi_internal_tx(wifi_interface_t ifx, const void* buffer, int len) {
+  return transmit(ifx, buffer, len);
+}
+
+}  // extern "C"
+
+bool halInjectFrame(const uint8_t* frame, size_t len, int8_t rssi, uint8_t channel) {
+  if (len < 2 || len > 2500) return false;
+
+  wifi_promiscuous_cb_t cb;
+  uint32_t mask;
+  {
+    std::lock_guard<std::mutex> lock(wifi_mutex);
+    if (!promiscuous || promiscuous_cb == nullptr) return false;
+    cb = promiscuous_cb;
+    mask = promiscuous_mask;
+  }
+
+  wifi_promiscuous_pkt_type_t type;
+  uint32_t type_mask;
+  switch ((frame[0] >> 2) & 0x3) {
+    case 0: type = WIFI_PKT_MGMT; type_mask = WIFI_PROMIS_FILTER_MASK_MGMT; break;
+    case 1: type = WIFI_PKT_CTRL; type_mask = WIFI_PROMIS_FILTER_MASK_CTRL; break;
+    case 2: type = WIFI_PKT_DATA; type_mask = WIFI_PROMIS_FILTER_MASK_DATA; break;
+    default: type = WIFI_PKT_MISC; type_mask = WIFI_PROMIS_FILTER_MASK_MISC; break;
+  }
+  if ((mask & type_mask) == 0) return false;
+
+  // The driver hands over the frame with its FCS, zeroed here
+  static thread_local std::vector<uint8_t> buf;
+  buf.assign(sizeof(wifi_promiscuous_pkt_t) + len + 4, 0);
+  wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)buf.data();
+  pkt->rx_ctrl.rssi = rssi;
+  pkt->rx_ctrl.channel = channel ? channel : wifi_channel;
+  pkt->rx_ctrl.sig_len = len + 4;
+  pkt->rx_ctrl.noise_floor = -95;
+  pkt->rx_ctrl.timestamp = (uint32_t)halClockNowUs();
+  memcpy(pkt->payload, frame, len);
+  cb(pkt, type);
+  return true;
+}
+
+void halSetTxHook(HalTxHook hook) {
+  tx_hook = hook;
+}
+
+uint8_t halGetChannel() {
+  return wifi_channel;
+}
+
+uint32_t halGetTxCount() {
+  return tx_count;
+}
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Compress the portal pages in web/ into src/web_assets.h.
+
+Runs as a PlatformIO pre-build script (see extra_scripts in platformio.ini)
+and can be run by hand after editing web/ when building from the Arduino IDE:
+
+    python3 scripts/gen_web_assets.py
+
+Each file is lightly minified (indentation and blank lines dropped), gzipped
+with a fixed timestamp so the output is reproducible, and emitted as a flash
+resident byte array with a strong ETag derived from the compressed bytes.
+The header is only rewritten when its content changes, so unchanged pages do
+not trigger a rebuild.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+MIME_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".json": "application/json",
+    ".svg": "image/svg+xml",
+}
+
+
+def minify(text):
+    lines = (line.strip() for line in text.splitlines())
+    return "\n".join(line for line in lines if line) + "\n"
+
+
+def symbol_for(name):
+    return "WEB_" + re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def render(root):
+    web_dir = os.path.join(root, "web")
+    out = [
+        "// Generated by scripts/gen_web_assets.py from web/, do not edit",
+        "#ifndef _WEB_ASSETS_H_",
+        "#define _WEB_ASSETS_H_",
+        "",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "",
+        "struct WebAsset {",
+        "  const char* type;",
+        "  const char* etag;",
+        "  const uint8_t* data;  // gzip",
+        "  size_t len;",
+        "  size_t raw_len;",
+        "};",
+        "",
+    ]
+
+    for name in sorted(os.listdir(web_dir)):
+        ext = os.path.splitext(name)[1]
+        if ext not in MIME_TYPES:
+            continue
+        with open(os.path.join(web_dir, name), encoding="utf-8") as f:
+            raw = minify(f.read()).encode("utf-8")
+        data = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = '"%s"' % hashlib.sha256(data).hexdigest()[:16]
+        sym = symbol_for(name)
+
+        out.append("// %s: %d -> %d bytes" % (name, len(raw), len(data)))
+        out.append("static const uint8_t %s_GZ[] = {" % sym)
+        for i in range(0, len(data), 16):
+            out.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+        out.append("};")
+        out.append('static const WebAsset %s = {"%s", "%s", %s_GZ, sizeof(%s_GZ), %d};'
+                   % (sym, MIME_TYPES[ext], etag.replace('"', '\\"'), sym, sym, len(raw)))
+        out.append("")
+
+    out.append("#endif")
+    return "\n".join(out) + "\n"
+
+
+def generate(root):
+    path = os.path.join(root, "src", "web_assets.h")
+    content = render(root)
+    try:
+        with open(path, encoding="utf-8") as f:
+            if f.read() == content:
+                return
+    except FileNotFoundError:
+        pass
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(content)
+    print("gen_web_assets: wrote %s" % path)
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        generate(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
@@ -1,5 +1,7 @@
 #include <freertos/FreeRTOS.h>
 #include "GPSAnalyse.h"
+#include "task_config.h"
+#include "tracer.h"
 
 GPSAnalyse::GPSAnalyse() {
     _GPS_Str.clear();
@@ -71,9 +73,8 @@ void GPSAnalyse::start() {
         return;
     }
     
-    _isRunning = true;
-    xTaskCreatePinnedToCore(GPSAnalyse::taskTrampoline, "GPSTask", 4096, this, 1, NULL, 1);
-    Serial.println("GPS: Task started");
+    _isRunning = startTask(TASK_GPS, GPSAnalyse::taskTrampoline, this);
+    Serial.println(_isRunning ? "GPS: Task started" : "GPS: Failed to start task");
 }
 
 void GPSAnalyse::stop() {
@@ -114,13 +115,7 @@ void GPSAnalyse::run(void *data)
             int bytesRead = _serial->readBytes(GPSReadBuff, _serial->available());
             
             if (bytesRead > 0) {
-                _GPS_Str.concat(GPSReadBuff);
-                
-                if (_xSemaphore != NULL) {
-                    xSemaphoreTake(_xSemaphore, portMAX_DELAY);
-                    Analyse();
-                    xSemaphoreGive(_xSemaphore);
-                }
+                feed(GPSReadBuff);
             }
             delay(1);
         }
@@ -135,6 +130,19 @@ void GPSAnalyse::run(void *data)
     vTaskDelete(NULL);
 }
 
+void GPSAnalyse::feed(const char *nmea)
+{
+    _GPS_Str.concat(nmea);
+    TRACE_SCOPE("gpsParse");
+    if (_xSemaphore == NULL) {  // No reader task to race with
+        Analyse();
+        return;
+    }
+    xSemaphoreTake(_xSemaphore, portMAX_DELAY);
+    Analyse();
+    xSemaphoreGive(_xSemaphore);
+}
+
 void GPSAnalyse::upDate()
 {
     if (_xSemaphore == NULL) return;
@@ -104,6 +104,8 @@ public:
     bool begin(int rxPin, int txPin, unsigned long baud = 9600);
     void setSerialPtr(HardwareSerial &serial);
     void upDate();
+    // Append raw NMEA text and parse the complete sentences, as the reader task does
+    void feed(const char *nmea);
     void start();
     void stop();
     bool isConnected();
@@ -0,0 +1,149 @@
+#include "affinity_bench.h"
+
+#if AFFINITY_BENCHMARK
+
+#include "pwn.h"
+#include "metrics.h"
+
+#define BENCH_TICK_MS 10
+#define BENCH_FRAMES_PER_TICK ((BENCH_FRAME_RATE * BENCH_TICK_MS + 999) / 1000)
+#define BENCH_FRAME_MAX 320
+
+static uint8_t bench_buf[sizeof(wifi_promiscuous_pkt_t) + BENCH_FRAME_MAX];
+
+static const uint8_t bench_beacon_hdr[] = {
+  0x80, 0x00, 0x00, 0x00,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff,  // DA
+  0x02, 0xbe, 0x4c, 0x00, 0x00, 0x00,  // SA, low bytes vary
+  0x02, 0xbe, 0x4c, 0x00, 0x00, 0x00,  // BSSID
+  0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x64, 0x00, 0x11, 0x04,
+};
+
+static wifi_promiscuous_pkt_t* benchFrame(uint16_t len, uint8_t channel) {
+  wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)bench_buf;
+  memset(&pkt->rx_ctrl, 0, sizeof(pkt->rx_ctrl));
+  pkt->rx_ctrl.rssi = -40 - (int)(esp_random() % 50);
+  pkt->rx_ctrl.channel = channel;
+  pkt->rx_ctrl.sig_len = len + 4;  // FCS
+  return pkt;
+}
+
+static uint16_t buildBeacon(uint8_t* p, uint32_t n) {
+  memcpy(p, bench_beacon_hdr, sizeof(bench_beacon_hdr));
+  p[14] = p[20] = (n >> 8) & 0xff;
+  p[15] = p[21] = n & 0xff;
+  uint16_t len = sizeof(bench_beacon_hdr);
+  int ssid_len = snprintf((char*)p + len + 2, 33, "bench-%02x", (unsigned)(n & 0x3f));
+  p[len] = 0x00;
+  p[len + 1] = ssid_len;
+  return len + 2 + ssid_len;
+}
+
+static uint16_t buildPeerBeacon(uint8_t* p, uint32_t n) {
+  memcpy(p, bench_beacon_hdr, sizeof(bench_beacon_hdr));
+  static const uint8_t sa[] = {0xde, 0xad, 0xbe, 0xef, 0xde, 0xad};
+  memcpy(p + 10, sa, sizeof(sa));
+  uint16_t len = sizeof(bench_beacon_hdr);
+  unsigned id = n % BENCH_PWNGRID_PEERS;
+  int ie_len = snprintf((char*)p + len + 2, 250,
+                        "{\"name\":\"bench%u\",\"identity\":\"%064x\",\"face\":\"(o_o)\","
+                        "\"pwnd_run\":0,\"pwnd_tot\":%u,\"version\":\"bench\"}",
+                        id, id, (unsigned)n);
+  p[len] = 0xde;
+  p[len + 1] = ie_len;
+  return len + 2 + ie_len;
+}
+
+static uint16_t buildEapol(uint8_t* p, uint32_t n) {
+  uint16_t len = buildBeacon(p, n);
+  p[0] = 0x08;  // Data frame carrying an EAPOL LLC header
+  p[30] = 0x88;
+  p[31] = 0x8e;
+  return len;
+}
+
+static uint32_t percentOf(uint32_t part, uint32_t whole) {
+  return whole ? (uint32_t)((uint64_t)part * 100 / whole) : 0;
+}
+
+static void benchTask(void* pv) {
+  vTaskDelay(pdMS_TO_TICKS(BENCH_WARMUP_MS));
+
+  Serial.printf("Bench: %u frames/s for %u ms\n", BENCH_FRAME_RATE, BENCH_DURATION_MS);
+  logTaskLayout();
+
+  // The sniffer callback isn't reentrant, keep the driver out of it
+  esp_wifi_set_promiscuous(false);
+  uint8_t channel = wifi_get_channel();
+
+  uint64_t frames_before = getMetricCounter(METRIC_SNIFFER_FRAMES);
+  uint64_t drops_before = getMetricCounter(METRIC_QUEUE_DROPS);
+  MetricHistogramSnapshot ui_before, db_before;
+  getMetricHistogram(METRIC_UI_FRAME, &ui_before);
+  getMetricHistogram(METRIC_DB_QUEUE_LATENCY, &db_before);
+
+  uint32_t sent = 0;
+  uint32_t expected = 0;
+  uint32_t late_ticks = 0;
+  uint8_t* frame = ((wifi_promiscuous_pkt_t*)bench_buf)->payload;
+
+  int64_t start_us = esp_timer_get_time();
+  int64_t end_us = start_us + (int64_t)BENCH_DURATION_MS * 1000;
+  TickType_t wake = xTaskGetTickCount();
+  while (esp_timer_get_time() < end_us) {
+    int64_t tick_deadline = esp_timer_get_time() + BENCH_TICK_MS * 1000;
+    expected += BENCH_FRAMES_PER_TICK;
+
+    // Frames not delivered within their tick are what the driver would drop
+    for (uint32_t i = 0; i < BENCH_FRAMES_PER_TICK && esp_timer_get_time() < tick_deadline; i++) {
+      uint32_t n = sent++;
+      if (n % BENCH_EAPOL_EVERY == 0) {
+        uint16_t len = buildEapol(frame, n);
+        enqueue_packet_from_sniffer(frame, len, frame + 16, "BENCH", channel);
+      }
+      uint16_t len = (n % BENCH_PWNGRID_EVERY == 0) ? buildPeerBeacon(frame, n) : buildBeacon(frame, n);
+      pwnSnifferCallback(benchFrame(len, channel), WIFI_PKT_MGMT);
+    }
+
+    if ((TickType_t)(xTaskGetTickCount() - wake) >= pdMS_TO_TICKS(BENCH_TICK_MS)) {
+      late_ticks++;
+    }
+    vTaskDelayUntil(&wake, pdMS_TO_TICKS(BENCH_TICK_MS));
+  }
+  uint32_t elapsed_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+
+  // Let the DB workers drain what is still queued before reading latency
+  vTaskDelay(pdMS_TO_TICKS(2000));
+  MetricHistogramSnapshot ui, db;
+  getMetricHistogram(METRIC_UI_FRAME, &ui);
+  metricHistogramDelta(&ui, ui_before);
+  getMetricHistogram(METRIC_DB_QUEUE_LATENCY, &db);
+  metricHistogramDelta(&db, db_before);
+  uint64_t frames = getMetricCounter(METRIC_SNIFFER_FRAMES) - frames_before;
+  uint64_t drops = getMetricCounter(METRIC_QUEUE_DROPS) - drops_before;
+  resumePwnSniffer();
+
+  uint32_t dropped = expected > sent ? expected - sent : 0;
+  Serial.printf("Bench: layout %d, %u of %u frames in %u ms (%u/s), %u dropped (%u%%), %u late ticks\n",
+                TASK_LAYOUT, (unsigned)sent, (unsigned)expected, (unsigned)elapsed_ms,
+                (unsigned)(elapsed_ms ? (uint64_t)sent * 1000 / elapsed_ms : 0),
+                (unsigned)dropped, (unsigned)percentOf(dropped, expected), (unsigned)late_ticks);
+  Serial.printf("Bench: sniffer saw %u frames, %u lost to full DB queues\n",
+                (unsigned)frames, (unsigned)drops);
+  Serial.printf("Bench: %u UI frames, avg %u us, p99 <= %u us\n",
+                (unsigned)ui.count, (unsigned)metricMeanUs(ui), (unsigned)metricQuantileUs(ui, 0.99f));
+  Serial.printf("Bench: %u DB writes, latency avg %u us, p99 <= %u us\n",
+                (unsigned)db.count, (unsigned)metricMeanUs(db), (unsigned)metricQuantileUs(db, 0.99f));
+  vTaskDelete(NULL);
+}
+
+void startAffinityBenchmark() {
+  if (xTaskCreatePinnedToCore(benchTask, "affinityBench", 4096, NULL, BENCH_FLOOD_PRIORITY, NULL,
+                              BENCH_FLOOD_CORE) != pdPASS) {
+    Serial.println("Bench: Failed to start");
+  }
+}
+
+#endif
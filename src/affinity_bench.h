@@ -0,0 +1,45 @@
+#ifndef _AFFINITY_BENCH_H_
+#define _AFFINITY_BENCH_H_
+
+#include "Arduino.h"
+#include "task_config.h"
+
+// Task layout benchmark, built only with -DAFFINITY_BENCHMARK=1.
+// A flood task stands in for the Wi-Fi driver and feeds synthetic beacons,
+// pwngrid beacons and EAPOL captures through the real sniffer callback and
+// DB queues, then reports frame drops, UI frame time and DB latency for the
+// layout the firmware was built with. Compare layouts with e.g.
+//   -DAFFINITY_BENCHMARK=1 -DTASK_LAYOUT=1
+// The real sniffer is paused while it runs. Synthetic friends and packets
+// (type "BENCH") are written to the database, so use a scratch device.
+
+#ifndef BENCH_FRAME_RATE
+#define BENCH_FRAME_RATE 2000       // Synthetic frames per second
+#endif
+#ifndef BENCH_DURATION_MS
+#define BENCH_DURATION_MS 30000
+#endif
+#ifndef BENCH_WARMUP_MS
+#define BENCH_WARMUP_MS 10000       // Let boot, UI and storage settle first
+#endif
+#ifndef BENCH_EAPOL_EVERY
+#define BENCH_EAPOL_EVERY 50        // One captured packet per this many frames
+#endif
+#ifndef BENCH_PWNGRID_EVERY
+#define BENCH_PWNGRID_EVERY 10      // One pwngrid beacon per this many frames
+#endif
+#ifndef BENCH_PWNGRID_PEERS
+#define BENCH_PWNGRID_PEERS 16
+#endif
+#ifndef BENCH_FLOOD_CORE
+#define BENCH_FLOOD_CORE 0          // Where the Wi-Fi driver delivers frames
+#endif
+#ifndef BENCH_FLOOD_PRIORITY
+#define BENCH_FLOOD_PRIORITY 20
+#endif
+
+#if AFFINITY_BENCHMARK
+void startAffinityBenchmark();
+#endif
+
+#endif
@@ -1,6 +1,8 @@
 #include "ai.h"
 #include "pwn.h"
 #include "config.h"
+#include "task_config.h"
+#include "tracer.h"
 
 // Timing constants
 constexpr int MIN_STEP_MS = 5000;
@@ -14,7 +16,7 @@ const char* actionNames[] = {"STAY", "NEXT", "PREV", "DEAUTH", "IDLE"};
 long observeSince = 0;
 long idleSince = 0;
 bool observing = false;
-TaskHandle_t brainTask;
+TaskHandle_t brainTask = nullptr;
 
 class QLearningAgent {
 private:
@@ -78,20 +80,8 @@ public:
   }
 
   void update(const State& state, Action action, float reward, const State& nextState) {
-    int s = state.toIndex();
-    int a = (int)action;
-    int s_next = nextState.toIndex();
-    
-    // Find max Q-value for next state
-    float maxQ = Q[s_next][0];
-    for (int i = 1; i < NUM_ACTIONS; i++) {
-      if (Q[s_next][i] > maxQ) {
-        maxQ = Q[s_next][i];
-      }
-    }
-    
-    // Q-learning update: Q(s,a) ← Q(s,a) + α[r + γ·max Q(s',a') - Q(s,a)]
-    Q[s][a] += alpha * (reward + gamma * maxQ - Q[s][a]);
+    qLearningStep(&Q[0][0], NUM_ACTIONS, state.toIndex(), (int)action, nextState.toIndex(),
+                  reward, alpha, gamma);
     
     // Decay exploration
     if (epsilon > epsilon_min) {
@@ -291,6 +281,7 @@ void applyAction(Action action, Environment& env);
 
 void think(void* pv) {
   while (true) {
+    TRACE_BEGIN("think");
     Environment& env = getEnv();
     currentState = State::fromObservation(env);
     currentState.epoch = agent.getEpochCount();
@@ -305,9 +296,11 @@ void think(void* pv) {
     Serial.printf("⏱️  %dms\n", stepDuration);
     
     applyAction(currentAction, env);
+    TRACE_END("think");
     
     env.reset();
     delay(stepDuration);
+    TRACE_BEGIN("learn");
     env.update();
     
     State nextState = State::fromObservation(env);
@@ -320,13 +313,16 @@ void think(void* pv) {
     if (agent.getEpochCount() % 200 == 0) {
       agent.printPolicy();
     }
+    TRACE_END("learn");
   }
 }
 
 void startBrain() {
+  if (brainTask != nullptr) {
+    return;  // Already thinking
+  }
   Serial.println("🧠 Starting Brain...");
-  BaseType_t result = xTaskCreate(think, "think", 8192, NULL, 1, &brainTask);
-  if (result == pdPASS) {
+  if (startTask(TASK_BRAIN, think, NULL, &brainTask)) {
     Serial.println("🧠 Brain task created successfully");
   } else {
     Serial.println("❌ Failed to create brain task");
@@ -334,7 +330,10 @@ void startBrain() {
 }
 
 void stopBrain() {
-  vTaskDelete(brainTask);
+  if (brainTask != nullptr) {
+    vTaskDelete(brainTask);
+    brainTask = nullptr;
+  }
 }
 
 void applyAction(Action action, Environment& env) {
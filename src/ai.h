@@ -47,6 +47,21 @@ inline State State::fromObservation(const Environment& env) {
   return s;
 }
 
+// Q-learning update on a table of `actions` columns, the learning step of
+// the brain's agent: Q(s,a) += alpha * (r + gamma * max Q(s',a') - Q(s,a))
+inline void qLearningStep(float* q, int actions, int s, int a, int s_next, float reward,
+                          float alpha, float gamma) {
+  const float* next = q + s_next * actions;
+  float maxQ = next[0];
+  for (int i = 1; i < actions; i++) {
+    if (next[i] > maxQ) {
+      maxQ = next[i];
+    }
+  }
+  float& value = q[s * actions + a];
+  value += alpha * (reward + gamma * maxQ - value);
+}
+
 void startBrain();
 void stopBrain();
 
@@ -1,6 +1,21 @@
 #include "ap_config.h"
+#include "storage.h"
+#include "db.h"
+#include "web_assets.h"
+#include "events.h"
+#include "export.h"
+#include "gzip_stream.h"
+#include "pwn.h"
+#include "identity.h"
+#include "task_config.h"
+#include "metrics.h"
+#include "tracer.h"
+#include "peer_history.h"
+#include <esp_http_server.h>
+#include <esp_timer.h>
+#include <lwip/sockets.h>
 
-WebServer server(80);
+static httpd_handle_t http_server = nullptr;
 bool ap_mode_active = false;
 unsigned long ap_start_time = 0;
 
@@ -12,831 +27,123 @@ const size_t JSON_DEVICE_NAME_KEY_LEN = sizeof(JSON_DEVICE_NAME_KEY) - 1;
 const size_t JSON_BRIGHTNESS_KEY_LEN = sizeof(JSON_BRIGHTNESS_KEY) - 1;
 const size_t JSON_PERSONALITY_KEY_LEN = sizeof(JSON_PERSONALITY_KEY) - 1;
 
-const char* html_page = R"rawliteral(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-  <meta charset="UTF-8">
-  <meta name="viewport" content="width=device-width, initial-scale=1.0">
-  <title>Gotchi Configuration</title>
-  <style>
-    * {
-      margin: 0;
-      padding: 0;
-      box-sizing: border-box;
-    }
-    
-    body { 
-      font-family: 'Courier New', monospace;
-      background: linear-gradient(135deg, #0a0a0a 0%, #1a1a2e 100%);
-      color: #00ff41;
-      min-height: 100vh;
-      padding: 20px;
-    }
-    
-    .container {
-      max-width: 600px;
-      margin: 0 auto;
-    }
-    
-    header {
-      text-align: center;
-      margin-bottom: 30px;
-      padding: 20px;
-      background: rgba(0, 255, 65, 0.05);
-      border: 2px solid #00ff41;
-      border-radius: 10px;
-      position: relative;
-      overflow: hidden;
-    }
-    
-    header::before {
-      content: '';
-      position: absolute;
-      top: 0;
-      left: -100%;
-      width: 100%;
-      height: 100%;
-      background: linear-gradient(90deg, transparent, rgba(0, 255, 65, 0.1), transparent);
-      animation: scan 3s infinite;
-    }
-    
-    @keyframes scan {
-      0% { left: -100%; }
-      100% { left: 100%; }
-    }
-    
-    h1 { 
-      font-size: 2em;
-      color: #00ff41;
-      text-shadow: 0 0 10px #00ff41, 0 0 20px #00ff41;
-      margin-bottom: 10px;
-      letter-spacing: 2px;
-    }
-    
-    .ascii-art {
-      font-size: 0.6em;
-      line-height: 1.2;
-      color: #00cc33;
-      margin-top: 10px;
-    }
-    
-    nav {
-      display: flex;
-      justify-content: center;
-      gap: 20px;
-      margin-bottom: 30px;
-      flex-wrap: wrap;
-    }
-    
-    nav a {
-      color: #00ff41;
-      text-decoration: none;
-      padding: 10px 20px;
-      border: 1px solid #00ff41;
-      border-radius: 5px;
-      transition: all 0.3s;
-      background: rgba(0, 255, 65, 0.05);
-    }
-    
-    nav a:hover {
-      background: rgba(0, 255, 65, 0.2);
-      box-shadow: 0 0 15px rgba(0, 255, 65, 0.5);
-      transform: translateY(-2px);
-    }
-    
-    .card {
-      background: rgba(10, 10, 10, 0.8);
-      border: 2px solid #00ff41;
-      border-radius: 10px;
-      padding: 25px;
-      margin-bottom: 20px;
-      box-shadow: 0 0 20px rgba(0, 255, 65, 0.2);
-    }
-    
-    .form-group { 
-      margin: 20px 0;
-    }
-    
-    label { 
-      display: block;
-      margin-bottom: 8px;
-      font-weight: bold;
-      color: #00ff41;
-      font-size: 0.95em;
-      text-transform: uppercase;
-      letter-spacing: 1px;
-    }
-    
-    input[type="text"], input[type="number"] { 
-      width: 100%;
-      padding: 12px;
-      font-size: 16px;
-      border: 2px solid #00ff41;
-      background: rgba(0, 0, 0, 0.5);
-      color: #00ff41;
-      border-radius: 5px;
-      font-family: 'Courier New', monospace;
-      transition: all 0.3s;
-    }
-    
-    input[type="text"]:focus, input[type="number"]:focus {
-      outline: none;
-      box-shadow: 0 0 15px rgba(0, 255, 65, 0.5);
-      background: rgba(0, 0, 0, 0.7);
-    }
-    
-    .radio-group {
-      display: flex;
-      flex-direction: column;
-      gap: 12px;
-      margin-top: 10px;
-    }
-    
-    .radio-option {
-      display: flex;
-      align-items: center;
-      padding: 12px;
-      border: 1px solid rgba(0, 255, 65, 0.3);
-      border-radius: 5px;
-      cursor: pointer;
-      transition: all 0.3s;
-      background: rgba(0, 0, 0, 0.3);
-    }
-    
-    .radio-option:hover {
-      background: rgba(0, 255, 65, 0.1);
-      border-color: #00ff41;
-    }
-    
-    .radio-option input[type="radio"] {
-      margin-right: 12px;
-      width: 18px;
-      height: 18px;
-      cursor: pointer;
-      accent-color: #00ff41;
-    }
-    
-    .radio-option label {
-      margin: 0;
-      cursor: pointer;
-      flex: 1;
-      text-transform: none;
-      letter-spacing: normal;
-      font-weight: normal;
-    }
-    
-    button { 
-      width: 100%;
-      padding: 14px;
-      font-size: 16px;
-      background: #00ff41;
-      color: #000;
-      border: none;
-      cursor: pointer;
-      font-weight: bold;
-      margin-top: 10px;
-      border-radius: 5px;
-      font-family: 'Courier New', monospace;
-      text-transform: uppercase;
-      letter-spacing: 2px;
-      transition: all 0.3s;
-      position: relative;
-      overflow: hidden;
-    }
-    
-    button::before {
-      content: '';
-      position: absolute;
-      top: 50%;
-      left: 50%;
-      width: 0;
-      height: 0;
-      border-radius: 50%;
-      background: rgba(255, 255, 255, 0.5);
-      transform: translate(-50%, -50%);
-      transition: width 0.6s, height 0.6s;
-    }
-    
-    button:hover::before {
-      width: 300px;
-      height: 300px;
-    }
-    
-    button:hover {
-      box-shadow: 0 0 25px rgba(0, 255, 65, 0.8);
-      transform: translateY(-2px);
-    }
-    
-    button:active {
-      transform: translateY(0);
-    }
-    
-    button.secondary {
-      background: transparent;
-      color: #00ff41;
-      border: 2px solid #00ff41;
-    }
-    
-    button.secondary:hover {
-      background: rgba(0, 255, 65, 0.1);
-    }
-    
-    .message {
-      padding: 15px;
-      margin: 15px 0;
-      border: 2px solid #00ff41;
-      border-radius: 5px;
-      text-align: center;
-      background: rgba(0, 255, 65, 0.1);
-      animation: slideDown 0.3s ease-out;
-    }
-    
-    @keyframes slideDown {
-      from {
-        opacity: 0;
-        transform: translateY(-20px);
-      }
-      to {
-        opacity: 1;
-        transform: translateY(0);
-      }
-    }
-    
-    .info-box {
-      background: rgba(0, 255, 65, 0.05);
-      border-left: 4px solid #00ff41;
-      padding: 12px;
-      margin: 15px 0;
-      font-size: 0.9em;
-      border-radius: 3px;
-    }
-    
-    .brightness-value {
-      display: inline-block;
-      min-width: 40px;
-      text-align: center;
-      color: #00ff41;
-      font-weight: bold;
-    }
-    
-    @media (max-width: 600px) {
-      body {
-        padding: 10px;
-      }
-      
-      h1 {
-        font-size: 1.5em;
-      }
-      
-      .card {
-        padding: 15px;
-      }
-      
-      nav {
-        gap: 10px;
-      }
-      
-      nav a {
-        padding: 8px 15px;
-        font-size: 0.9em;
-      }
-    }
-    
-    .loading {
-      display: inline-block;
-      width: 20px;
-      height: 20px;
-      border: 3px solid rgba(0, 255, 65, 0.3);
-      border-radius: 50%;
-      border-top-color: #00ff41;
-      animation: spin 1s linear infinite;
-    }
-    
-    @keyframes spin {
-      to { transform: rotate(360deg); }
-    }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <header>
-      <h1>⚡ GOTCHI CONFIG ⚡</h1>
-      <div class="ascii-art">
-        ( ◕‿◕) pwning the airwaves
-      </div>
-    </header>
-    
-    <nav>
-      <a href="/">⚙️ Config</a>
-      <a href="/friends">👥 Friends</a>
-      <a href="/packets">📦 Packets</a>
-    </nav>
-    
-    <div class="card">
-      <form id="configForm">
-        <div class="form-group">
-          <label for="device_name">Device Name</label>
-          <input type="text" id="device_name" name="device_name" maxlength="31" required placeholder="Enter device name">
-          <div class="info-box" style="margin-top: 8px;">
-            Max 31 characters. This identifies your device on the network.
-          </div>
-        </div>
-        
-        <div class="form-group">
-          <label for="brightness">
-            Display Brightness: <span class="brightness-value" id="brightness-display">128</span>
-          </label>
-          <input type="range" id="brightness" name="brightness" min="0" max="255" value="128" 
-                 style="width: 100%; accent-color: #00ff41; height: 8px; cursor: pointer;">
-          <div class="info-box" style="margin-top: 8px;">
-            Range: 0 (off) to 255 (max). Adjust for battery life vs visibility.
-          </div>
-        </div>
-        
-        <div class="form-group">
-          <label>Personality Mode</label>
-          <div class="radio-group">
-            <div class="radio-option">
-              <input type="radio" id="friendly" name="personality" value="friendly" checked>
-              <label for="friendly">🤝 Friendly - Just looking for friends</label>
-            </div>
-            <div class="radio-option">
-              <input type="radio" id="ai" name="personality" value="ai">
-              <label for="ai">👀 AI - Quietly sniffing around</label>
-            </div>
-          </div>
-        </div>
-        
-        <button type="submit">💾 Save Configuration</button>
-        <button type="button" class="secondary" onclick="resetConfig()">🔄 Reset to Defaults</button>
-      </form>
-    </div>
-    
-    <div id="message" class="message" style="display:none;"></div>
-  </div>
-  
-  <script>
-    // Update brightness display value
-    const brightnessInput = document.getElementById('brightness');
-    const brightnessDisplay = document.getElementById('brightness-display');
-    
-    brightnessInput.addEventListener('input', function() {
-      brightnessDisplay.textContent = this.value;
-    });
-    
-    // Load current configuration on page load
-    window.onload = function() {
-      const msg = document.getElementById('message');
-      msg.textContent = 'Loading configuration...';
-      msg.style.display = 'block';
-      
-      fetch('/api/config')
-        .then(response => {
-          if (!response.ok) throw new Error('Failed to load config');
-          return response.json();
-        })
-        .then(data => {
-          document.getElementById('device_name').value = data.device_name || '';
-          
-          const brightness = parseInt(data.brightness) || 128;
-          document.getElementById('brightness').value = brightness;
-          brightnessDisplay.textContent = brightness;
-          
-          const personality = (data.personality || 'friendly').toLowerCase();
-          const radioBtn = document.getElementById(personality);
-          if (radioBtn) radioBtn.checked = true;
-          
-          msg.textContent = '✓ Configuration loaded';
-          setTimeout(() => { msg.style.display = 'none'; }, 2000);
-        })
-        .catch(error => {
-          console.error('Error:', error);
-          msg.textContent = '⚠ Failed to load configuration';
-          setTimeout(() => { msg.style.display = 'none'; }, 3000);
-        });
-    };
-    
-    // Handle form submission
-    document.getElementById('configForm').onsubmit = function(e) {
-      e.preventDefault();
-      
-      const submitBtn = this.querySelector('button[type="submit"]');
-      const originalText = submitBtn.innerHTML;
-      submitBtn.innerHTML = '<span class="loading"></span> Saving...';
-      submitBtn.disabled = true;
-      
-      const personality = document.querySelector('input[name="personality"]:checked').value;
-      
-      const data = {
-        device_name: document.getElementById('device_name').value.trim(),
-        brightness: parseInt(document.getElementById('brightness').value),
-        personality: personality
-      };
-      
-      fetch('/api/save', {
-        method: 'POST',
-        headers: { 'Content-Type': 'application/json' },
-        body: JSON.stringify(data)
-      })
-      .then(response => {
-        if (!response.ok) throw new Error('Save failed');
-        return response.json();
-      })
-      .then(result => {
-        const msg = document.getElementById('message');
-        msg.textContent = '✓ ' + (result.message || 'Configuration saved!');
-        msg.style.display = 'block';
-        msg.style.borderColor = '#00ff41';
-        
-        submitBtn.innerHTML = originalText;
-        submitBtn.disabled = false;
-        
-        setTimeout(() => { msg.style.display = 'none'; }, 3000);
-      })
-      .catch(error => {
-        console.error('Error:', error);
-        const msg = document.getElementById('message');
-        msg.textContent = '⚠ Failed to save configuration';
-        msg.style.borderColor = '#ff4136';
-        msg.style.display = 'block';
-        
-        submitBtn.innerHTML = originalText;
-        submitBtn.disabled = false;
-        
-        setTimeout(() => { msg.style.display = 'none'; }, 3000);
-      });
-    };
-    
-    function resetConfig() {
-      if (!confirm('⚠ Reset all settings to defaults?\n\nThis action cannot be undone.')) {
-        return;
-      }
-      
-      const msg = document.getElementById('message');
-      msg.textContent = 'Resetting configuration...';
-      msg.style.display = 'block';
-      
-      fetch('/api/reset', { method: 'POST' })
-        .then(response => {
-          if (!response.ok) throw new Error('Reset failed');
-          return response.json();
-        })
-        .then(result => {
-          msg.textContent = '✓ ' + (result.message || 'Configuration reset!');
-          msg.style.borderColor = '#00ff41';
-          setTimeout(() => { 
-            location.reload(); 
-          }, 1500);
-        })
-        .catch(error => {
-          console.error('Error:', error);
-          msg.textContent = '⚠ Failed to reset configuration';
-          msg.style.borderColor = '#ff4136';
-          setTimeout(() => { msg.style.display = 'none'; }, 3000);
-        });
-    }
-  </script>
-</body>
-</html>
-)rawliteral";
-
-static const char* HTML_LIST_TPL = R"HTML(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-  <meta charset="UTF-8">
-  <meta name="viewport" content="width=device-width, initial-scale=1.0">
-  <title>%TITLE% - Gotchi</title>
-  <style>
-    * {
-      margin: 0;
-      padding: 0;
-      box-sizing: border-box;
-    }
-    
-    body {
-      font-family: 'Courier New', monospace;
-      background: linear-gradient(135deg, #0a0a0a 0%, #1a1a2e 100%);
-      color: #00ff41;
-      min-height: 100vh;
-      padding: 20px;
-    }
-    
-    .container {
-      max-width: 900px;
-      margin: 0 auto;
-    }
-    
-    header {
-      text-align: center;
-      margin-bottom: 25px;
-      padding: 20px;
-      background: rgba(0, 255, 65, 0.05);
-      border: 2px solid #00ff41;
-      border-radius: 10px;
-    }
-    
-    h1 {
-      font-size: 1.8em;
-      color: #00ff41;
-      text-shadow: 0 0 10px #00ff41;
-      letter-spacing: 2px;
-    }
-    
-    nav {
-      display: flex;
-      justify-content: center;
-      gap: 15px;
-      margin-bottom: 25px;
-      flex-wrap: wrap;
-    }
-    
-    nav a {
-      color: #00ff41;
-      text-decoration: none;
-      padding: 10px 20px;
-      border: 1px solid #00ff41;
-      border-radius: 5px;
-      transition: all 0.3s;
-      background: rgba(0, 255, 65, 0.05);
-    }
-    
-    nav a:hover {
-      background: rgba(0, 255, 65, 0.2);
-      box-shadow: 0 0 15px rgba(0, 255, 65, 0.5);
-      transform: translateY(-2px);
-    }
-    
-    .card {
-      border: 2px solid rgba(0, 255, 65, 0.3);
-      border-radius: 8px;
-      padding: 18px;
-      margin: 12px 0;
-      background: rgba(10, 10, 10, 0.7);
-      transition: all 0.3s;
-      animation: fadeIn 0.3s ease-out;
-    }
-    
-    @keyframes fadeIn {
-      from {
-        opacity: 0;
-        transform: translateY(10px);
-      }
-      to {
-        opacity: 1;
-        transform: translateY(0);
-      }
-    }
-    
-    .card:hover {
-      border-color: #00ff41;
-      background: rgba(0, 255, 65, 0.05);
-      box-shadow: 0 0 20px rgba(0, 255, 65, 0.2);
-    }
-    
-    .card-header {
-      display: flex;
-      align-items: center;
-      flex-wrap: wrap;
-      gap: 10px;
-      margin-bottom: 10px;
-    }
-    
-    .card-title {
-      font-size: 1.1em;
-      font-weight: bold;
-      color: #00ff41;
-    }
-    
-    .badge {
-      display: inline-block;
-      border: 1px solid rgba(0, 255, 65, 0.5);
-      border-radius: 4px;
-      padding: 4px 10px;
-      font-size: 0.85em;
-      color: #00cc33;
-      background: rgba(0, 255, 65, 0.1);
-    }
-    
-    .card-details {
-      color: #00cc33;
-      font-size: 0.9em;
-      line-height: 1.6;
-    }
-    
-    .download-link {
-      display: inline-block;
-      margin-top: 10px;
-      padding: 8px 16px;
-      background: rgba(0, 255, 65, 0.1);
-      color: #00ff41;
-      text-decoration: none;
-      border: 1px solid #00ff41;
-      border-radius: 5px;
-      transition: all 0.3s;
-    }
-    
-    .download-link:hover {
-      background: rgba(0, 255, 65, 0.2);
-      box-shadow: 0 0 15px rgba(0, 255, 65, 0.5);
-    }
-    
-    .empty-state {
-      text-align: center;
-      padding: 40px 20px;
-      color: #00cc33;
-      font-size: 1.1em;
-      border: 2px dashed rgba(0, 255, 65, 0.3);
-      border-radius: 10px;
-      background: rgba(0, 255, 65, 0.02);
-    }
-    
-    .loading {
-      text-align: center;
-      padding: 40px;
-      color: #00ff41;
-    }
-    
-    .loading::after {
-      content: '...';
-      animation: dots 1.5s steps(4, end) infinite;
-    }
-    
-    @keyframes dots {
-      0%, 20% { content: '.'; }
-      40% { content: '..'; }
-      60%, 100% { content: '...'; }
-    }
-    
-    @media (max-width: 600px) {
-      body {
-        padding: 10px;
-      }
-      
-      h1 {
-        font-size: 1.4em;
-      }
-      
-      .card {
-        padding: 12px;
-      }
-      
-      .badge {
-        font-size: 0.75em;
-        padding: 3px 8px;
-      }
-    }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <header>
-      <h1>⚡ %TITLE% ⚡</h1>
-    </header>
-    
-    <nav>
-      <a href="/">⚙️ Config</a>
-      <a href="/friends">👥 Friends</a>
-      <a href="/packets">📦 Packets</a>
-    </nav>
-    
-    <div id="list" class="loading">Loading %TITLE%</div>
-  </div>
-  
-  <script>
-    async function load(url, render) {
-      const listEl = document.getElementById('list');
-      
-      try {
-        const r = await fetch(url);
-        if (!r.ok) throw new Error('Failed to fetch');
-        
-        const data = await r.json();
-        listEl.innerHTML = '';
-        
-        if (!Array.isArray(data) || !data.length) {
-          listEl.innerHTML = '<div class="empty-state">📭 No data available yet.<br><small style="font-size:0.9em; margin-top:10px; display:block;">Start hunting and come back later!</small></div>';
-          return;
-        }
-        
-        data.forEach((item, index) => {
-          setTimeout(() => render(item), index * 50);
-        });
-      } catch (error) {
-        console.error('Error:', error);
-        listEl.innerHTML = '<div class="empty-state" style="border-color: #ff4136; color: #ff4136;">⚠️ Failed to load data.<br><small>Check console for details.</small></div>';
-      }
-    }
-    
-    function esc(s) {
-      return String(s ?? '').replace(/[&<>"']/g, m => ({
-        '&': '&amp;',
-        '<': '&lt;',
-        '>': '&gt;',
-        '"': '&quot;',
-        "'": '&#39;'
-      }[m]));
-    }
-    
-    if (location.pathname === '/friends') {
-      load('/api/friends', (row) => {
-        const d = document.createElement('div');
-        d.className = 'card';
-        
-        const name = esc(row.name || 'Unknown');
-        const id = esc(row.identity || 'N/A').substring(0, 16) + '...';
-        const face = esc(row.face || '(◕‿◕)');
-        const gridVer = esc(row.grid_version || 'N/A');
-        const ver = esc(row.version || 'N/A');
-        const rssi = row.rssi != null ? ` • Signal: ${row.rssi}dBm` : '';
-        const channel = row.channel != null ? ` • Ch: ${row.channel}` : '';
-        
-        d.innerHTML = `
-          <div class="card-header">
-            <span class="card-title">${face} ${name}</span>
-            <span class="badge">ID: ${id}</span>
-          </div>
-          <div class="card-details">
-            Grid: ${gridVer} • Version: ${ver}${rssi}${channel}
-          </div>
-        `;
-        
-        document.getElementById('list').appendChild(d);
-      });
-    }
-    
-    if (location.pathname === '/packets') {
-      load('/api/packets', (row) => {
-        const d = document.createElement('div');
-        d.className = 'card';
-        
-        const id = esc(row.id || 'N/A');
-        const ssid = esc(row.ssid || '(hidden network)');
-        const bssid = esc(row.bssid || 'N/A');
-        const href = `/api/packet/download?id=${encodeURIComponent(id)}`;
-        
-        d.innerHTML = `
-          <div class="card-header">
-            <span class="card-title">📡 ${ssid}</span>
-            <span class="badge">ID: ${id}</span>
-          </div>
-          <div class="card-details">
-            BSSID: ${bssid}
-          </div>
-          <a href="${href}" class="download-link">📥 Download .hc22000</a>
-        `;
-        
-        document.getElementById('list').appendChild(d);
-      });
-    }
-  </script>
-</body>
-</html>
-)HTML";
+// ========== esp_http_server helpers ==========
+static esp_err_t sendResponse(httpd_req_t* req, const char* status, const char* type,
+                              const char* body, ssize_t len = HTTPD_RESP_USE_STRLEN) {
+  httpd_resp_set_status(req, status);
+  httpd_resp_set_type(req, type);
+  return httpd_resp_send(req, body, len);
+}
 
-static String ndjsonToJsonArray(const char* path, size_t limit = 0) {
-  File f = LittleFS.open(path, FILE_READ);
-  String out = "[";
-  if (!f) { out += "]"; return out; }
+static bool getQueryArg(httpd_req_t* req, const char* key, char* val, size_t len) {
+  char query[128];
+  if (httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK) {
+    return false;
+  }
+  return httpd_query_key_value(query, key, val, len) == ESP_OK;
+}
+
+static long getQueryLong(httpd_req_t* req, const char* key, long def) {
+  char val[16];
+  return getQueryArg(req, key, val, sizeof(val)) ? atol(val) : def;
+}
+
+#define NDJSON_LINE_MAX 1024
+#define NDJSON_CHUNK_SIZE 1436  // Roughly one TCP segment per chunk
+#define NDJSON_PAGE_MAX 500
 
-  StaticJsonDocument<1024> doc;
+// Stream a page of an NDJSON table as a JSON array, with chunked transfer
+// encoding. Query: ?offset=&limit=&sort=asc|desc (record order, desc is
+// newest first). Without a limit the whole table is sent. Records are read
+// through the table index and passed through as they are, after a cheap
+// sanity check, so memory use is fixed and the cost is O(page).
+static esp_err_t streamNdjsonPage(httpd_req_t* req, NdjsonTable& table) {
+  // Handlers run one at a time on the server task, keep the buffers off its stack
+  static char out[NDJSON_CHUNK_SIZE];
+  static char line[NDJSON_LINE_MAX];
+  size_t out_len = 0;
   bool first = true;
-  size_t count = 0;
-  
-  while (f.available()) {
-    String line = f.readStringUntil('\n');
-    line.trim();
-    if (line.isEmpty()) continue;
-    
-    doc.clear();
-    DeserializationError err = deserializeJson(doc, line);
-    if (err) {
-      Serial.printf("JSON parse error in NDJSON: %s\n", err.c_str());
+  bool failed = false;
+  unsigned long start = millis();
+
+  table.begin();
+  int total = table.count();
+  int offset = max(0L, getQueryLong(req, "offset", 0));
+  int limit = constrain(getQueryLong(req, "limit", total), 0L, (long)max(total, NDJSON_PAGE_MAX));
+  char sort[8] = "";
+  getQueryArg(req, "sort", sort, sizeof(sort));
+  bool desc = strcmp(sort, "desc") == 0;
+  int end = min(total, offset + limit);
+
+  char total_str[12];
+  snprintf(total_str, sizeof(total_str), "%d", total);
+  httpd_resp_set_hdr(req, "X-Total-Count", total_str);
+  httpd_resp_set_type(req, "application/json");
+
+  auto emit = [&](const char* data, size_t len) {
+    if (out_len + len > sizeof(out)) {
+      failed = failed || httpd_resp_send_chunk(req, out, out_len) != ESP_OK;
+      out_len = 0;
+    }
+    memcpy(out + out_len, data, len);
+    out_len += len;
+  };
+
+  emit("[", 1);
+  for (int i = offset; i < end && !failed; i++) {
+    if (!table.readLine(desc ? total - 1 - i : i, line, sizeof(line))) {
       continue;
     }
 
-    if (!first) out += ",";
+    size_t s = 0, e = strlen(line);
+    while (s < e && isspace((unsigned char)line[s])) s++;
+    while (e > s && isspace((unsigned char)line[e - 1])) e--;
+    if (e <= s || line[s] != '{' || line[e - 1] != '}') {
+      Serial.printf("NDJSON: Skipping malformed or overlong record %d\n", i);
+      continue;
+    }
+
+    if (!first) emit(",", 1);
     first = false;
-    
-    String tmp;
-    serializeJson(doc, tmp);
-    out += tmp;
-    
-    count++;
-    if (limit && count >= limit) break;
+    emit(line + s, e - s);
   }
-  f.close();
-  out += "]";
-  
-  return out;
+  table.end();
+
+  if (failed) {
+    Serial.println("NDJSON: Client went away");
+    return ESP_FAIL;
+  }
+  emit("]", 1);
+  httpd_resp_send_chunk(req, out, out_len);
+  httpd_resp_send_chunk(req, nullptr, 0);
+
+  Serial.printf("NDJSON: Streamed records %d-%d of %d in %lu ms\n", offset, end, total, millis() - start);
+  return ESP_OK;
+}
+
+// Pages are gzipped at build time (scripts/gen_web_assets.py) and served as
+// they are from flash. Browsers revalidate with If-None-Match and get a 304.
+static esp_err_t sendAsset(httpd_req_t* req, const WebAsset& asset) {
+  char inm[64];
+  httpd_resp_set_hdr(req, "ETag", asset.etag);
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+
+  if (httpd_req_get_hdr_value_str(req, "If-None-Match", inm, sizeof(inm)) == ESP_OK &&
+      strstr(inm, asset.etag) != nullptr) {
+    httpd_resp_set_status(req, "304 Not Modified");
+    return httpd_resp_send(req, nullptr, 0);
+  }
+
+  httpd_resp_set_type(req, asset.type);
+  httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+  return httpd_resp_send(req, (const char*)asset.data, asset.len);
 }
 
-void handleRoot() {
-  server.send(200, "text/html", html_page);
+static esp_err_t handleRoot(httpd_req_t* req) {
+  return sendAsset(req, WEB_INDEX_HTML);
 }
 
-void handleGetConfig() {
+static esp_err_t handleGetConfig(httpd_req_t* req) {
   DeviceConfig* config = getConfig();
   
   // Map personality enum to string
@@ -851,7 +158,7 @@ void handleGetConfig() {
   json += "\"personality\":\"" + personalityStr + "\"";
   json += "}";
   
-  server.send(200, "application/json", json);
+  return sendResponse(req, "200 OK", "application/json", json.c_str());
 }
 
 int findJsonFieldEnd(const String& body, int start_pos) {
@@ -862,13 +169,24 @@ int findJsonFieldEnd(const String& body, int start_pos) {
   return end_pos;
 }
 
-void handleSaveConfig() {
-  if (!server.hasArg("plain")) {
-    server.send(400, "application/json", "{\"message\":\"Invalid request - no body\"}");
-    return;
+#define AP_CONFIG_BODY_MAX 512
+
+static esp_err_t handleSaveConfig(httpd_req_t* req) {
+  char buf[AP_CONFIG_BODY_MAX + 1];
+  if (req->content_len == 0 || req->content_len > AP_CONFIG_BODY_MAX) {
+    return sendResponse(req, "400 Bad Request", "application/json", "{\"message\":\"Invalid request - no body\"}");
+  }
+
+  size_t received = 0;
+  while (received < req->content_len) {
+    int r = httpd_req_recv(req, buf + received, req->content_len - received);
+    if (r == HTTPD_SOCK_ERR_TIMEOUT) continue;
+    if (r <= 0) return ESP_FAIL;
+    received += r;
   }
+  buf[received] = '\0';
   
-  String body = server.arg("plain");
+  String body = buf;
   DeviceConfig* config = getConfig();
   
   // Parse device_name
@@ -923,179 +241,663 @@ void handleSaveConfig() {
   
   saveConfig();
   
-  server.send(200, "application/json", "{\"message\":\"Configuration saved! Changes will apply on restart.\"}");
+  return sendResponse(req, "200 OK", "application/json", "{\"message\":\"Configuration saved! Changes will apply on restart.\"}");
 }
 
-void handleResetConfig() {
+static esp_err_t handleResetConfig(httpd_req_t* req) {
   resetConfig();
   saveConfig();
-  server.send(200, "application/json", "{\"message\":\"Configuration reset to defaults!\"}");
+  return sendResponse(req, "200 OK", "application/json", "{\"message\":\"Configuration reset to defaults!\"}");
 }
 
-static bool sendBytesAsFile(const String& filename, const uint8_t* data, size_t len) {
-  WiFiClient client = server.client();
-  if (!client.connected()) return false;
-  
-  String hdr = "HTTP/1.1 200 OK\r\n";
-  hdr += "Content-Type: application/octet-stream\r\n";
-  hdr += "Content-Disposition: attachment; filename=\"" + filename + "\"\r\n";
-  hdr += "Content-Length: " + String(len) + "\r\n";
-  hdr += "Connection: close\r\n\r\n";
-  
-  client.print(hdr);
-  size_t sent = client.write(data, len);
-  return sent == len;
+static void setAttachment(httpd_req_t* req, String& disposition, const String& filename) {
+  disposition = "attachment; filename=\"" + filename + "\"";
+  httpd_resp_set_type(req, "application/octet-stream");
+  httpd_resp_set_hdr(req, "Content-Disposition", disposition.c_str());
 }
 
-static void handleDownloadPacket() {
-  if (!server.hasArg("id")) {
-    server.send(400, "text/plain", "Missing id parameter");
-    return;
+static esp_err_t sendBytesAsFile(httpd_req_t* req, const String& filename, const uint8_t* data, size_t len) {
+  String disposition;
+  setAttachment(req, disposition, filename);
+  return httpd_resp_send(req, (const char*)data, len);
+}
+
+#define PACKET_RECORD_MAX 4096
+
+static esp_err_t handleDownloadPacket(httpd_req_t* req) {
+  char idArg[16];
+  if (!getQueryArg(req, "id", idArg, sizeof(idArg))) {
+    return sendResponse(req, "400 Bad Request", "text/plain", "Missing id parameter");
   }
   
-  const String wantId = server.arg("id");
-  File f = LittleFS.open(PK_TBL, FILE_READ);
-  
-  if (!f) {
-    server.send(404, "text/plain", "Packets table not found");
-    return;
+  // Packet ids are record numbers, the index gives their offset directly
+  const String idStr = idArg;
+  int id = idStr.toInt();
+  static char line[PACKET_RECORD_MAX];
+
+  if (!packetsApiTable.begin()) {
+    packetsApiTable.end();
+    return sendResponse(req, "404 Not Found", "text/plain", "Packets table not found");
+  }
+  bool found = packetsApiTable.readLine(id, line, sizeof(line));
+  packetsApiTable.end();
+
+  if (!found) {
+    return sendResponse(req, "404 Not Found", "text/plain", "Packet ID not found");
   }
 
   StaticJsonDocument<4096> doc;
-  bool found = false;
+  if (deserializeJson(doc, line)) {
+    return sendResponse(req, "500 Internal Server Error", "text/plain", "Corrupted packet record");
+  }
 
-  while (f.available()) {
-    String line = f.readStringUntil('\n');
-    line.trim();
-    if (line.isEmpty()) continue;
+  // Case 1: Inline base64 content
+  if (doc.containsKey("hc22000_b64")) {
+    String b64 = doc["hc22000_b64"].as<String>();
+    size_t needed = 0;
+    
+    int rc = mbedtls_base64_decode(nullptr, 0, &needed,
+                                   (const unsigned char*)b64.c_str(), b64.length());
+    
+    if (rc != MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL && rc != 0) {
+      return sendResponse(req, "500 Internal Server Error", "text/plain", "Base64 length calculation error");
+    }
     
-    doc.clear();
-    if (deserializeJson(doc, line)) continue;
-
-    // Extract ID as string
-    String idStr;
-    if (doc["id"].is<const char*>()) {
-      idStr = String(doc["id"].as<const char*>());
-    } else if (doc["id"].is<int>()) {
-      idStr = String(doc["id"].as<int>());
-    } else if (doc["id"].is<unsigned int>()) {
-      idStr = String(doc["id"].as<unsigned int>());
+    std::unique_ptr<uint8_t[]> buf(new (std::nothrow) uint8_t[needed]);
+    if (!buf) {
+      return sendResponse(req, "500 Internal Server Error", "text/plain", "Out of memory");
     }
 
-    if (idStr != wantId) continue;
-    found = true;
+    size_t outLen = 0;
+    rc = mbedtls_base64_decode(buf.get(), needed, &outLen,
+                               (const unsigned char*)b64.c_str(), b64.length());
+    
+    if (rc != 0) {
+      return sendResponse(req, "500 Internal Server Error", "text/plain", "Base64 decode error");
+    }
 
-    // Case 1: Inline base64 content
-    if (doc.containsKey("hc22000_b64")) {
-      String b64 = doc["hc22000_b64"].as<String>();
-      size_t needed = 0;
-      
-      int rc = mbedtls_base64_decode(nullptr, 0, &needed,
-                                     (const unsigned char*)b64.c_str(), b64.length());
-      
-      if (rc != MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL && rc != 0) {
-        server.send(500, "text/plain", "Base64 length calculation error");
-        break;
+    const String fname = "packet_" + idStr + ".hc22000";
+    return sendBytesAsFile(req, fname, buf.get(), outLen);
+  }
+
+  // Case 2: File path on the active storage
+  if (doc.containsKey("file")) {
+    String p = doc["file"].as<String>();
+    
+    if (!storage.exists(p.c_str())) {
+      return sendResponse(req, "404 Not Found", "text/plain", "File not found on filesystem");
+    }
+
+    File pf = storage.open(p.c_str(), FILE_READ);
+    if (!pf) {
+      return sendResponse(req, "500 Internal Server Error", "text/plain", "Cannot open file");
+    }
+
+    const String fname = p.endsWith(".hc22000") ? 
+                        p.substring(p.lastIndexOf('/') + 1) : 
+                        "packet_" + idStr + ".hc22000";
+    String disposition;
+    setAttachment(req, disposition, fname);
+
+    uint8_t buf[512];
+    esp_err_t err = ESP_OK;
+    while (err == ESP_OK && pf.available()) {
+      size_t r = pf.read(buf, sizeof(buf));
+      if (!r) break;
+      err = httpd_resp_send_chunk(req, (const char*)buf, r);
+    }
+    pf.close();
+    if (err == ESP_OK) {
+      httpd_resp_send_chunk(req, nullptr, 0);
+    }
+    return err;
+  }
+
+  return sendResponse(req, "415 Unsupported Media Type", "text/plain", "No hc22000 content in record");
+}
+
+// Friends and packets share one page, it picks its title from the path
+static esp_err_t handleListPage(httpd_req_t* req) {
+  return sendAsset(req, WEB_LIST_HTML);
+}
+
+static esp_err_t handleApiFriends(httpd_req_t* req) {
+  return streamNdjsonPage(req, friendsApiTable);
+}
+
+static esp_err_t handleApiPackets(httpd_req_t* req) {
+  return streamNdjsonPage(req, packetsApiTable);
+}
+
+// ========== Metrics ==========
+static bool sendMetricsChunk(void* ctx, const char* data, size_t len) {
+  return httpd_resp_send_chunk((httpd_req_t*)ctx, data, len) == ESP_OK;
+}
+
+// Prometheus text format, scrape with e.g. curl http://192.168.4.1/api/metrics
+static esp_err_t handleMetrics(httpd_req_t* req) {
+  httpd_resp_set_type(req, "text/plain; version=0.0.4");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  if (!writeMetricsPrometheus(sendMetricsChunk, req)) {
+    return ESP_FAIL;
+  }
+  return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+// Chrome trace JSON of the recent timeline, open it in ui.perfetto.dev
+static esp_err_t handleTrace(httpd_req_t* req) {
+  if (!isTraceEnabled()) {
+    return sendResponse(req, "404 Not Found", "text/plain", "Built without TRACE_ENABLED");
+  }
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"gotchi-trace.json\"");
+  if (!writeTraceJson(sendMetricsChunk, req)) {
+    return ESP_FAIL;
+  }
+  return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+// ========== Peer history ==========
+// /api/peer/<id>/history, id being the peer's index this session or its identity
+static esp_err_t handlePeerHistory(httpd_req_t* req) {
+  static const char prefix[] = "/api/peer/";
+  const char* id = req->uri + sizeof(prefix) - 1;
+  const char* slash = strchr(id, '/');
+  if (slash == nullptr || slash == id || strncmp(slash, "/history", 8) != 0 ||
+      (slash[8] != '\0' && slash[8] != '?')) {
+    return sendResponse(req, "404 Not Found", "text/plain", "Use /api/peer/<id>/history");
+  }
+
+  size_t id_len = slash - id;
+  int total = getPwngridRunTotalPeers();
+  pwngrid_peer* peers = getPwngridPeers();
+  int peer = -1;
+  char hex[PWN_IDENTITY_HEX_LEN + 1];
+  uint8_t identity[PWN_IDENTITY_LEN];
+  if (strspn(id, "0123456789") == id_len) {
+    peer = atoi(id);
+  } else if (id_len == PWN_IDENTITY_HEX_LEN) {
+    memcpy(hex, id, id_len);
+    hex[id_len] = '\0';
+    if (identityFromHex(hex, identity)) {
+      for (int i = 0; i < total; i++) {
+        if (memcmp(peers[i].identity, identity, PWN_IDENTITY_LEN) == 0) {
+          peer = i;
+          break;
+        }
       }
-      
-      std::unique_ptr<uint8_t[]> buf(new (std::nothrow) uint8_t[needed]);
-      if (!buf) {
-        server.send(500, "text/plain", "Out of memory");
-        break;
+    }
+  }
+  if (peer < 0 || peer >= total) {
+    return sendResponse(req, "404 Not Found", "text/plain", "No such peer");
+  }
+
+  PeerHistoryBucket current;
+  if (getPeerHistory(peer, PEER_HISTORY_1S, &current, 1) == 0) {
+    return sendResponse(req, "404 Not Found", "text/plain", "No history for this peer");
+  }
+
+  httpd_resp_set_type(req, "application/json");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
+  if (!writePeerHistoryJson(peer, sendMetricsChunk, req)) {
+    return ESP_FAIL;
+  }
+  return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+// ========== Bulk export ==========
+// /api/export streams every data file as a tar. The plain tar has a known
+// length and honours single Range requests (with If-Range against the ETag)
+// so downloads can resume. ?gzip=1 compresses on the fly instead, as a
+// chunked response without range support.
+static TarExport tar_export;
+
+static bool sendAll(void* ctx, const uint8_t* data, size_t len) {
+  httpd_req_t* req = (httpd_req_t*)ctx;
+  while (len > 0) {
+    int r = httpd_send(req, (const char*)data, len);
+    if (r <= 0) {
+      return false;
+    }
+    data += r;
+    len -= r;
+  }
+  return true;
+}
+
+static bool sendGzipChunk(void* ctx, const uint8_t* data, size_t len) {
+  return httpd_resp_send_chunk((httpd_req_t*)ctx, (const char*)data, len) == ESP_OK;
+}
+
+static bool writeGzip(void* ctx, const uint8_t* data, size_t len) {
+  return ((GzipStream*)ctx)->write(data, len);
+}
+
+// Parse "bytes=a-b", "bytes=a-" or "bytes=-n" into [from, to)
+static bool parseRange(const char* range, uint32_t size, uint32_t* from, uint32_t* to) {
+  if (strncmp(range, "bytes=", 6) != 0 || strchr(range, ',') != nullptr) {
+    return false;
+  }
+  const char* spec = range + 6;
+  char* end;
+  if (*spec == '-') {
+    if (!isdigit((unsigned char)spec[1])) {
+      return false;
+    }
+    uint32_t n = strtoul(spec + 1, &end, 10);
+    *from = n < size ? size - n : 0;
+    *to = size;
+  } else {
+    if (!isdigit((unsigned char)*spec)) {
+      return false;
+    }
+    *from = strtoul(spec, &end, 10);
+    if (*end != '-') {
+      return false;
+    }
+    if (isdigit((unsigned char)end[1])) {
+      uint32_t last = strtoul(end + 1, &end, 10);
+      if (last < *from) {
+        return false;
       }
+      *to = min(last + 1, size);
+    } else {
+      end++;
+      *to = size;
+    }
+  }
+  return *end == '\0' && *from < *to;
+}
 
-      size_t outLen = 0;
-      rc = mbedtls_base64_decode(buf.get(), needed, &outLen,
-                                 (const unsigned char*)b64.c_str(), b64.length());
-      
-      if (rc != 0) {
-        server.send(500, "text/plain", "Base64 decode error");
-        break;
+static esp_err_t handleExport(httpd_req_t* req) {
+  char arg[8] = "";
+  bool gzip = getQueryArg(req, "gzip", arg, sizeof(arg)) && strcmp(arg, "0") != 0;
+  uint32_t size = tar_export.plan();
+  char etag[12];
+  snprintf(etag, sizeof(etag), "\"%08lx\"", (unsigned long)tar_export.getFingerprint());
+
+  unsigned long start = millis();
+  size_t sent = 0;
+  bool ok;
+
+  if (gzip) {
+    GzipStream gz(sendGzipChunk, req);
+    httpd_resp_set_type(req, "application/gzip");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"gotchi-export.tar.gz\"");
+    if (!gz.begin()) {
+      gz.finish();
+      return sendResponse(req, "500 Internal Server Error", "text/plain", "Out of memory");
+    }
+    ok = tar_export.stream(0, size, writeGzip, &gz) && gz.finish();
+    if (ok) {
+      httpd_resp_send_chunk(req, nullptr, 0);
+    }
+    sent = gz.getOutputSize();
+  } else {
+    uint32_t from = 0;
+    uint32_t to = size;
+    bool partial = false;
+    char range[48];
+    char if_range[16];
+
+    if (httpd_req_get_hdr_value_str(req, "Range", range, sizeof(range)) == ESP_OK &&
+        (httpd_req_get_hdr_value_str(req, "If-Range", if_range, sizeof(if_range)) != ESP_OK ||
+         strcmp(if_range, etag) == 0)) {
+      partial = parseRange(range, size, &from, &to);
+      if (!partial) {
+        char content_range[32];
+        snprintf(content_range, sizeof(content_range), "bytes */%lu", (unsigned long)size);
+        httpd_resp_set_hdr(req, "Content-Range", content_range);
+        return sendResponse(req, "416 Range Not Satisfiable", "text/plain", "");
       }
+    }
 
-      const String fname = "packet_" + idStr + ".hc22000";
-      sendBytesAsFile(fname, buf.get(), outLen);
-      break;
+    // Headers by hand: httpd_resp_* would force chunked encoding
+    char head[320];
+    int len = snprintf(head, sizeof(head),
+                       "HTTP/1.1 %s\r\n"
+                       "Content-Type: application/x-tar\r\n"
+                       "Content-Disposition: attachment; filename=\"gotchi-export.tar\"\r\n"
+                       "Content-Length: %lu\r\n"
+                       "Accept-Ranges: bytes\r\n"
+                       "ETag: %s\r\n",
+                       partial ? "206 Partial Content" : "200 OK", (unsigned long)(to - from), etag);
+    if (partial) {
+      len += snprintf(head + len, sizeof(head) - len, "Content-Range: bytes %lu-%lu/%lu\r\n",
+                      (unsigned long)from, (unsigned long)(to - 1), (unsigned long)size);
+    }
+    len += snprintf(head + len, sizeof(head) - len, "\r\n");
+
+    ok = sendAll(req, (const uint8_t*)head, len) && tar_export.stream(from, to, sendAll, req);
+    sent = to - from;
+  }
+
+  unsigned long elapsed = max(millis() - start, 1UL);
+  Serial.printf("Export: %d files, %lu of %lu bytes%s in %lu ms (%lu KB/s)%s\n",
+                tar_export.getFileCount(), (unsigned long)sent, (unsigned long)size,
+                gzip ? " gzipped" : "", elapsed, (unsigned long)(sent / elapsed), ok ? "" : ", aborted");
+  return ok ? ESP_OK : ESP_FAIL;
+}
+
+// ========== Live events (Server-Sent Events) ==========
+// /api/events keeps its socket open after the headers are written. A timer
+// queues sseFlush() on the server task every SSE_FLUSH_MS, which drains the
+// event bus for each client, coalescing repeated updates (RSSI, counters,
+// channel) so only the latest value goes out. Clients on the same cursor
+// share one formatted batch. Sends never block: a full socket keeps its
+// remainder in the client buffer and gets no new events until it drains,
+// and a client that stays stuck for SSE_STALL_MS is dropped.
+struct SseClient {
+  int fd;  // -1 when the slot is free
+  uint32_t cursor;
+  uint16_t pending_off;
+  uint16_t pending_len;
+  unsigned long last_send;
+  char pending[SSE_CLIENT_BUF];
+};
+
+static SseClient sse_clients[SSE_MAX_CLIENTS];
+static volatile int sse_count = 0;
+static volatile bool sse_flush_queued = false;
+static esp_timer_handle_t sse_timer = nullptr;
+
+static const char* const counter_names[] = {"peers", "pwned", "packets"};
+
+static void sseRemoveClient(int fd) {
+  for (SseClient& c : sse_clients) {
+    if (c.fd == fd) {
+      c.fd = -1;
+      sse_count--;
+      unsubscribeEvents();
+      Serial.printf("SSE: Client %d left, %d streaming\n", fd, sse_count);
     }
+  }
+}
 
-    // Case 2: File path on LittleFS
-    if (doc.containsKey("file")) {
-      String p = doc["file"].as<String>();
-      
-      if (!LittleFS.exists(p)) {
-        server.send(404, "text/plain", "File not found on filesystem");
-        break;
-      }
+// Close hook for every session of the server, it owns closing the socket
+static void onSessionClose(httpd_handle_t hd, int fd) {
+  sseRemoveClient(fd);
+  close(fd);
+}
+
+static void sseDrop(SseClient& c) {
+  int fd = c.fd;
+  sseRemoveClient(fd);
+  httpd_sess_trigger_close(http_server, fd);
+}
+
+// Write without blocking, keeping whatever the socket doesn't take
+static void sseSend(SseClient& c, const char* data, size_t len) {
+  int r = httpd_socket_send(http_server, c.fd, data, len, MSG_DONTWAIT);
+  if (r == HTTPD_SOCK_ERR_TIMEOUT) {
+    r = 0;
+  } else if (r < 0) {
+    sseDrop(c);
+    return;
+  }
+  if (r > 0) {
+    c.last_send = millis();
+  }
+
+  size_t rest = min(len - r, sizeof(c.pending));
+  memcpy(c.pending, data + r, rest);
+  c.pending_off = 0;
+  c.pending_len = rest;
+}
 
-      File pf = LittleFS.open(p, FILE_READ);
-      if (!pf) {
-        server.send(500, "text/plain", "Cannot open file");
+static void sseDrain(SseClient& c) {
+  int r = httpd_socket_send(http_server, c.fd, c.pending + c.pending_off,
+                            c.pending_len - c.pending_off, MSG_DONTWAIT);
+  if (r == HTTPD_SOCK_ERR_TIMEOUT) {
+    return;
+  } else if (r < 0) {
+    sseDrop(c);
+    return;
+  }
+  c.pending_off += r;
+  c.last_send = millis();
+  if (c.pending_off >= c.pending_len) {
+    c.pending_off = c.pending_len = 0;
+  }
+}
+
+static bool supersededLater(const BusEvent* ev, int i, int n) {
+  if (ev[i].type == EVENT_PEER_SEEN || ev[i].type == EVENT_PEER_GONE) {
+    return false;
+  }
+  for (int j = i + 1; j < n; j++) {
+    if (ev[j].type == ev[i].type && ev[j].key == ev[i].key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Format events into SSE frames, returns how many events were consumed
+static int formatEvents(const BusEvent* ev, int n, bool resync, char* out, size_t cap, size_t* out_len) {
+  pwngrid_peer* peers = getPwngridPeers();
+  char name[40];
+  char frame[128];
+  size_t len = 0;
+  int i = 0;
+
+  if (resync) {
+    len = snprintf(out, cap, "event: resync\ndata: {}\n\n");
+  }
+
+  for (; i < n; i++) {
+    if (supersededLater(ev, i, n)) {
+      continue;
+    }
+
+    int f = 0;
+    switch (ev[i].type) {
+      case EVENT_PEER_SEEN:
+      case EVENT_PEER_GONE:
+        appendJsonString(name, sizeof(name), peers[ev[i].key].name);
+        f = snprintf(frame, sizeof(frame), "event: %s\ndata: {\"i\":%u,\"name\":\"%s\",\"rssi\":%ld}\n\n",
+                     ev[i].type == EVENT_PEER_SEEN ? "seen" : "gone", ev[i].key, name, (long)ev[i].value);
+        break;
+      case EVENT_PEER_RSSI:
+        f = snprintf(frame, sizeof(frame), "event: rssi\ndata: {\"i\":%u,\"rssi\":%ld}\n\n",
+                     ev[i].key, (long)ev[i].value);
+        break;
+      case EVENT_COUNTER:
+        if (ev[i].key < sizeof(counter_names) / sizeof(counter_names[0])) {
+          f = snprintf(frame, sizeof(frame), "event: counter\ndata: {\"k\":\"%s\",\"v\":%ld}\n\n",
+                       counter_names[ev[i].key], (long)ev[i].value);
+        }
+        break;
+      case EVENT_CHANNEL:
+        f = snprintf(frame, sizeof(frame), "event: channel\ndata: {\"ch\":%ld}\n\n", (long)ev[i].value);
         break;
+    }
+
+    if (len + f > cap) {
+      break;
+    }
+    memcpy(out + len, frame, f);
+    len += f;
+  }
+
+  *out_len = len;
+  return i;
+}
+
+static void sseFlush(void* arg) {
+  static BusEvent batch[EVENT_RING_SIZE];
+  static char out[SSE_CLIENT_BUF];
+  size_t out_len = 0;
+  uint32_t out_from = 0;
+  uint32_t out_to = 0;
+  bool cached = false;
+  unsigned long now = millis();
+
+  sse_flush_queued = false;
+
+  for (SseClient& c : sse_clients) {
+    if (c.fd < 0) {
+      continue;
+    }
+
+    if (c.pending_len > 0) {
+      sseDrain(c);
+      if (c.fd >= 0 && c.pending_len > 0 && now - c.last_send > SSE_STALL_MS) {
+        Serial.printf("SSE: Client %d stalled, dropping it\n", c.fd);
+        sseDrop(c);
       }
+      continue;
+    }
 
-      WiFiClient client = server.client();
-      const String fname = p.endsWith(".hc22000") ? 
-                          p.substring(p.lastIndexOf('/') + 1) : 
-                          "packet_" + idStr + ".hc22000";
-      
-      String hdr = "HTTP/1.1 200 OK\r\n";
-      hdr += "Content-Type: application/octet-stream\r\n";
-      hdr += "Content-Disposition: attachment; filename=\"" + fname + "\"\r\n";
-      hdr += "Content-Length: " + String(pf.size()) + "\r\n";
-      hdr += "Connection: close\r\n\r\n";
-      client.print(hdr);
-
-      uint8_t buf[512];
-      while (pf.available()) {
-        size_t r = pf.read(buf, sizeof(buf));
-        if (!r) break;
-        client.write(buf, r);
+    if (!cached || c.cursor != out_from) {
+      uint32_t cursor = c.cursor;
+      int n = readEvents(&cursor, batch, EVENT_RING_SIZE);
+      bool resync = n < 0;
+      if (resync) {
+        n = readEvents(&cursor, batch, EVENT_RING_SIZE);
       }
-      pf.close();
-      break;
+      int used = formatEvents(batch, n, resync, out, sizeof(out), &out_len);
+      out_from = c.cursor;
+      out_to = used < n ? batch[used].seq : cursor;
+      cached = true;
     }
 
-    server.send(415, "text/plain", "No hc22000 content in record");
-    break;
+    c.cursor = out_to;
+    if (out_len > 0) {
+      sseSend(c, out, out_len);
+    } else if (now - c.last_send > SSE_KEEPALIVE_MS) {
+      sseSend(c, ":\n\n", 3);
+    }
   }
+}
 
-  f.close();
-  
-  if (!found && server.client().connected()) {
-    server.send(404, "text/plain", "Packet ID not found");
+static void sseTick(void* arg) {
+  if (http_server != nullptr && sse_count > 0 && !sse_flush_queued) {
+    sse_flush_queued = true;
+    if (httpd_queue_work(http_server, sseFlush, nullptr) != ESP_OK) {
+      sse_flush_queued = false;
+    }
   }
 }
 
-static void handleFriendsPage() {
-  String html = String(HTML_LIST_TPL);
-  html.replace("%TITLE%", "Friends");
-  server.send(200, "text/html", html);
-}
+static esp_err_t handleEvents(httpd_req_t* req) {
+  SseClient* c = nullptr;
+  for (SseClient& slot : sse_clients) {
+    if (slot.fd < 0) {
+      c = &slot;
+      break;
+    }
+  }
+  if (c == nullptr) {
+    return sendResponse(req, "503 Service Unavailable", "text/plain", "Too many event streams");
+  }
 
-static void handlePacketsPage() {
-  String html = String(HTML_LIST_TPL);
-  html.replace("%TITLE%", "Packets");
-  server.send(200, "text/html", html);
+  char hello[256];
+  int len = snprintf(hello, sizeof(hello),
+                     "HTTP/1.1 200 OK\r\n"
+                     "Content-Type: text/event-stream\r\n"
+                     "Cache-Control: no-cache\r\n"
+                     "Connection: keep-alive\r\n\r\n"
+                     "retry: 3000\n"
+                     "event: hello\ndata: {\"ch\":%d,\"peers\":%u,\"pwned\":%u}\n\n",
+                     wifi_get_channel(), (unsigned)getPwngridRunTotalPeers(), (unsigned)getPwngridRunPwned());
+  if (httpd_send(req, hello, len) != len) {
+    return ESP_FAIL;
+  }
+
+  // The response is never finished, the session stays open for sseFlush()
+  subscribeEvents();
+  c->fd = httpd_req_to_sockfd(req);
+  c->cursor = getEventSeq();
+  c->pending_off = c->pending_len = 0;
+  c->last_send = millis();
+  sse_count++;
+  Serial.printf("SSE: Client %d joined, %d streaming\n", c->fd, sse_count);
+  return ESP_OK;
 }
 
-static void handleApiFriends() {
-  server.send(200, "application/json", ndjsonToJsonArray(FR_TBL));
+static const httpd_uri_t ap_routes[] = {
+  { "/",                    HTTP_GET,  handleRoot,           nullptr },
+  { "/friends",             HTTP_GET,  handleListPage,       nullptr },
+  { "/packets",             HTTP_GET,  handleListPage,       nullptr },
+  { "/api/config",          HTTP_GET,  handleGetConfig,      nullptr },
+  { "/api/save",            HTTP_POST, handleSaveConfig,     nullptr },
+  { "/api/reset",           HTTP_POST, handleResetConfig,    nullptr },
+  { "/api/friends",         HTTP_GET,  handleApiFriends,     nullptr },
+  { "/api/packets",         HTTP_GET,  handleApiPackets,     nullptr },
+  { "/api/packet/download", HTTP_GET,  handleDownloadPacket, nullptr },
+  { "/api/events",          HTTP_GET,  handleEvents,         nullptr },
+  { "/api/export",          HTTP_GET,  handleExport,         nullptr },
+  { "/api/metrics",         HTTP_GET,  handleMetrics,        nullptr },
+  { "/api/trace",           HTTP_GET,  handleTrace,          nullptr },
+  { "/api/peer/*",          HTTP_GET,  handlePeerHistory,    nullptr },
+};
+
+#if AP_HTTPD_MAX_SOCKETS < SSE_MAX_CLIENTS + SSE_BROWSER_CONNECTIONS
+#error "AP_HTTPD_MAX_SOCKETS leaves event streams open to LRU purging, see SSE_MAX_CLIENTS"
+#endif
+#if defined(CONFIG_LWIP_MAX_SOCKETS) && AP_HTTPD_MAX_SOCKETS > CONFIG_LWIP_MAX_SOCKETS - 3
+#error "AP_HTTPD_MAX_SOCKETS exceeds what lwIP leaves to the HTTP server"
+#endif
+
+// The portal runs on esp_http_server: its own task, multiplexing all open
+// connections (keep-alive included), so nothing depends on loop() anymore.
+static bool startHttpServer() {
+  httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+  config.server_port = 80;
+  config.stack_size = task_placement[TASK_HTTPD].stack;
+  config.core_id = getTaskCore(TASK_HTTPD);
+  config.task_priority = task_placement[TASK_HTTPD].priority;
+  config.max_open_sockets = AP_HTTPD_MAX_SOCKETS;
+  config.max_uri_handlers = sizeof(ap_routes) / sizeof(ap_routes[0]);
+  config.uri_match_fn = httpd_uri_match_wildcard;  // For /api/peer/<id>/history
+  config.lru_purge_enable = true;  // New clients evict the oldest idle connection, see SSE_MAX_CLIENTS
+  config.close_fn = onSessionClose;
+
+  for (SseClient& c : sse_clients) {
+    c.fd = -1;
+  }
+  sse_count = 0;
+  sse_flush_queued = false;
+
+  esp_err_t err = httpd_start(&http_server, &config);
+  if (err != ESP_OK) {
+    Serial.printf("HTTP server start error: %s\n", esp_err_to_name(err));
+    http_server = nullptr;
+    return false;
+  }
+  for (const httpd_uri_t& route : ap_routes) {
+    httpd_register_uri_handler(http_server, &route);
+  }
+
+  const esp_timer_create_args_t timer_args = {
+    .callback = sseTick,
+    .arg = nullptr,
+    .dispatch_method = ESP_TIMER_TASK,
+    .name = "sse",
+  };
+  if (esp_timer_create(&timer_args, &sse_timer) == ESP_OK) {
+    esp_timer_start_periodic(sse_timer, SSE_FLUSH_MS * 1000ULL);
+  }
+  return true;
 }
 
-static void handleApiPackets() {
-  server.send(200, "application/json", ndjsonToJsonArray(PK_TBL));
+static void stopHttpServer() {
+  if (sse_timer != nullptr) {
+    esp_timer_stop(sse_timer);
+    esp_timer_delete(sse_timer);
+    sse_timer = nullptr;
+  }
+  if (http_server != nullptr) {
+    httpd_stop(http_server);
+    http_server = nullptr;
+  }
 }
 
 void initAPConfig() {
-  server.on("/", handleRoot);
-  server.on("/friends", HTTP_GET, handleFriendsPage);
-  server.on("/packets", HTTP_GET, handlePacketsPage);
-  server.on("/api/config", HTTP_GET, handleGetConfig);
-  server.on("/api/save", HTTP_POST, handleSaveConfig);
-  server.on("/api/reset", HTTP_POST, handleResetConfig);
-  server.on("/api/friends", HTTP_GET, handleApiFriends);
-  server.on("/api/packets", HTTP_GET, handleApiPackets);
-  server.on("/api/packet/download", HTTP_GET, handleDownloadPacket);
+  // Routes are registered on the server when the portal starts, see ap_routes
+  Serial.printf("AP config: %u routes\n", sizeof(ap_routes) / sizeof(ap_routes[0]));
 }
 
 static bool saneApCreds(const char* ssid, const char* pass) {
@@ -1115,6 +917,9 @@ static bool saneApCreds(const char* ssid, const char* pass) {
   return true;
 }
 
+// The portal shares the radio with the capture pipeline: the driver stays in
+// APSTA mode, the hidden beacon AP is reconfigured into the portal AP on the
+// current channel and the sniffer is pinned there until the portal closes.
 void startAPMode() {
   Serial.println("=== Starting AP Mode ===");
   if (ap_mode_active) {
@@ -1122,15 +927,6 @@ void startAPMode() {
     return;
   }
 
-  // Stop all WiFi activities
-  Serial.println("Stopping promiscuous mode and station mode...");
-  esp_wifi_set_promiscuous(false);
-  WiFi.persistent(false);
-  WiFi.disconnect(true, true);
-  delay(100);
-  WiFi.mode(WIFI_OFF);
-  delay(100);
-
   Serial.printf("Free heap before AP: %u bytes\n", ESP.getFreeHeap());
 
   if (!saneApCreds(AP_SSID, AP_PASSWORD)) {
@@ -1138,14 +934,15 @@ void startAPMode() {
     return;
   }
 
-  WiFi.mode(WIFI_AP);
-  delay(100);
-
-  Serial.println("Starting Soft Access Point...");
-  const int channel = 1;
+  const int channel = wifi_get_channel();
   const bool hidden = false;
   const int max_conn = 4;
+  lockPwnChannel(channel);
 
+  WiFi.persistent(false);
+  WiFi.mode(WIFI_AP_STA);
+
+  Serial.printf("Starting Soft Access Point on channel %d...\n", channel);
   bool ap_success = WiFi.softAP(AP_SSID, AP_PASSWORD, channel, hidden, max_conn);
 
   if (!ap_success) {
@@ -1165,30 +962,33 @@ void startAPMode() {
     cfg.ap.channel = channel;
     cfg.ap.max_connection = max_conn;
 
-    esp_err_t e;
-    e = esp_wifi_set_mode(WIFI_MODE_AP);
-    if (e) Serial.printf("esp_wifi_set_mode error: %s\n", esp_err_to_name(e));
-    
-    e = esp_wifi_set_config(WIFI_IF_AP, &cfg);
-    if (e) Serial.printf("esp_wifi_set_config error: %s\n", esp_err_to_name(e));
-    
-    e = esp_wifi_start();
+    esp_err_t e = esp_wifi_set_config(WIFI_IF_AP, &cfg);
     if (e) {
-      Serial.printf("esp_wifi_start error: %s\n", esp_err_to_name(e));
+      Serial.printf("esp_wifi_set_config error: %s\n", esp_err_to_name(e));
       Serial.println("ERROR: Failed to start AP mode!");
+      resetPwnAP();
+      unlockPwnChannel();
       return;
     }
     
     Serial.println("SoftAP started via native API");
   }
 
+  // Mode changes can drop promiscuous mode, make sure capture keeps going
+  resumePwnSniffer();
+
   IPAddress IP = WiFi.softAPIP();
   Serial.print("AP IP address: ");
   Serial.println(IP);
   Serial.printf("SSID: %s\n", AP_SSID);
   Serial.printf("Connect and navigate to: http://%s\n", IP.toString().c_str());
 
-  server.begin();
+  if (!startHttpServer()) {
+    Serial.println("ERROR: Failed to start the config portal!");
+    resetPwnAP();
+    unlockPwnChannel();
+    return;
+  }
   ap_mode_active = true;
   ap_start_time = millis();
   
@@ -1199,10 +999,10 @@ void stopAPMode() {
   if (!ap_mode_active) return;
   
   Serial.println("=== Stopping AP Mode ===");
-  server.stop();
-  WiFi.softAPdisconnect(true);
-  WiFi.mode(WIFI_OFF);
-  delay(100);
+  stopHttpServer();
+  esp_wifi_deauth_sta(0);  // Kick every portal client
+  resetPwnAP();
+  unlockPwnChannel();
   
   ap_mode_active = false;
   Serial.println("AP Mode stopped");
@@ -1211,8 +1011,7 @@ void stopAPMode() {
 void handleAPConfig() {
   if (!ap_mode_active) return;
   
-  server.handleClient();
-  
+  // Requests are served by the HTTP server task, only the timeout is handled here
   // Auto-timeout
   if (millis() - ap_start_time > AP_TIMEOUT_MS) {
     Serial.println("AP timeout reached, stopping...");
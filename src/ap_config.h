@@ -6,26 +6,39 @@
 #include "M5Unified.h"
 #include "WiFi.h"
 #include "esp_wifi.h"
-#include "WebServer.h"
 #include "LittleFS.h"
 #include "mbedtls/base64.h"   // per decodificare base64 (ESP-IDF)
 #include "config.h"
 
 using namespace std;
 
-#ifndef FR_TBL
-#define FR_TBL "/friends.ndjson"
-#endif
-
-#ifndef PK_TBL
-#define PK_TBL "/packets.ndjson"
-#endif
-
 // AP Configuration
 #define AP_SSID "Gotchi"
 #define AP_PASSWORD "GotchiPass"
 #define AP_TIMEOUT_MS 300000  // 5 minutes
 
+// Config portal HTTP server connections (task placement is in task_config.h).
+// The server task itself needs 3 of lwIP's sockets, 16 in the Arduino core.
+#ifndef AP_HTTPD_MAX_SOCKETS
+#define AP_HTTPD_MAX_SOCKETS 13
+#endif
+
+// Live event streams (/api/events). When every connection is in use a new
+// one evicts the least recently used, and esp_http_server only counts a
+// request as use, so the streams always go first. The socket limit keeps room
+// for SSE_MAX_CLIENTS streams plus SSE_BROWSER_CONNECTIONS, what one browser
+// opens in parallel to the portal; a stream is only purged beyond that.
+#ifndef SSE_MAX_CLIENTS
+#define SSE_MAX_CLIENTS 4
+#endif
+#define SSE_BROWSER_CONNECTIONS 6
+#ifndef SSE_FLUSH_MS
+#define SSE_FLUSH_MS 250         // Events are batched and coalesced over this period
+#endif
+#define SSE_CLIENT_BUF 768       // Unsent bytes held per client while its socket is full
+#define SSE_KEEPALIVE_MS 15000
+#define SSE_STALL_MS 10000       // Drop clients that accept nothing for this long
+
 void initAPConfig();
 void startAPMode();
 void stopAPMode();
@@ -0,0 +1,232 @@
+// Microbenchmark cases, see microbench.h. Setup goes before the timed loop
+// and is not measured; inputs are fixed so results compare across commits.
+#include "microbench.h"
+
+#if MICROBENCH
+
+#include "ai.h"
+#include "db.h"
+#include "GPSAnalyse.h"
+#include "identity.h"
+#include "pwn.h"
+#include "string_pool.h"
+#if defined(ESP_PLATFORM)
+#include "menu_system.h"
+#endif
+
+// Same shape as the affinity benchmark's: beacon header, fixed fields, then
+// SSID, rates, DS channel and RSN elements
+static const uint8_t bench_ap_beacon[] = {
+  0x80, 0x00, 0x00, 0x00,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x00, 0x1a, 0x2b, 0x3c, 0x4d, 0x5e,
+  0x00, 0x1a, 0x2b, 0x3c, 0x4d, 0x5e,
+  0x40, 0x12,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x64, 0x00, 0x31, 0x04,
+  0x00, 0x0a, 'C', 'o', 'f', 'f', 'e', 'e', 'S', 'h', 'o', 'p',
+  0x01, 0x08, 0x82, 0x84, 0x8b, 0x96, 0x0c, 0x12, 0x18, 0x24,
+  0x03, 0x01, 0x06,
+  0x30, 0x14, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04,
+  0x01, 0x00, 0x00, 0x0f, 0xac, 0x02, 0x00, 0x00,
+};
+
+static const char bench_nmea[] =
+  "$GNRMC,083559.00,A,4717.11437,N,00833.91522,E,0.004,77.52,091202,,,A*57\r\n"
+  "$GNGSA,A,3,23,29,07,08,09,18,26,,,,,,1.94,1.18,1.54*0D\r\n"
+  "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*74\r\n"
+  "$GPGSV,3,2,11,14,25,170,00,16,57,208,39,18,67,296,40,19,40,246,00*74\r\n"
+  "$GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,,,,*4D\r\n";
+
+static uint8_t bench_frame[sizeof(wifi_promiscuous_pkt_t) + PWNGRID_BEACON_MAX];
+
+// ========== Sniffer ==========
+static void benchExtractSSIDfromAP(BenchState& state) {
+  for (auto _ : state) {
+    benchKeep(extractSSIDfromAP(bench_ap_beacon, sizeof(bench_ap_beacon)));
+  }
+  state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(benchExtractSSIDfromAP);
+
+static void benchBuildPwngridBeacon(BenchState& state) {
+  ensurePwnIdentity(true);
+  uint8_t frame[PWNGRID_BEACON_MAX];
+  size_t len = 0;
+  for (auto _ : state) {
+    len = buildPwngridBeacon("(^_^)", frame, sizeof(frame));
+    benchKeep(frame);
+  }
+  if (len == 0) {
+    state.skipWithError("beacon over PWNGRID_BEACON_MAX");
+    return;
+  }
+  state.setBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(benchBuildPwngridBeacon);
+
+// A peer already in the table, the steady state while friends are around
+static void benchProcessPwngridBeacon(BenchState& state) {
+  wifi_promiscuous_pkt_t* pkt = (wifi_promiscuous_pkt_t*)bench_frame;
+  ensurePwnIdentity(true);
+  size_t len = buildPwngridBeacon("(o_o)", pkt->payload, PWNGRID_BEACON_MAX);
+  if (len == 0) {
+    state.skipWithError("beacon over PWNGRID_BEACON_MAX");
+    return;
+  }
+  memset(&pkt->rx_ctrl, 0, sizeof(pkt->rx_ctrl));
+  pkt->rx_ctrl.rssi = -55;
+  pkt->rx_ctrl.channel = 6;
+  pkt->rx_ctrl.sig_len = len + 4;  // FCS
+  processPwngridBeacon(pkt);
+
+  for (auto _ : state) {
+    processPwngridBeacon(pkt);
+  }
+  state.setItemsProcessed(state.iterations());
+  state.setBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(benchProcessPwngridBeacon);
+
+// ========== Database ==========
+static pwngrid_peer benchPeer(int n) {
+  pwngrid_peer peer = {};
+  memcpy(peer.identity + PWN_IDENTITY_LEN - sizeof(n), &n, sizeof(n));
+  peer.name = "bench" + String(n);
+  peer.face = internStaticString("(o_o)");
+  peer.grid_version = internStaticString(GRID_VERSION);
+  peer.version = internStaticString("bench");
+  strlcpy(peer.session_id, "02:00:00:00:00:01", sizeof(peer.session_id));
+  peer.rssi = -60;
+  peer.channel = 6;
+  return peer;
+}
+
+// Rewrites a friend in a table of at least arg records
+static void benchMergeFriend(BenchState& state) {
+  for (int n = countFriends(); n < state.arg(); n++) {
+    addFriend(benchPeer(n));
+  }
+  pwngrid_peer peer = benchPeer(0);
+  uint64_t friends_tot = 0;
+  for (auto _ : state) {
+    peer.pwnd_tot++;
+    benchKeep(mergeFriend(peer, friends_tot));
+  }
+  state.setItemsProcessed(state.iterations());
+}
+BENCHMARK_ARG(benchMergeFriend, 64);
+
+static void benchAddPacket(BenchState& state) {
+  static packet_item_t packet;
+  memset(&packet, 0, sizeof(packet));
+  memcpy(packet.data, bench_ap_beacon, sizeof(bench_ap_beacon));
+  packet.len = sizeof(bench_ap_beacon);
+  packet.channel = 6;
+  strcpy(packet.bssid, "00:1a:2b:3c:4d:5e");
+  strcpy(packet.type, "BENCH");
+  for (auto _ : state) {
+    packet.ts_ms++;
+    benchKeep(addPacket(packet));
+  }
+  state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(benchAddPacket);
+
+// One page of /api/friends: records through the index into a JSON array,
+// as streamNdjsonPage() does
+static void benchNdjsonPage(BenchState& state) {
+  static volatile uint32_t revision = 0;
+  static NdjsonTable table(FR_TBL, &revision);
+  static char line[1024];
+  static char out[1436];
+  table.begin();
+  int total = table.count();
+  if (total == 0) {
+    table.end();
+    state.skipWithError("no friends table");
+    return;
+  }
+  int offset = 0;
+  uint64_t bytes = 0;
+  for (auto _ : state) {
+    size_t out_len = 0;
+    out[out_len++] = '[';
+    for (int i = offset; i < offset + state.arg() && i < total; i++) {
+      if (!table.readLine(i, line, sizeof(line))) continue;
+      size_t n = strlen(line);
+      if (out_len + n + 2 > sizeof(out)) {
+        bytes += out_len;  // A chunk sent
+        out_len = 0;
+      }
+      if (i != offset) out[out_len++] = ',';
+      memcpy(out + out_len, line, n);
+      out_len += n;
+    }
+    out[out_len++] = ']';
+    bytes += out_len;
+    benchKeep(out);
+    offset = offset + state.arg() < total ? offset + state.arg() : 0;
+  }
+  table.end();
+  state.setItemsProcessed(state.iterations() * state.arg());
+  state.setBytesProcessed(bytes);
+}
+BENCHMARK_ARG(benchNdjsonPage, 20);
+
+// ========== GPS ==========
+static void benchGpsParse(BenchState& state) {
+  static GPSAnalyse gps;  // No reader task, feed() parses in place
+  for (auto _ : state) {
+    gps.feed(bench_nmea);
+  }
+  benchKeep(gps.s_GNRMC.Latitude);
+  state.setItemsProcessed(state.iterations() * 5);
+  state.setBytesProcessed(state.iterations() * (sizeof(bench_nmea) - 1));
+}
+BENCHMARK(benchGpsParse);
+
+// ========== Brain ==========
+static void benchQLearningStep(BenchState& state) {
+  static float q[312 * 5];
+  memset(q, 0, sizeof(q));
+  State s = {6, 2, 0, 1, 0};
+  for (auto _ : state) {
+    State next = {(s.channel + 5) % 13, (s.ap_density + 1) % 3, s.recent_success ^ 1,
+                  s.time_bucket, 0};
+    qLearningStep(q, 5, s.toIndex(), s.channel % 5, next.toIndex(), 0.5f, 0.1f, 0.9f);
+    s = next;
+  }
+  benchKeep(q);
+  state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(benchQLearningStep);
+
+// ========== UI ==========
+#if defined(ESP_PLATFORM)
+// Redraw of a full menu into its own sprite, nothing is pushed to the display
+static void benchMenuDraw(BenchState& state) {
+  static M5Canvas canvas(&M5.Display);
+  if (!canvas.createSprite(M5.Display.width(), M5.Display.height() / 2 + 32)) {
+    state.skipWithError("no memory for the sprite");
+    return;
+  }
+  MenuSystem* menu = new MenuSystem(&canvas);
+  menu->setTitle("Bench");
+  for (int i = 0; i < state.arg(); i++) {
+    menu->addItem("Item " + String(i), []() {});
+  }
+  menu->addBackItem([]() {});
+  int n = 0;
+  for (auto _ : state) {
+    menu->setCurrentIndex(n++ % state.arg());
+    menu->draw();
+  }
+  delete menu;
+  canvas.deleteSprite();
+  state.setItemsProcessed(state.iterations());
+}
+BENCHMARK_ARG(benchMenuDraw, 20);
+#endif
+
+#endif
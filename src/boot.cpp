@@ -0,0 +1,195 @@
+#include "boot.h"
+#include "freertos/event_groups.h"
+#include "tracer.h"
+
+// Event groups carry 24 usable bits
+static_assert(BOOT_MAX_STAGES <= 24, "BOOT_MAX_STAGES must fit in an event group");
+
+struct BootTiming {
+  int64_t start_us;
+  int64_t end_us;
+  int8_t core;
+};
+
+static const BootStage* boot_stages = nullptr;
+static uint8_t boot_count = 0;
+static uint32_t boot_claimed = 0;
+static bool boot_reported = false;
+static portMUX_TYPE boot_mux = portMUX_INITIALIZER_UNLOCKED;
+static EventGroupHandle_t boot_done = nullptr;
+static BootTiming boot_timing[BOOT_MAX_STAGES];
+static int64_t boot_start_us = 0;
+static int64_t boot_main_done_us = 0;
+
+static uint32_t allStages() {
+  return BOOT_DEP(boot_count) - 1;
+}
+
+static uint32_t doneStages() {
+  return xEventGroupGetBits(boot_done) & allStages();
+}
+
+static uint32_t mainStages() {
+  uint32_t mask = 0;
+  for (uint8_t i = 0; i < boot_count; i++) {
+    if (boot_stages[i].flags & (BOOT_MAIN | BOOT_WAIT)) {
+      mask |= BOOT_DEP(i);
+    }
+  }
+  return mask;
+}
+
+// Next unclaimed stage whose dependencies are done, -1 if none is ready.
+// Foreground stages go first; the calling task also helps with them but
+// never picks up background work.
+static int claimStage(bool on_main) {
+  uint32_t done = doneStages();
+  int found = -1;
+  portENTER_CRITICAL(&boot_mux);
+  for (uint8_t pass = 0; pass < 2 && found < 0; pass++) {
+    for (uint8_t i = 0; i < boot_count; i++) {
+      const BootStage& s = boot_stages[i];
+      bool foreground = s.flags & (BOOT_MAIN | BOOT_WAIT);
+      if (boot_claimed & BOOT_DEP(i)) continue;
+      if ((s.deps & done) != s.deps) continue;
+      if (!on_main && (s.flags & BOOT_MAIN)) continue;
+      if (pass == 0 ? !foreground : on_main) continue;
+      boot_claimed |= BOOT_DEP(i);
+      found = i;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&boot_mux);
+  return found;
+}
+
+static bool workersHaveStagesLeft() {
+  uint32_t left = 0;
+  portENTER_CRITICAL(&boot_mux);
+  for (uint8_t i = 0; i < boot_count; i++) {
+    if (!(boot_stages[i].flags & BOOT_MAIN) && !(boot_claimed & BOOT_DEP(i))) {
+      left |= BOOT_DEP(i);
+    }
+  }
+  portEXIT_CRITICAL(&boot_mux);
+  return left != 0;
+}
+
+// Blocks until one more stage completes
+static void waitProgress() {
+  uint32_t pending = allStages() & ~doneStages();
+  if (pending) {
+    xEventGroupWaitBits(boot_done, pending, pdFALSE, pdFALSE, portMAX_DELAY);
+  }
+}
+
+static void printBootReport() {
+  Serial.println("Boot: stage     core  start    end   took (ms)");
+  for (uint8_t i = 0; i < boot_count; i++) {
+    const BootTiming& t = boot_timing[i];
+    Serial.printf("  %-12s %4d %6u %6u %6u%s\n", boot_stages[i].name, t.core,
+                  (unsigned)((t.start_us - boot_start_us) / 1000),
+                  (unsigned)((t.end_us - boot_start_us) / 1000),
+                  (unsigned)((t.end_us - t.start_us) / 1000),
+                  (boot_stages[i].flags & (BOOT_MAIN | BOOT_WAIT)) ? "" : " bg");
+  }
+  int64_t end_us = boot_start_us;
+  for (uint8_t i = 0; i < boot_count; i++) {
+    if (boot_timing[i].end_us > end_us) end_us = boot_timing[i].end_us;
+  }
+  Serial.printf("Boot: setup done at %u ms, all stages at %u ms (%u ms since reset)\n",
+                (unsigned)((boot_main_done_us - boot_start_us) / 1000),
+                (unsigned)((end_us - boot_start_us) / 1000), (unsigned)(end_us / 1000));
+}
+
+// Whoever completes the last stage, or returns from bootRun() after it, prints
+static bool maybeReport() {
+  uint32_t done = doneStages();
+  bool report = false;
+  portENTER_CRITICAL(&boot_mux);
+  if (!boot_reported && boot_main_done_us != 0 && done == allStages()) {
+    boot_reported = report = true;
+  }
+  portEXIT_CRITICAL(&boot_mux);
+  if (report) {
+    printBootReport();
+  }
+  return report;
+}
+
+static void runStage(uint8_t i) {
+  BootTiming& t = boot_timing[i];
+  t.core = xPortGetCoreID();
+  t.start_us = esp_timer_get_time();
+  TRACE_BEGIN(boot_stages[i].name);
+  boot_stages[i].fn();
+  TRACE_END(boot_stages[i].name);
+  t.end_us = esp_timer_get_time();
+  xEventGroupSetBits(boot_done, BOOT_DEP(i));
+  maybeReport();
+}
+
+static void bootWorker(void* pv) {
+  while (workersHaveStagesLeft()) {
+    int i = claimStage(false);
+    if (i >= 0) {
+      runStage(i);
+    } else {
+      waitProgress();
+    }
+  }
+  vTaskDelete(NULL);
+}
+
+bool bootRun(const BootStage* stages, uint8_t count) {
+  if (count == 0 || count > BOOT_MAX_STAGES) {
+    Serial.printf("Boot: %u stages, at most %u supported\n", count, BOOT_MAX_STAGES);
+    return false;
+  }
+  // Only earlier stages can be depended on, which rules out cycles
+  for (uint8_t i = 0; i < count; i++) {
+    if (stages[i].deps & ~(BOOT_DEP(i) - 1)) {
+      Serial.printf("Boot: Stage %s depends on a later stage\n", stages[i].name);
+      return false;
+    }
+  }
+
+  boot_stages = stages;
+  boot_count = count;
+  boot_done = xEventGroupCreate();
+  boot_start_us = esp_timer_get_time();
+
+#if CONFIG_FREERTOS_UNICORE
+  xTaskCreate(bootWorker, "boot", BOOT_WORKER_STACK, NULL, BOOT_WORKER_PRIORITY, NULL);
+#else
+  xTaskCreatePinnedToCore(bootWorker, "boot0", BOOT_WORKER_STACK, NULL, BOOT_WORKER_PRIORITY, NULL, 0);
+  xTaskCreatePinnedToCore(bootWorker, "boot1", BOOT_WORKER_STACK, NULL, BOOT_WORKER_PRIORITY, NULL, 1);
+#endif
+
+  uint32_t wait_for = mainStages();
+  while ((doneStages() & wait_for) != wait_for) {
+    int i = claimStage(true);
+    if (i >= 0) {
+      runStage(i);
+    } else {
+      waitProgress();
+    }
+  }
+
+  portENTER_CRITICAL(&boot_mux);
+  boot_main_done_us = esp_timer_get_time();
+  portEXIT_CRITICAL(&boot_mux);
+  if (!maybeReport()) {
+    Serial.printf("Boot: setup done in %u ms, finishing in the background\n",
+                  (unsigned)((boot_main_done_us - boot_start_us) / 1000));
+  }
+  return true;
+}
+
+bool isBootStageDone(uint8_t stage) {
+  return boot_done != nullptr && (xEventGroupGetBits(boot_done) & BOOT_DEP(stage)) != 0;
+}
+
+bool isBootComplete() {
+  return boot_done != nullptr && doneStages() == allStages();
+}
@@ -0,0 +1,48 @@
+#ifndef _BOOT_H_
+#define _BOOT_H_
+
+#include "Arduino.h"
+
+// Boot pipeline. Init steps are declared as stages with dependencies and
+// bootRun() starts each one as soon as everything it depends on is done,
+// spread over one worker task per core. BOOT_MAIN stages run on the task
+// calling bootRun() (the Arduino loop task), BOOT_WAIT stages are done by
+// the time it returns, and the rest keep going in the background. A
+// per-stage timing report is printed once the last stage finishes.
+
+#ifndef BOOT_SERIAL_WAIT_MS
+#define BOOT_SERIAL_WAIT_MS 0  // Delay before the first log line, for USB serial monitors
+#endif
+#ifndef BOOT_MAX_STAGES
+#define BOOT_MAX_STAGES 16
+#endif
+#ifndef BOOT_WORKER_STACK
+#define BOOT_WORKER_STACK 8192  // Enough for the first boot RSA key generation
+#endif
+#ifndef BOOT_WORKER_PRIORITY
+#define BOOT_WORKER_PRIORITY 1
+#endif
+
+#define BOOT_DEP(stage) (1UL << (stage))
+
+enum BootFlags : uint8_t {
+  BOOT_BACKGROUND = 0,
+  BOOT_WAIT = 1 << 0,  // bootRun() returns only once this is done
+  BOOT_MAIN = 1 << 1,  // Runs on the calling task, implies BOOT_WAIT
+};
+
+typedef void (*BootStageFn)();
+
+struct BootStage {
+  const char* name;
+  BootStageFn fn;
+  uint8_t flags;
+  uint32_t deps;  // BOOT_DEP() of earlier stages in the table
+};
+
+// The table must stay valid until the background stages are done
+bool bootRun(const BootStage* stages, uint8_t count);
+bool isBootStageDone(uint8_t stage);
+bool isBootComplete();
+
+#endif
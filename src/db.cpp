@@ -1,11 +1,193 @@
 #include "db.h"
 #include "storage.h"
+#include "logger.h"
+#include "tracer.h"
+#include "identity.h"
+#include "string_pool.h"
+#include "freertos/semphr.h"
 
 const char* FR_TBL = "/friends.ndjson";
 const char* PKT_TBL = "/packets.ndjson";  
 
+// Bumped after every write to the matching table, so readers know when to look again
+static volatile uint32_t friends_revision = 0;
+static volatile uint32_t packets_revision = 0;
+
+// Serializes table writes and index rebuilds across the DB workers, UI and web server
+static SemaphoreHandle_t db_lock = nullptr;
+
+NdjsonTable friendsHistory(FR_TBL, &friends_revision);
+NdjsonTable friendsApiTable(FR_TBL, &friends_revision);
+NdjsonTable packetsApiTable(PKT_TBL, &packets_revision);
+
+static void lockDB() {
+  if (db_lock) xSemaphoreTake(db_lock, portMAX_DELAY);
+}
+
+static void unlockDB() {
+  if (db_lock) xSemaphoreGive(db_lock);
+}
+
+static String indexPath(const char* path) {
+  return String(path) + ".idx";
+}
+
+// Rewrite the sidecar index of `path` from scratch. Caller holds the DB lock.
+static bool rebuildIndex(const char* path) {
+  unsigned long start = millis();
+  String idxPath = indexPath(path);
+  File data = storage.open(path, FILE_READ);
+  File idx = storage.open(idxPath.c_str(), FILE_WRITE);
+  if (!idx) {
+    Serial.printf("DB: Error creating index for %s\n", path);
+    if (data) data.close();
+    return false;
+  }
+
+  // Header is written last, an interrupted rebuild leaves an invalid index
+  uint32_t header[2] = {0, 0};
+  idx.write((const uint8_t*)header, sizeof(header));
+
+  uint32_t size = 0;
+  uint32_t records = 0;
+  if (data) {
+    uint8_t buf[256];
+    uint32_t offsets[32];
+    uint8_t pending = 0;
+    bool atLineStart = true;
+    size = data.size();
+
+    uint32_t offset = 0;
+    size_t n;
+    while ((n = data.read(buf, sizeof(buf))) > 0) {
+      for (size_t i = 0; i < n; i++, offset++) {
+        if (atLineStart && buf[i] != '\n') {
+          offsets[pending++] = offset;
+          records++;
+          atLineStart = false;
+          if (pending == sizeof(offsets) / sizeof(offsets[0])) {
+            idx.write((const uint8_t*)offsets, sizeof(offsets));
+            pending = 0;
+          }
+        }
+        if (buf[i] == '\n') atLineStart = true;
+      }
+    }
+    idx.write((const uint8_t*)offsets, pending * sizeof(uint32_t));
+    data.close();
+  }
+
+  header[0] = NDJSON_IDX_MAGIC;
+  header[1] = size;
+  idx.seek(0);
+  idx.write((const uint8_t*)header, sizeof(header));
+  idx.close();
+
+  Serial.printf("DB: Indexed %s, %u records in %lu ms\n", path, records, millis() - start);
+  return true;
+}
+
+// Make sure the index of `path` describes exactly `size` bytes of it. Caller holds the DB lock.
+static bool ensureIndex(const char* path, uint32_t size) {
+  String idxPath = indexPath(path);
+  File idx = storage.open(idxPath.c_str(), FILE_READ);
+  if (idx) {
+    uint32_t header[2] = {0, 0};
+    bool valid = idx.read((uint8_t*)header, sizeof(header)) == sizeof(header) &&
+                 header[0] == NDJSON_IDX_MAGIC && header[1] == size;
+    idx.close();
+    if (valid) {
+      return true;
+    }
+  } else if (size == 0 && !storage.exists(path)) {
+    return true;  // No table yet, the first append creates both files
+  }
+  return rebuildIndex(path);
+}
+
+// Records in `path`, read off the size of its index
+static int countRecords(const char* path) {
+  lockDB();
+  int records = 0;
+  File f = storage.open(path, FILE_READ);
+  if (f) {
+    uint32_t size = f.size();
+    f.close();
+    if (ensureIndex(path, size)) {
+      String idxPath = indexPath(path);
+      File idx = storage.open(idxPath.c_str(), FILE_READ);
+      if (idx && idx.size() >= NDJSON_IDX_HEADER) {
+        records = (idx.size() - NDJSON_IDX_HEADER) / sizeof(uint32_t);
+      }
+      if (idx) idx.close();
+    }
+  }
+  unlockDB();
+  return records;
+}
+
+uint32_t getTablesRevision() {
+  return friends_revision + packets_revision;
+}
+
+int countFriends() {
+  return countRecords(FR_TBL);
+}
+
+int countPackets() {
+  return countRecords(PKT_TBL);
+}
+
+// Append `doc` as a new record, keeping the index in sync. If `id_key` is
+// set, that field is filled with the record number first.
+static bool appendRecord(const char* path, JsonDocument& doc, const char* id_key = nullptr) {
+  lockDB();
+
+  File f = storage.open(path, FILE_APPEND);
+  if (!f) {
+    unlockDB();
+    return false;
+  }
+  uint32_t offset = f.size();
+
+  String idxPath = indexPath(path);
+  bool indexed = ensureIndex(path, offset);
+  File idx = indexed ? storage.open(idxPath.c_str(), "r+") : File();
+  uint32_t header[2] = {NDJSON_IDX_MAGIC, 0};
+  uint32_t records = 0;
+  if (idx) {
+    records = idx.size() >= NDJSON_IDX_HEADER ? (idx.size() - NDJSON_IDX_HEADER) / sizeof(uint32_t) : 0;
+  }
+
+  if (id_key != nullptr) {
+    doc[id_key] = records;
+  }
+  serializeJson(doc, f);
+  f.write('\n');
+  f.flush();
+  uint32_t size = f.size();
+  f.close();
+
+  if (idx) {
+    // Offset first, then the header that makes it valid
+    idx.seek(NDJSON_IDX_HEADER + records * sizeof(uint32_t));
+    idx.write((const uint8_t*)&offset, sizeof(offset));
+    header[1] = size;
+    idx.seek(0);
+    idx.write((const uint8_t*)header, sizeof(header));
+    idx.close();
+  }
+
+  unlockDB();
+  return true;
+}
+
 
 void initDB() {
+  if (db_lock == nullptr) {
+    db_lock = xSemaphoreCreateMutex();
+  }
+
   // Storage manager handles LittleFS and SD initialization
   if (!storage.begin()) {
     Serial.println("Storage: Critical failure - rebooting");
@@ -16,21 +198,19 @@ void initDB() {
 }
 
 bool addFriend(pwngrid_peer newFriend) {
-  File f = storage.open(FR_TBL, FILE_WRITE);
-  if (!f) {
-    Serial.println("addFriend: Error opening FR_TBL");
-    return false;
-  }
+  char identity[PWN_IDENTITY_HEX_LEN + 1];
+  identityToHex(newFriend.identity, identity);
+
   StaticJsonDocument<384> friendJSON;  // Increased for GPS data
   friendJSON["epoch"] = newFriend.epoch;
-  friendJSON["face"] = newFriend.face;
-  friendJSON["grid_version"] = newFriend.grid_version;
-  friendJSON["identity"] = newFriend.identity;
+  friendJSON["face"] = pooledString(newFriend.face);
+  friendJSON["grid_version"] = pooledString(newFriend.grid_version);
+  friendJSON["identity"] = identity;
   friendJSON["name"] = newFriend.name;
   friendJSON["session_id"] = newFriend.session_id;
   friendJSON["timestamp"] = newFriend.timestamp;
   friendJSON["uptime"] = newFriend.uptime;
-  friendJSON["version"] = newFriend.version;
+  friendJSON["version"] = pooledString(newFriend.version);
   friendJSON["rssi"] = newFriend.rssi;
   friendJSON["last_ping"] = newFriend.last_ping;
   friendJSON["gone"] = newFriend.gone;
@@ -45,36 +225,27 @@ bool addFriend(pwngrid_peer newFriend) {
     friendJSON["has_gps"] = false;
   }
 
-  serializeJson(friendJSON, f);
-  f.write('\n');
-  f.flush();  
-  f.close();
-  Serial.println("Friend added to DB" + String(newFriend.has_gps ? " (with GPS)" : ""));
+  if (!appendRecord(FR_TBL, friendJSON)) {
+    LOG_E("addFriend: Error opening FR_TBL");
+    return false;
+  }
+  friends_revision++;
+  LOG_I("Friend added to DB%s", newFriend.has_gps ? " (with GPS)" : "");
   return true;
 }
 
-bool mergeFriend(const pwngrid_peer &nf, uint64_t &pwngrid_friends_tot) {
-
-Serial.println(String("Checking Friend name: ") + nf.name);
-
-  File in = storage.open(FR_TBL, FILE_READ);
-  if (!in) {
-    Serial.println("Not present in DB yet, calling addFriend for: " + nf.name);
-    pwngrid_friends_tot++;
-    Serial.println("We have now met a total friends of: ");
-    Serial.println(pwngrid_friends_tot);
-    return addFriend(nf);
-  }
-
+// Rewrite the friends table with `nf` updated or appended. Caller holds the DB lock.
+static bool rewriteFriends(File &in, const pwngrid_peer &nf, uint64_t &pwngrid_friends_tot) {
   String tmpPath = String(FR_TBL) + ".tmp";
   File out = storage.open(tmpPath.c_str(), FILE_WRITE);
   if (!out) {
-    Serial.println("mergeFriend: Error opening temp file");
+    LOG_E("mergeFriend: Error opening temp file");
     in.close();
     return false;
   }
 
   bool found = false;
+  uint8_t identity[PWN_IDENTITY_LEN];
   StaticJsonDocument<512> doc; // Change according to size
 
   while (in.available()) {
@@ -92,12 +263,12 @@ Serial.println(String("Checking Friend name: ") + nf.name);
     JsonObject obj = doc.as<JsonObject>();
     const char* id = obj["identity"] | "";
 
-    if (id && nf.identity && String(id) == String(nf.identity)) {
-      obj["face"]         = nf.face;
-      obj["grid_version"] = nf.grid_version;
+    if (identityFromHex(id, identity) && memcmp(identity, nf.identity, PWN_IDENTITY_LEN) == 0) {
+      obj["face"]         = pooledString(nf.face);
+      obj["grid_version"] = pooledString(nf.grid_version);
       obj["session_id"]   = nf.session_id;
       obj["uptime"]       = nf.uptime;
-      obj["version"]      = nf.version;
+      obj["version"]      = pooledString(nf.version);
       obj["rssi"]         = nf.rssi;
       obj["last_ping"]    = nf.last_ping;
       obj["gone"]         = nf.gone;
@@ -119,22 +290,25 @@ Serial.println(String("Checking Friend name: ") + nf.name);
 
     File out2 = storage.open(tmpPath.c_str(), FILE_APPEND);
     if (!out2) {
-      Serial.println("mergeFriend: Error reopening temp for append");
+      LOG_E("mergeFriend: Error reopening temp for append");
       storage.remove(tmpPath.c_str());
       return false;
     }
     out2.seek(out2.size()); 
 
+    char identity_hex[PWN_IDENTITY_HEX_LEN + 1];
+    identityToHex(nf.identity, identity_hex);
+
     StaticJsonDocument<384> friendJSON;  // Increased for GPS data
     friendJSON["epoch"]        = nf.epoch;
-    friendJSON["face"]         = nf.face;
-    friendJSON["grid_version"] = nf.grid_version;
-    friendJSON["identity"]     = nf.identity;
+    friendJSON["face"]         = pooledString(nf.face);
+    friendJSON["grid_version"] = pooledString(nf.grid_version);
+    friendJSON["identity"]     = identity_hex;
     friendJSON["name"]         = nf.name;
     friendJSON["session_id"]   = nf.session_id;
     friendJSON["timestamp"]    = nf.timestamp;
     friendJSON["uptime"]       = nf.uptime;
-    friendJSON["version"]      = nf.version;
+    friendJSON["version"]      = pooledString(nf.version);
     friendJSON["rssi"]         = nf.rssi;
     friendJSON["last_ping"]    = nf.last_ping;
     friendJSON["gone"]         = nf.gone;
@@ -156,17 +330,38 @@ Serial.println(String("Checking Friend name: ") + nf.name);
   }
 
   storage.remove(FR_TBL);
+  friends_revision++;
   if (!storage.rename(tmpPath.c_str(), FR_TBL)) {
-    Serial.println("mergeFriend: Error renaming temp to FR_TBL");
+    LOG_E("mergeFriend: Error renaming temp to FR_TBL");
     // Try to cleanup
     storage.remove(tmpPath.c_str());
     return false;
   }
+  rebuildIndex(FR_TBL);
 
-  Serial.println(found ? "Friend updated in DB" : "Friend inserted in DB");
+  LOG_I(found ? "Friend updated in DB" : "Friend inserted in DB");
   return true;
 }
 
+bool mergeFriend(const pwngrid_peer &nf, uint64_t &pwngrid_friends_tot) {
+  TRACE_SCOPE("mergeFriend");
+
+  LOG_D("Checking Friend name: %s", nf.name.c_str());
+
+  File in = storage.open(FR_TBL, FILE_READ);
+  if (!in) {
+    LOG_D("Not present in DB yet, calling addFriend for: %s", nf.name.c_str());
+    pwngrid_friends_tot++;
+    LOG_I("We have now met a total friends of: %llu", pwngrid_friends_tot);
+    return addFriend(nf);
+  }
+
+  lockDB();
+  bool ok = rewriteFriends(in, nf, pwngrid_friends_tot);
+  unlockDB();
+  return ok;
+}
+
 
 /*
 typedef struct {
@@ -180,21 +375,69 @@ typedef struct {
 */
 
 bool addPacket(packet_item_t packet) {
-  File f = storage.open(PKT_TBL, FILE_WRITE);
-  if (!f) {
-    Serial.println("addPacket: Error opening PKT_TBL");
-    return false;
-  }
+  TRACE_SCOPE("addPacket");
   StaticJsonDocument<256> pktJSON;
   pktJSON["data"] = packet.data;
   pktJSON["len"] = packet.len;
   pktJSON["channel"] = packet.channel;
   pktJSON["type"] = packet.type;
   pktJSON["ts_ms"] = packet.ts_ms;
-  serializeJson(pktJSON, f);
-  f.write('\n');
-  f.flush();  
-  f.close();
-  Serial.println("Packet added to DB");
+  // Packets are downloaded by id, which is their record number
+  if (!appendRecord(PKT_TBL, pktJSON, "id")) {
+    LOG_E("addPacket: Error opening PKT_TBL");
+    return false;
+  }
+  packets_revision++;
+  LOG_D("%s packet added to DB", packet.type);
+  return true;
+}
+
+
+// ========== NDJSON random access ==========
+NdjsonTable::NdjsonTable(const char* path, const volatile uint32_t* revision)
+  : path(path), revision(revision), openedRevision(0), opened(false), lines(0) {}
+
+bool NdjsonTable::begin() {
+  uint32_t rev = *revision;
+  String idxPath = indexPath(path);
+
+  lockDB();
+  file = storage.open(path, FILE_READ);
+  if (file && ensureIndex(path, file.size())) {
+    index = storage.open(idxPath.c_str(), FILE_READ);
+  }
+  unlockDB();
+
+  lines = 0;
+  if (file && index && index.size() >= NDJSON_IDX_HEADER) {
+    lines = (index.size() - NDJSON_IDX_HEADER) / sizeof(uint32_t);
+  }
+
+  // A missing table is an empty one until the next write
+  opened = true;
+  openedRevision = rev;
+  return file && index;
+}
+
+void NdjsonTable::end() {
+  if (file) file.close();
+  if (index) index.close();
+}
+
+bool NdjsonTable::readLine(int i, char* buf, size_t len) {
+  if (!file || !index || i < 0 || i >= lines || len == 0) {
+    return false;
+  }
+
+  uint32_t offset;
+  index.seek(NDJSON_IDX_HEADER + i * sizeof(uint32_t));
+  if (index.read((uint8_t*)&offset, sizeof(offset)) != sizeof(offset) || !file.seek(offset)) {
+    return false;
+  }
+
+  size_t n = file.read((uint8_t*)buf, len - 1);
+  size_t end = 0;
+  while (end < n && buf[end] != '\n') end++;
+  buf[end] = '\0';
   return true;
 }
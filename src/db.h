@@ -13,5 +13,48 @@ int countPackets();
 int countFriends();
 int countEAPOL();
 int countPMKID();
+// Bumped by every write to any table, restarts at boot
+uint32_t getTablesRevision();
+
+// Tables are append-only NDJSON files. Each one has a sidecar "<table>.idx"
+// with an 8 byte header (magic, size of the table it describes) followed by
+// one uint32_t byte offset per record, kept in sync on every write. Record N
+// is then one seek away, whatever the size of the table. A missing or stale
+// index is rebuilt with a single scan.
+#define NDJSON_IDX_MAGIC 0x3158444e  // "NDX1"
+#define NDJSON_IDX_HEADER 8
+
+extern const char* FR_TBL;
+extern const char* PKT_TBL;
+
+class NdjsonTable {
+public:
+  NdjsonTable(const char* path, const volatile uint32_t* revision);
+
+  // Open the table and its index, rebuilding the index if it is stale
+  bool begin();
+  void end();
+
+  int count() const { return lines; }
+  uint32_t getRevision() const { return *revision; }
+  bool isStale() const { return !opened || *revision != openedRevision; }
+
+  // Copy record `index` into buf (truncated to len - 1), returns false if out of range
+  bool readLine(int index, char* buf, size_t len);
+
+private:
+  const char* path;
+  const volatile uint32_t* revision;
+  uint32_t openedRevision;
+  bool opened;
+  File file;
+  File index;
+  int lines;
+};
+
+// One instance per task reading a table, they keep their own file handles
+extern NdjsonTable friendsHistory;   // UI task
+extern NdjsonTable friendsApiTable;  // Web server
+extern NdjsonTable packetsApiTable;  // Web server
 
 #endif
\ No newline at end of file
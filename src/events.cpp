@@ -0,0 +1,74 @@
+#include "events.h"
+#include "freertos/FreeRTOS.h"
+
+static BusEvent event_ring[EVENT_RING_SIZE];
+static uint32_t event_seq = 0;
+static volatile int event_subscribers = 0;
+static portMUX_TYPE event_mux = portMUX_INITIALIZER_UNLOCKED;
+
+void publishEvent(EventType type, uint8_t key, int32_t value) {
+  if (event_subscribers == 0) {
+    return;
+  }
+
+  portENTER_CRITICAL(&event_mux);
+  BusEvent& e = event_ring[event_seq & (EVENT_RING_SIZE - 1)];
+  e.seq = event_seq++;
+  e.type = type;
+  e.key = key;
+  e.value = value;
+  portEXIT_CRITICAL(&event_mux);
+}
+
+void subscribeEvents() {
+  portENTER_CRITICAL(&event_mux);
+  event_subscribers++;
+  portEXIT_CRITICAL(&event_mux);
+}
+
+void unsubscribeEvents() {
+  portENTER_CRITICAL(&event_mux);
+  if (event_subscribers > 0) {
+    event_subscribers--;
+  }
+  portEXIT_CRITICAL(&event_mux);
+}
+
+uint32_t getEventSeq() {
+  portENTER_CRITICAL(&event_mux);
+  uint32_t seq = event_seq;
+  portEXIT_CRITICAL(&event_mux);
+  return seq;
+}
+
+int readEvents(uint32_t* cursor, BusEvent* out, int max) {
+  bool overrun = false;
+  int n = 0;
+
+  portENTER_CRITICAL(&event_mux);
+  if (event_seq - *cursor > EVENT_RING_SIZE) {
+    *cursor = event_seq - EVENT_RING_SIZE;
+    overrun = true;
+  }
+  while (n < max && *cursor != event_seq) {
+    out[n++] = event_ring[(*cursor)++ & (EVENT_RING_SIZE - 1)];
+  }
+  portEXIT_CRITICAL(&event_mux);
+
+  return overrun ? -1 : n;
+}
+
+size_t appendJsonString(char* out, size_t cap, const String& s) {
+  size_t n = 0;
+  for (size_t i = 0; i < s.length() && n + 2 < cap; i++) {
+    char ch = s[i];
+    if (ch == '"' || ch == '\\') {
+      out[n++] = '\\';
+    } else if ((uint8_t)ch < 0x20) {
+      ch = ' ';
+    }
+    out[n++] = ch;
+  }
+  out[n] = '\0';
+  return n;
+}
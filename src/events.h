@@ -0,0 +1,54 @@
+#ifndef _EVENTS_H_
+#define _EVENTS_H_
+
+#include "Arduino.h"
+
+// In-memory event bus for live telemetry. Producers (sniffer callback, AI,
+// main loop) push small fixed-size events into a ring, consumers keep their
+// own cursor and read at their own pace. Nothing is recorded while nobody
+// is subscribed, so publishing is a single load and branch in that case.
+
+#ifndef EVENT_RING_SIZE
+#define EVENT_RING_SIZE 64  // Must be a power of two
+#endif
+
+enum EventType : uint8_t {
+  EVENT_PEER_SEEN,  // key: peer index
+  EVENT_PEER_GONE,  // key: peer index
+  EVENT_PEER_RSSI,  // key: peer index, value: rssi
+  EVENT_COUNTER,    // key: EventCounter, value: new count
+  EVENT_CHANNEL,    // value: channel
+};
+
+enum EventCounter : uint8_t {
+  COUNTER_PEERS,
+  COUNTER_PWNED,
+  COUNTER_PACKETS,
+};
+
+struct BusEvent {
+  uint32_t seq;
+  EventType type;
+  uint8_t key;
+  int32_t value;
+};
+
+void publishEvent(EventType type, uint8_t key, int32_t value);
+
+// Consumers register so producers know someone is listening
+void subscribeEvents();
+void unsubscribeEvents();
+
+// Sequence number the next event will get, a new consumer starts from here
+uint32_t getEventSeq();
+
+// Copy up to `max` events from `*cursor` on and advance it. Returns -1 when
+// the consumer fell more than EVENT_RING_SIZE events behind, the cursor then
+// jumps to the oldest event still held and the consumer should resync.
+int readEvents(uint32_t* cursor, BusEvent* out, int max);
+
+// Copy a string received over the air (a peer name) into a JSON string value:
+// quotes and backslashes escaped, control characters blanked, cut to fit cap
+size_t appendJsonString(char* out, size_t cap, const String& s);
+
+#endif
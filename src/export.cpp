@@ -0,0 +1,160 @@
+#include "export.h"
+#include "storage.h"
+#include "db.h"
+
+#define TAR_BLOCK 512
+
+static uint32_t padded(uint32_t n) {
+  return (n + TAR_BLOCK - 1) & ~(TAR_BLOCK - 1);
+}
+
+static void fnv1a(uint32_t& h, const void* data, size_t len) {
+  const uint8_t* p = (const uint8_t*)data;
+  while (len--) {
+    h = (h ^ *p++) * 16777619u;
+  }
+}
+
+uint32_t TarExport::plan() {
+  // Tables are rewritten in place, often to the same size: the fingerprint
+  // also covers their revision, salted per boot since revisions restart at 0
+  static uint32_t boot_salt = esp_random();
+  uint32_t revision = getTablesRevision();
+  count = 0;
+  fingerprint = 2166136261u;
+  fnv1a(fingerprint, &boot_salt, sizeof(boot_salt));
+  fnv1a(fingerprint, &revision, sizeof(revision));
+  addDir("/", 0);
+
+  size = 2 * TAR_BLOCK;  // End of archive marker
+  for (int i = 0; i < count; i++) {
+    size += TAR_BLOCK + padded(entries[i].size);
+    fnv1a(fingerprint, entries[i].path, strlen(entries[i].path));
+    fnv1a(fingerprint, &entries[i].size, sizeof(entries[i].size));
+  }
+  return size;
+}
+
+void TarExport::addDir(const char* path, int depth) {
+  File dir = storage.open(path, FILE_READ);
+  if (!dir || !dir.isDirectory()) {
+    return;
+  }
+
+  for (File f = dir.openNextFile(); f && count < EXPORT_MAX_FILES; f = dir.openNextFile()) {
+    String p = f.path();
+    if (f.isDirectory()) {
+      if (depth < 2) {
+        addDir(p.c_str(), depth + 1);
+      }
+    } else if (!p.endsWith(".idx") && !p.endsWith(".tmp") && p.length() < EXPORT_PATH_MAX) {
+      // Indexes and temporaries are rebuilt on the device, not data
+      ExportEntry& e = entries[count++];
+      strlcpy(e.path, p.c_str(), sizeof(e.path));
+      e.size = f.size();
+    }
+    f.close();
+  }
+  dir.close();
+}
+
+// Emit the part of [at, at + len) that falls inside the requested range
+bool TarExport::emit(const uint8_t* data, uint32_t at, uint32_t len) {
+  uint32_t s = max(at, from);
+  uint32_t e = min(at + len, to);
+  if (s >= e) {
+    return true;
+  }
+  return sink(ctx, data + (s - at), e - s);
+}
+
+bool TarExport::emitZeros(uint32_t at, uint32_t len) {
+  memset(buf, 0, sizeof(buf));
+  while (len > 0) {
+    uint32_t n = min(len, (uint32_t)sizeof(buf));
+    if (!emit(buf, at, n)) {
+      return false;
+    }
+    at += n;
+    len -= n;
+  }
+  return true;
+}
+
+bool TarExport::emitFile(const ExportEntry& e, uint32_t at) {
+  uint32_t s = max(at, from);
+  uint32_t end = min(at + e.size, to);
+  if (s >= end) {
+    return true;
+  }
+
+  File f = storage.open(e.path, FILE_READ);
+  if (f && s > at) {
+    f.seek(s - at);
+  }
+  while (s < end) {
+    uint32_t n = min(end - s, (uint32_t)sizeof(buf));
+    size_t r = f ? f.read(buf, n) : 0;
+    if (r < n) {
+      // The file shrank since it was planned, keep the layout intact
+      memset(buf + r, 0, n - r);
+    }
+    if (!sink(ctx, buf, n)) {
+      f.close();
+      return false;
+    }
+    s += n;
+  }
+  f.close();
+  return true;
+}
+
+void TarExport::buildHeader(const ExportEntry& e) {
+  memset(buf, 0, TAR_BLOCK);
+  char* h = (char*)buf;
+
+  strlcpy(h, e.path[0] == '/' ? e.path + 1 : e.path, 100);
+  snprintf(h + 100, 8, "%07o", 0644);
+  snprintf(h + 108, 8, "%07o", 0);
+  snprintf(h + 116, 8, "%07o", 0);
+  snprintf(h + 124, 12, "%011lo", (unsigned long)e.size);
+  snprintf(h + 136, 12, "%011lo", 0UL);
+  h[156] = '0';
+  memcpy(h + 257, "ustar", 6);
+  memcpy(h + 263, "00", 2);
+  strlcpy(h + 265, "gotchi", 32);
+  strlcpy(h + 297, "gotchi", 32);
+
+  // Checksum is computed with its own field set to spaces
+  memset(h + 148, ' ', 8);
+  uint32_t sum = 0;
+  for (int i = 0; i < TAR_BLOCK; i++) {
+    sum += buf[i];
+  }
+  snprintf(h + 148, 8, "%06lo", (unsigned long)sum);
+  h[155] = ' ';
+}
+
+bool TarExport::stream(uint32_t from, uint32_t to, Sink sink, void* ctx) {
+  this->from = from;
+  this->to = min(to, size);
+  this->sink = sink;
+  this->ctx = ctx;
+
+  uint32_t at = 0;
+  for (int i = 0; i < count && at < this->to; i++) {
+    const ExportEntry& e = entries[i];
+    if (at + TAR_BLOCK > from) {
+      buildHeader(e);
+      if (!emit(buf, at, TAR_BLOCK)) return false;
+    }
+    at += TAR_BLOCK;
+
+    if (!emitFile(e, at)) return false;
+    at += e.size;
+
+    if (!emitZeros(at, padded(e.size) - e.size)) return false;
+    at = padded(at);
+  }
+  return emitZeros(at, 2 * TAR_BLOCK);
+}
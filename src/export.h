@@ -0,0 +1,57 @@
+#ifndef _EXPORT_H_
+#define _EXPORT_H_
+
+#include "Arduino.h"
+
+// Bulk export of the active storage as a tar (ustar) archive. Files are
+// listed once with their sizes, which fixes the layout of the archive: any
+// byte range of it can be produced without generating what comes before,
+// so an interrupted download can resume with a Range request. Files that
+// grow while exporting are cut at the planned size.
+
+#ifndef EXPORT_MAX_FILES
+#define EXPORT_MAX_FILES 32
+#endif
+#define EXPORT_PATH_MAX 64
+#define EXPORT_READ_CHUNK 4096
+
+struct ExportEntry {
+  char path[EXPORT_PATH_MAX];
+  uint32_t size;
+};
+
+class TarExport {
+public:
+  typedef bool (*Sink)(void* ctx, const uint8_t* data, size_t len);
+
+  // List the data files on the active storage, returns the archive size
+  uint32_t plan();
+
+  uint32_t getSize() const { return size; }
+  int getFileCount() const { return count; }
+  // Changes whenever a file is added, removed, resized or written, and at
+  // every boot, for ETags
+  uint32_t getFingerprint() const { return fingerprint; }
+
+  // Produce bytes [from, to) of the planned archive
+  bool stream(uint32_t from, uint32_t to, Sink sink, void* ctx);
+
+private:
+  void addDir(const char* path, int depth);
+  bool emit(const uint8_t* data, uint32_t at, uint32_t len);
+  bool emitZeros(uint32_t at, uint32_t len);
+  bool emitFile(const ExportEntry& e, uint32_t at);
+  void buildHeader(const ExportEntry& e);
+
+  ExportEntry entries[EXPORT_MAX_FILES];
+  int count;
+  uint32_t size;
+  uint32_t fingerprint;
+  uint32_t from;
+  uint32_t to;
+  Sink sink;
+  void* ctx;
+  uint8_t buf[EXPORT_READ_CHUNK];
+};
+
+#endif
@@ -0,0 +1,176 @@
+#include "face_atlas.h"
+#include "mood.h"
+#include "pwnagotchi.h"
+#include "esp_heap_caps.h"
+
+#define PWNAGOTCHI_MOOD_COUNT (sizeof(pwnagotchi_moods) / sizeof(pwnagotchi_moods[0]))
+#define FACE_ATLAS_BOOT_SLOTS (MOOD_COUNT + PWNAGOTCHI_MOOD_COUNT)
+
+static FaceBitmap boot_faces[FACE_ATLAS_BOOT_SLOTS];
+static uint8_t boot_faces_count = 0;
+static FaceBitmap peer_faces[FACE_ATLAS_PEER_SLOTS];
+static uint32_t atlas_clock = 0;
+static int32_t atlas_max_w = 0;
+static size_t atlas_bytes = 0;
+
+static bool isAsciiFace(const String& face) {
+  for (unsigned int i = 0; i < face.length(); i++) {
+    if ((uint8_t)face[i] >= 0x80) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void setFaceFont(M5Canvas& canvas, const String& face) {
+  if (isAsciiFace(face)) {
+    canvas.setFont(&fonts::Font0);
+    canvas.setTextSize(FACE_ATLAS_ASCII_SIZE);
+  } else {
+    canvas.setFont(&FACE_ATLAS_UNICODE_FONT);
+    canvas.setTextSize(FACE_ATLAS_UNICODE_SIZE);
+  }
+}
+
+static void freeFace(FaceBitmap& bmp) {
+  free(bmp.bits);
+  atlas_bytes -= ((bmp.w + 7) / 8) * bmp.h;
+  bmp = FaceBitmap();
+}
+
+// Rasterize `face` into a 1-bit sprite and keep a copy of its buffer
+static bool renderFace(FaceBitmap& bmp, const String& face) {
+  M5Canvas scratch;
+  scratch.setColorDepth(1);
+  setFaceFont(scratch, face);
+
+  // Shrink faces that would not fit the screen
+  while (scratch.textWidth(face) > atlas_max_w && scratch.getTextSizeX() > 1.0f) {
+    scratch.setTextSize(scratch.getTextSizeX() - 1);
+  }
+
+  int32_t w = scratch.textWidth(face);
+  int32_t h = scratch.fontHeight();
+  if (w <= 0 || h <= 0 || !scratch.createSprite(w, h)) {
+    return false;
+  }
+  scratch.fillSprite(TFT_BLACK);
+  scratch.setTextColor(TFT_WHITE);
+  scratch.setTextDatum(top_left);
+  scratch.drawString(face, 0, 0);
+
+  size_t len = ((w + 7) / 8) * h;
+  uint8_t* bits = (uint8_t*)heap_caps_malloc(len, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (bits == nullptr) {
+    bits = (uint8_t*)malloc(len);
+  }
+  if (bits == nullptr) {
+    scratch.deleteSprite();
+    return false;
+  }
+  memcpy(bits, scratch.getBuffer(), len);
+  scratch.deleteSprite();
+
+  bmp.face = face;
+  bmp.w = w;
+  bmp.h = h;
+  bmp.bits = bits;
+  atlas_bytes += len;
+  return true;
+}
+
+static void addBootFace(const String& face) {
+  if (face.length() == 0 || boot_faces_count >= FACE_ATLAS_BOOT_SLOTS) {
+    return;
+  }
+  for (uint8_t i = 0; i < boot_faces_count; i++) {
+    if (boot_faces[i].face == face) {
+      return;
+    }
+  }
+  if (renderFace(boot_faces[boot_faces_count], face)) {
+    boot_faces[boot_faces_count].last_used = 0;
+    boot_faces_count++;
+  }
+}
+
+// Average time to draw every boot face, through the text renderer or the atlas
+static uint32_t benchmarkFaces(M5Canvas& target, bool atlas) {
+  uint32_t start = micros();
+  for (uint8_t i = 0; i < boot_faces_count; i++) {
+    const FaceBitmap& bmp = boot_faces[i];
+    if (atlas) {
+      target.drawBitmap(0, 0, bmp.bits, bmp.w, bmp.h, TFT_GREEN);
+    } else {
+      setFaceFont(target, bmp.face);
+      target.setTextDatum(top_left);
+      target.drawString(bmp.face, 0, 0);
+    }
+  }
+  return boot_faces_count > 0 ? (micros() - start) / boot_faces_count : 0;
+}
+
+void initFaceAtlas(M5Canvas& target) {
+  unsigned long start = millis();
+  atlas_max_w = target.width();
+
+  for (uint8_t i = 0; i < MOOD_COUNT; i++) {
+    addBootFace(getMoodFace(i));
+  }
+  for (uint8_t i = 0; i < PWNAGOTCHI_MOOD_COUNT; i++) {
+    addBootFace(pwnagotchi_moods[i]);
+  }
+
+  uint32_t text_us = benchmarkFaces(target, false);
+  uint32_t atlas_us = benchmarkFaces(target, true);
+  target.setFont(&fonts::Font0);
+  target.fillSprite(TFT_BLACK);
+
+  Serial.printf("FaceAtlas: %d faces, %u bytes, built in %lu ms\n",
+                boot_faces_count, atlas_bytes, millis() - start);
+  Serial.printf("FaceAtlas: text render %u us/face, bitmap %u us/face\n", text_us, atlas_us);
+}
+
+const FaceBitmap* getFaceBitmap(const String& face) {
+  for (uint8_t i = 0; i < boot_faces_count; i++) {
+    if (boot_faces[i].face == face) {
+      return &boot_faces[i];
+    }
+  }
+
+  // Least recently used peer slot is recycled
+  atlas_clock++;
+  FaceBitmap* victim = &peer_faces[0];
+  for (uint8_t i = 0; i < FACE_ATLAS_PEER_SLOTS; i++) {
+    if (peer_faces[i].bits != nullptr && peer_faces[i].face == face) {
+      peer_faces[i].last_used = atlas_clock;
+      return &peer_faces[i];
+    }
+    if (peer_faces[i].last_used < victim->last_used) {
+      victim = &peer_faces[i];
+    }
+  }
+
+  if (victim->bits != nullptr) {
+    freeFace(*victim);
+  }
+  if (!renderFace(*victim, face)) {
+    return nullptr;
+  }
+  victim->last_used = atlas_clock;
+  return victim;
+}
+
+void drawFace(M5Canvas& canvas, const String& face, int32_t cx, int32_t cy, uint16_t color) {
+  const FaceBitmap* bmp = getFaceBitmap(face);
+  if (bmp == nullptr) {
+    // Out of memory, fall back to the text renderer
+    setFaceFont(canvas, face);
+    canvas.setTextColor(color);
+    canvas.setTextDatum(middle_center);
+    canvas.drawString(face, cx, cy);
+    canvas.setFont(&fonts::Font0);
+    return;
+  }
+  canvas.drawBitmap(cx - bmp->w / 2, cy - bmp->h / 2, bmp->bits, bmp->w, bmp->h, color);
+}
@@ -0,0 +1,40 @@
+#ifndef _FACE_ATLAS_H_
+#define _FACE_ATLAS_H_
+
+#include "Arduino.h"
+#include "M5Unified.h"
+
+// Faces are rasterized once into 1-bit bitmaps and then drawn with a single
+// drawBitmap(), instead of going through the text renderer on every frame.
+// Unicode faces (pwnagotchi style) are rendered with an efont, which Font0
+// can't do at all.
+
+#ifndef FACE_ATLAS_PEER_SLOTS
+#define FACE_ATLAS_PEER_SLOTS 8      // Faces not known at boot (peers, custom moods)
+#endif
+
+#ifndef FACE_ATLAS_UNICODE_FONT
+#define FACE_ATLAS_UNICODE_FONT fonts::efontJA_12
+#endif
+
+#define FACE_ATLAS_ASCII_SIZE 4      // Same size drawMood used with Font0
+#define FACE_ATLAS_UNICODE_SIZE 3
+
+struct FaceBitmap {
+  String face;
+  uint16_t w;
+  uint16_t h;
+  uint8_t* bits;        // (w + 7) / 8 bytes per row, MSB first
+  uint32_t last_used;   // 0 for faces pre-rendered at boot, never evicted
+};
+
+// Pre-render every mood face, sized to fit `target`
+void initFaceAtlas(M5Canvas& target);
+
+// Bitmap for `face`, rendering it into a peer slot if needed
+const FaceBitmap* getFaceBitmap(const String& face);
+
+// Draw `face` centered on (cx, cy)
+void drawFace(M5Canvas& canvas, const String& face, int32_t cx, int32_t cy, uint16_t color);
+
+#endif
@@ -0,0 +1,246 @@
+#include "gzip_stream.h"
+
+#define GZIP_NIL 0xffff
+#define GZIP_MIN_MATCH 3
+#define GZIP_MAX_MATCH 258
+
+static const uint16_t len_base[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t len_extra[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t dist_base[30] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t dist_extra[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+static const uint32_t crc_table[16] = {
+  0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+  0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    crc = (crc >> 4) ^ crc_table[crc & 15];
+    crc = (crc >> 4) ^ crc_table[crc & 15];
+  }
+  return ~crc;
+}
+
+static inline uint16_t hash3(const uint8_t* p) {
+  uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16);
+  return (v * 2654435761u) >> (32 - GZIP_HASH_BITS);
+}
+
+GzipStream::GzipStream(Sink sink, void* ctx)
+  : sink(sink), ctx(ctx), win(nullptr), head(nullptr), prev(nullptr) {}
+
+GzipStream::~GzipStream() {
+  delete[] win;
+  delete[] head;
+  delete[] prev;
+}
+
+bool GzipStream::begin() {
+  win = new (std::nothrow) uint8_t[2 * GZIP_WINDOW];
+  head = new (std::nothrow) uint16_t[1 << GZIP_HASH_BITS];
+  prev = new (std::nothrow) uint16_t[GZIP_WINDOW];
+  if (!win || !head || !prev) {
+    return false;
+  }
+  memset(head, 0xff, sizeof(uint16_t) << GZIP_HASH_BITS);
+  memset(prev, 0xff, sizeof(uint16_t) * GZIP_WINDOW);
+
+  pos = end = 0;
+  bitbuf = 0;
+  bitcount = 0;
+  out_len = 0;
+  crc = 0;
+  isize = osize = 0;
+  ok = true;
+
+  // Header: deflate, no flags, no mtime, unknown OS
+  static const uint8_t header[10] = {0x1f, 0x8b, 0x08, 0, 0, 0, 0, 0, 0, 0xff};
+  for (uint8_t b : header) {
+    putByte(b);
+  }
+  // Everything goes in one final fixed-Huffman block
+  putBits(1, 1);
+  putBits(1, 2);
+  return ok;
+}
+
+bool GzipStream::write(const uint8_t* data, size_t len) {
+  crc = crc32Update(crc, data, len);
+  isize += len;
+
+  while (len > 0 && ok) {
+    if (end == 2 * GZIP_WINDOW) {
+      // compress() always leaves pos past the first half here
+      memmove(win, win + GZIP_WINDOW, GZIP_WINDOW);
+      pos -= GZIP_WINDOW;
+      end -= GZIP_WINDOW;
+      for (int i = 0; i < (1 << GZIP_HASH_BITS); i++) {
+        head[i] = (head[i] != GZIP_NIL && head[i] >= GZIP_WINDOW) ? head[i] - GZIP_WINDOW : GZIP_NIL;
+      }
+      for (int i = 0; i < GZIP_WINDOW; i++) {
+        prev[i] = (prev[i] != GZIP_NIL && prev[i] >= GZIP_WINDOW) ? prev[i] - GZIP_WINDOW : GZIP_NIL;
+      }
+    }
+
+    size_t n = min(len, (size_t)(2 * GZIP_WINDOW - end));
+    memcpy(win + end, data, n);
+    end += n;
+    data += n;
+    len -= n;
+    compress(false);
+  }
+  return ok;
+}
+
+bool GzipStream::finish() {
+  if (win != nullptr) {
+    compress(true);
+    putCode(0, 7);  // End of block
+    if (bitcount > 0) {
+      putByte(bitbuf & 0xff);
+      bitbuf = 0;
+      bitcount = 0;
+    }
+    for (int i = 0; i < 4; i++) putByte(crc >> (8 * i));
+    for (int i = 0; i < 4; i++) putByte(isize >> (8 * i));
+    flushOut();
+  }
+
+  delete[] win;
+  delete[] head;
+  delete[] prev;
+  win = nullptr;
+  head = prev = nullptr;
+  return ok;
+}
+
+// Encode buffered input, keeping a full match of lookahead unless flushing
+void GzipStream::compress(bool flush) {
+  uint16_t limit = flush ? end : (end > GZIP_MAX_MATCH ? end - GZIP_MAX_MATCH : 0);
+
+  while (pos < limit && ok) {
+    uint16_t avail = min(end - pos, GZIP_MAX_MATCH);
+    uint16_t dist = 0;
+    uint16_t len = avail >= GZIP_MIN_MATCH ? longestMatch(pos, avail, &dist) : 0;
+
+    if (len >= GZIP_MIN_MATCH) {
+      putMatch(len, dist);
+      for (uint16_t k = 1; k < len; k++) {
+        if (pos + k + GZIP_MIN_MATCH <= end) {
+          insertHash(pos + k);
+        }
+      }
+      pos += len;
+    } else {
+      putLiteral(win[pos]);
+      pos++;
+    }
+  }
+}
+
+void GzipStream::insertHash(uint16_t p) {
+  uint16_t h = hash3(win + p);
+  prev[p & (GZIP_WINDOW - 1)] = head[h];
+  head[h] = p;
+}
+
+uint16_t GzipStream::longestMatch(uint16_t p, uint16_t avail, uint16_t* dist) {
+  uint16_t h = hash3(win + p);
+  uint16_t cand = head[h];
+  prev[p & (GZIP_WINDOW - 1)] = cand;
+  head[h] = p;
+
+  uint16_t best = 0;
+  int chain = GZIP_MAX_CHAIN;
+  // Chain entries can be overwritten by newer positions, so they must keep going back
+  while (cand != GZIP_NIL && cand < p && chain-- > 0) {
+    if (win[cand + best] == win[p + best]) {
+      uint16_t l = 0;
+      while (l < avail && win[cand + l] == win[p + l]) l++;
+      if (l > best) {
+        best = l;
+        *dist = p - cand;
+        if (l == avail) break;
+      }
+    }
+    uint16_t next = prev[cand & (GZIP_WINDOW - 1)];
+    if (next >= cand) break;
+    cand = next;
+  }
+  return best;
+}
+
+void GzipStream::putBits(uint32_t bits, uint8_t n) {
+  bitbuf |= bits << bitcount;
+  bitcount += n;
+  while (bitcount >= 8) {
+    putByte(bitbuf & 0xff);
+    bitbuf >>= 8;
+    bitcount -= 8;
+  }
+}
+
+// Huffman codes are defined MSB first, the bit stream is LSB first
+void GzipStream::putCode(uint16_t code, uint8_t n) {
+  uint16_t rev = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    rev = (rev << 1) | ((code >> i) & 1);
+  }
+  putBits(rev, n);
+}
+
+void GzipStream::putLiteral(uint8_t c) {
+  if (c < 144) {
+    putCode(0x30 + c, 8);
+  } else {
+    putCode(0x190 + c - 144, 9);
+  }
+}
+
+void GzipStream::putMatch(uint16_t len, uint16_t dist) {
+  int i = 28;
+  while (len_base[i] > len) i--;
+  uint16_t sym = 257 + i;
+  if (sym < 280) {
+    putCode(sym - 256, 7);
+  } else {
+    putCode(0xc0 + sym - 280, 8);
+  }
+  putBits(len - len_base[i], len_extra[i]);
+
+  int d = 29;
+  while (dist_base[d] > dist) d--;
+  putCode(d, 5);
+  putBits(dist - dist_base[d], dist_extra[d]);
+}
+
+void GzipStream::putByte(uint8_t b) {
+  out[out_len++] = b;
+  if (out_len == sizeof(out)) {
+    flushOut();
+  }
+}
+
+bool GzipStream::flushOut() {
+  if (out_len > 0 && ok) {
+    ok = sink(ctx, out, out_len);
+    osize += out_len;
+  }
+  out_len = 0;
+  return ok;
+}
@@ -0,0 +1,65 @@
+#ifndef _GZIP_STREAM_H_
+#define _GZIP_STREAM_H_
+
+#include "Arduino.h"
+
+// Streaming gzip compressor for on-the-fly HTTP responses. It is a small
+// deflater: greedy LZ77 over a GZIP_WINDOW byte window with hash chains,
+// coded as a single fixed-Huffman block. That gets most of the gain on
+// NDJSON/text for about 3 * GZIP_WINDOW bytes of RAM, where zlib would need
+// hundreds of KB. Output is handed to the sink as GZIP_OUT_CHUNK sized pieces.
+
+#ifndef GZIP_WINDOW
+#define GZIP_WINDOW 4096         // Power of two, at most 16384
+#endif
+#ifndef GZIP_MAX_CHAIN
+#define GZIP_MAX_CHAIN 16        // Candidates checked per position
+#endif
+#define GZIP_HASH_BITS 12
+#define GZIP_OUT_CHUNK 1436
+
+class GzipStream {
+public:
+  typedef bool (*Sink)(void* ctx, const uint8_t* data, size_t len);
+
+  GzipStream(Sink sink, void* ctx);
+  ~GzipStream();
+
+  // Allocate the window and write the gzip header, false when out of memory
+  bool begin();
+  bool write(const uint8_t* data, size_t len);
+  // Compress what is left, write the trailer and free the window
+  bool finish();
+
+  size_t getInputSize() const { return isize; }
+  size_t getOutputSize() const { return osize; }
+
+private:
+  void compress(bool flush);
+  void insertHash(uint16_t p);
+  uint16_t longestMatch(uint16_t p, uint16_t avail, uint16_t* dist);
+  void putBits(uint32_t bits, uint8_t n);
+  void putCode(uint16_t code, uint8_t n);
+  void putLiteral(uint8_t c);
+  void putMatch(uint16_t len, uint16_t dist);
+  void putByte(uint8_t b);
+  bool flushOut();
+
+  Sink sink;
+  void* ctx;
+  uint8_t* win;      // 2 * GZIP_WINDOW bytes, slid down by half when full
+  uint16_t* head;    // Hash -> last position
+  uint16_t* prev;    // Position -> previous position with the same hash
+  uint16_t pos;      // Next byte to encode
+  uint16_t end;      // End of buffered input
+  uint32_t bitbuf;
+  uint8_t bitcount;
+  uint8_t out[GZIP_OUT_CHUNK];
+  size_t out_len;
+  uint32_t crc;
+  size_t isize;
+  size_t osize;
+  bool ok;
+};
+
+#endif
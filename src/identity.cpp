@@ -243,3 +243,30 @@ String getSessionId() {
   Preferences p; if (!p.begin(NVS_NS, true)) return "";
   String s = p.getString("sid", ""); p.end(); return s;
 }
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool identityFromHex(const char* hex, uint8_t out[PWN_IDENTITY_LEN]) {
+  if (hex == nullptr) return false;
+  for (size_t i = 0; i < PWN_IDENTITY_LEN; i++) {
+    int hi = hexDigit(hex[2 * i]);
+    int lo = hi < 0 ? -1 : hexDigit(hex[2 * i + 1]);
+    if (lo < 0) return false;
+    out[i] = (hi << 4) | lo;
+  }
+  return hex[PWN_IDENTITY_HEX_LEN] == '\0';
+}
+
+void identityToHex(const uint8_t id[PWN_IDENTITY_LEN], char out[PWN_IDENTITY_HEX_LEN + 1]) {
+  static const char* H = "0123456789abcdef";
+  for (size_t i = 0; i < PWN_IDENTITY_LEN; i++) {
+    out[2 * i] = H[id[i] >> 4];
+    out[2 * i + 1] = H[id[i] & 0xF];
+  }
+  out[PWN_IDENTITY_HEX_LEN] = '\0';
+}
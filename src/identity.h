@@ -18,4 +18,11 @@ String getPublicPEM();
 String getFingerprintHex();
 String getSessionId();
 
+// Fingerprints (sha256 of the public key) as pwngrid peers advertise them,
+// 64 hex digits, and as they are kept in memory
+#define PWN_IDENTITY_LEN 32
+#define PWN_IDENTITY_HEX_LEN (PWN_IDENTITY_LEN * 2)
+bool identityFromHex(const char* hex, uint8_t out[PWN_IDENTITY_LEN]);  // false unless exactly 64 hex digits
+void identityToHex(const uint8_t id[PWN_IDENTITY_LEN], char out[PWN_IDENTITY_HEX_LEN + 1]);
+
 #endif // PWN_IDENTITY_H
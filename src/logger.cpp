@@ -0,0 +1,200 @@
+#include "logger.h"
+#include "task_config.h"
+#include "metrics.h"
+
+static_assert((LOG_RING_SLOTS & (LOG_RING_SLOTS - 1)) == 0, "LOG_RING_SLOTS must be a power of two");
+
+// Bounded multi-producer ring: a slot is free for position p when its
+// sequence is p, and holds a message for the reader when it is p + 1.
+// Slots store their sequence minus their index, so the zeroed ring is
+// valid before any constructor or setup() runs.
+static LogRecord log_ring[LOG_RING_SLOTS];
+static uint32_t log_head = 0;  // Next position to claim, producers
+static uint32_t log_tail = 0;  // Next position to read, drain task only
+static uint32_t log_drops = 0;
+
+static uint32_t slotIndex(const LogRecord* r) {
+  return r - log_ring;
+}
+
+static uint32_t slotSeq(const LogRecord* r) {
+  return __atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) + slotIndex(r);
+}
+
+static void setSlotSeq(LogRecord* r, uint32_t seq) {
+  __atomic_store_n(&r->seq, seq - slotIndex(r), __ATOMIC_RELEASE);
+}
+
+LogRecord* logReserve() {
+  uint32_t pos = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+  for (;;) {
+    LogRecord* r = &log_ring[pos & (LOG_RING_SLOTS - 1)];
+    int32_t diff = (int32_t)(slotSeq(r) - pos);
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&log_head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        r->tick_ms = millis();
+        return r;
+      }
+    } else if (diff < 0) {
+      __atomic_fetch_add(&log_drops, 1, __ATOMIC_RELAXED);
+      metricInc(METRIC_LOG_DROPS);
+      return nullptr;
+    } else {
+      pos = __atomic_load_n(&log_head, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+void logCommit(LogRecord* r) {
+  // The slot's sequence is still the claimed position
+  setSlotSeq(r, slotSeq(r) + 1);
+}
+
+uint32_t getLogDrops() {
+  return __atomic_load_n(&log_drops, __ATOMIC_RELAXED);
+}
+
+// ========== Formatting (drain task) ==========
+#define LOG_LINE_MAX 256
+
+static const char log_level_tags[] = "?EWID";
+
+// Formats one conversion spec ("%08.3lf" etc.) with the next captured
+// argument, converted to the type the spec asks for
+static int formatSpec(char* out, size_t len, const char* spec, const LogRecord& r, uint8_t& arg, uint8_t& word,
+                      int star_count, const int* stars) {
+  char conv = spec[strlen(spec) - 1];
+  if (conv == '%') return snprintf(out, len, "%%");
+  if (arg >= r.nargs) return snprintf(out, len, "<?>");
+
+  LogArgType type = (LogArgType)r.types[arg++];
+  uint64_t v = r.args[word++];
+  if (type == LOG_ARG_INT64 || type == LOG_ARG_DOUBLE) {
+    v |= (uint64_t)r.args[word++] << 32;
+  }
+
+  bool ll = strstr(spec, "ll") != nullptr;
+  bool l = !ll && strchr(spec, 'l') != nullptr;
+  bool z = strchr(spec, 'z') != nullptr;
+  int a = star_count > 0 ? stars[0] : 0;
+  int b = star_count > 1 ? stars[1] : 0;
+
+#define LOG_SNPRINTF(value) \
+  (star_count == 2 ? snprintf(out, len, spec, a, b, value) \
+   : star_count == 1 ? snprintf(out, len, spec, a, value) : snprintf(out, len, spec, value))
+
+  if (conv == 's') {
+    const char* s = type == LOG_ARG_STR ? r.strs + (uint32_t)v : "<?>";
+    return LOG_SNPRINTF(s);
+  }
+  if (strchr("fFeEgGaA", conv)) {
+    double d;
+    if (type == LOG_ARG_DOUBLE) {
+      memcpy(&d, &v, sizeof(d));
+    } else {
+      d = (double)(int64_t)v;
+    }
+    return LOG_SNPRINTF(d);
+  }
+  if (conv == 'p') return LOG_SNPRINTF((void*)(uintptr_t)v);
+
+  // Integers; 32-bit captures are sign extended for signed conversions
+  bool is_signed = conv == 'd' || conv == 'i';
+  if (type == LOG_ARG_INT && is_signed) v = (uint64_t)(int64_t)(int32_t)v;
+  if (ll) return is_signed ? LOG_SNPRINTF((long long)v) : LOG_SNPRINTF((unsigned long long)v);
+  if (l) return is_signed ? LOG_SNPRINTF((long)v) : LOG_SNPRINTF((unsigned long)v);
+  if (z) return LOG_SNPRINTF((size_t)v);
+  return is_signed ? LOG_SNPRINTF((int)v) : LOG_SNPRINTF((unsigned)v);
+#undef LOG_SNPRINTF
+}
+
+static size_t formatRecord(const LogRecord& r, char* line, size_t size) {
+  size_t n = snprintf(line, size, "[%5lu.%03lu] %c ", (unsigned long)(r.tick_ms / 1000),
+                      (unsigned long)(r.tick_ms % 1000), log_level_tags[r.level < 5 ? r.level : 0]);
+  uint8_t arg = 0;
+  uint8_t word = 0;
+  const char* p = r.fmt;
+
+  while (*p && n < size - 1) {
+    if (*p != '%') {
+      line[n++] = *p++;
+      continue;
+    }
+
+    // Collect one conversion spec, '*' widths are taken from the arguments
+    char spec[16];
+    size_t s = 0;
+    int stars[2];
+    int star_count = 0;
+    spec[s++] = *p++;
+    while (*p && s < sizeof(spec) - 1) {
+      char c = *p++;
+      spec[s++] = c;
+      if (c == '*' && star_count < 2 && arg < r.nargs) {
+        stars[star_count++] = (int)r.args[word++];
+        arg++;
+      }
+      if (strchr("diouxXcsfFeEgGaAp%", c)) break;
+    }
+    spec[s] = 0;
+
+    int w = formatSpec(line + n, size - n, spec, r, arg, word, star_count, stars);
+    if (w > 0) n += w;
+    if (n >= size) n = size - 1;
+  }
+
+  // Callers used println(), keep one newline at the end
+  while (n > 0 && line[n - 1] == '\n') n--;
+  line[n++] = '\n';
+  return n;
+}
+
+static volatile bool log_paused = false;
+static volatile bool log_idle = false;  // Drain task saw the pause
+
+// Formats and writes everything queued, returns the number of messages
+static uint32_t drainLog() {
+  static char line[LOG_LINE_MAX + 1];
+  uint32_t written = 0;
+  while (!log_paused) {
+    LogRecord* r = &log_ring[log_tail & (LOG_RING_SLOTS - 1)];
+    if (slotSeq(r) != log_tail + 1) break;
+
+    size_t n = formatRecord(*r, line, LOG_LINE_MAX);
+    setSlotSeq(r, log_tail + LOG_RING_SLOTS);
+    log_tail++;
+    Serial.write((const uint8_t*)line, n);
+    written++;
+  }
+  return written;
+}
+
+static void logTask(void* pv) {
+  uint32_t reported_drops = 0;
+  for (;;) {
+    log_idle = log_paused;
+    if (log_paused) {
+      vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_MS));
+      continue;
+    }
+    drainLog();
+    uint32_t drops = getLogDrops();
+    if (drops != reported_drops) {
+      Serial.printf("Log: %u messages dropped\n", (unsigned)(drops - reported_drops));
+      reported_drops = drops;
+    }
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_MS));
+  }
+}
+
+void pauseLog(bool paused) {
+  log_paused = paused;
+  // Wait for a line being written to finish
+  for (int i = 0; paused && !log_idle && i < 50; i++) {
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_MS));
+  }
+}
+
+void initLog() {
+  startTask(TASK_LOG, logTask);
+}
@@ -0,0 +1,166 @@
+#ifndef _LOGGER_H_
+#define _LOGGER_H_
+
+#include "Arduino.h"
+
+// Deferred logging for hot paths (sniffer callback, DB workers). A call
+// copies the format pointer and its raw arguments into a lock-free ring;
+// formatting and the blocking Serial write happen later on a low priority
+// drain task. Messages are dropped, and counted, when the ring is full.
+//
+//   LOG_I("Spotted %s on ch %d", name.c_str(), channel);
+//
+// The format must be a string literal. Strings are copied (up to
+// LOG_STR_BYTES per message, longer ones are cut short); everything else
+// is captured by value. Levels above LOG_LEVEL compile to nothing.
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#ifndef LOG_RING_SLOTS
+#define LOG_RING_SLOTS 64  // Power of two
+#endif
+#ifndef LOG_STR_BYTES
+#define LOG_STR_BYTES 48
+#endif
+#ifndef LOG_DRAIN_MS
+#define LOG_DRAIN_MS 20
+#endif
+
+#define LOG_MAX_ARGS 6
+#define LOG_ARG_WORDS (LOG_MAX_ARGS * 2)
+
+#define LOG_E(fmt, ...) LOG_AT(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define LOG_W(fmt, ...) LOG_AT(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define LOG_I(fmt, ...) LOG_AT(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define LOG_D(fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+
+#define LOG_AT(level, fmt, ...) \
+  do { \
+    if ((level) <= LOG_LEVEL) logDeferred((level), fmt, ##__VA_ARGS__); \
+  } while (0)
+
+enum LogArgType : uint8_t {
+  LOG_ARG_INT,     // One word
+  LOG_ARG_INT64,   // Two words
+  LOG_ARG_DOUBLE,  // Two words
+  LOG_ARG_STR,     // One word, offset into the string area
+};
+
+struct LogRecord {
+  uint32_t seq;  // Ring bookkeeping, see logger.cpp
+  const char* fmt;
+  uint32_t tick_ms;
+  uint8_t level;
+  uint8_t nargs;
+  uint8_t words;
+  uint8_t str_len;
+  uint8_t types[LOG_MAX_ARGS];
+  uint32_t args[LOG_ARG_WORDS];
+  char strs[LOG_STR_BYTES];
+};
+
+// Claims a ring slot, nullptr (and a counted drop) when the ring is full
+LogRecord* logReserve();
+// Publishes a slot filled in after logReserve()
+void logCommit(LogRecord* r);
+
+// Starts the drain task, messages logged before are kept until then
+void initLog();
+uint32_t getLogDrops();
+// Holds back output while something else owns the serial port. Messages
+// logged meanwhile queue up, or are dropped once the ring is full.
+void pauseLog(bool paused);
+
+// ========== Argument capture ==========
+inline void logWord(LogRecord* r, uint32_t w) {
+  r->args[r->words++] = w;
+}
+
+inline void logArg64(LogRecord* r, LogArgType type, uint64_t v) {
+  r->types[r->nargs++] = type;
+  logWord(r, (uint32_t)v);
+  logWord(r, (uint32_t)(v >> 32));
+}
+
+inline void logArg32(LogRecord* r, uint32_t v) {
+  r->types[r->nargs++] = LOG_ARG_INT;
+  logWord(r, v);
+}
+
+// long and pointers are one word on the chip, two on the native host
+template <class T>
+inline void logArgNative(LogRecord* r, T v) {
+  if (sizeof(T) > sizeof(uint32_t)) {
+    logArg64(r, LOG_ARG_INT64, (uint64_t)v);
+  } else {
+    logArg32(r, (uint32_t)v);
+  }
+}
+
+// Fundamental types only, int32_t and friends map to different ones per chip
+inline void logArg(LogRecord* r, int v) { logArg32(r, v); }
+inline void logArg(LogRecord* r, unsigned v) { logArg32(r, v); }
+inline void logArg(LogRecord* r, long v) { logArgNative(r, v); }
+inline void logArg(LogRecord* r, unsigned long v) { logArgNative(r, v); }
+inline void logArg(LogRecord* r, short v) { logArg32(r, v); }
+inline void logArg(LogRecord* r, unsigned short v) { logArg32(r, v); }
+inline void logArg(LogRecord* r, char v) { logArg32(r, v); }
+inline void logArg(LogRecord* r, signed char v) { logArg32(r, v); }
+inline void logArg(LogRecord* r, unsigned char v) { logArg32(r, v); }
+inline void logArg(LogRecord* r, bool v) { logArg32(r, v); }
+inline void logArg(LogRecord* r, long long v) { logArg64(r, LOG_ARG_INT64, (uint64_t)v); }
+inline void logArg(LogRecord* r, unsigned long long v) { logArg64(r, LOG_ARG_INT64, v); }
+inline void logArg(LogRecord* r, const void* p) { logArgNative(r, (uintptr_t)p); }
+
+inline void logArg(LogRecord* r, double v) {
+  uint64_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  logArg64(r, LOG_ARG_DOUBLE, bits);
+}
+inline void logArg(LogRecord* r, float v) { logArg(r, (double)v); }
+
+inline void logArg(LogRecord* r, const char* s) {
+  r->types[r->nargs++] = LOG_ARG_STR;
+  if (r->str_len >= LOG_STR_BYTES) {
+    logWord(r, LOG_STR_BYTES - 1);  // Out of room, points at the previous terminator
+    return;
+  }
+  logWord(r, r->str_len);
+  if (s == nullptr) s = "(null)";
+  size_t n = strnlen(s, LOG_STR_BYTES - 1 - r->str_len);
+  memcpy(r->strs + r->str_len, s, n);
+  r->str_len += n;
+  r->strs[r->str_len++] = 0;
+}
+inline void logArg(LogRecord* r, char* s) { logArg(r, (const char*)s); }
+
+inline void logArgs(LogRecord* r) {}
+
+template <typename T, typename... Rest>
+inline void logArgs(LogRecord* r, T first, Rest... rest) {
+  logArg(r, first);
+  logArgs(r, rest...);
+}
+
+template <typename... Args>
+inline void logDeferred(uint8_t level, const char* fmt, Args... args) {
+  static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "Too many log arguments");
+  LogRecord* r = logReserve();
+  if (r == nullptr) return;
+  r->fmt = fmt;
+  r->level = level;
+  r->nargs = 0;
+  r->words = 0;
+  r->str_len = 0;
+  logArgs(r, args...);
+  logCommit(r);
+}
+
+#endif
@@ -1,7 +1,7 @@
 #include "menu_system.h"
 
 MenuSystem::MenuSystem(M5Canvas* canv) 
-    : canvas(canv), currentIndex(0), scrollOffset(0), title("") {
+    : canvas(canv), currentIndex(0), scrollOffset(0), title(""), revision(0), dataSource(nullptr) {
     
     primaryColor = TFT_GREEN;
     secondaryColor = TFT_DARKGREEN;
@@ -52,21 +52,32 @@ void MenuSystem::autoConfigureForScreen() {
 
 void MenuSystem::setTitle(const String& t) {
     title = t;
+    revision++;
 }
 
 void MenuSystem::addItem(const String& label, std::function<void()> action) {
     items.push_back(MenuItem(label, action));
+    revision++;
 }
 
 void MenuSystem::addBackItem(std::function<void()> action) {
     MenuItem backItem("< Back", action);
     items.push_back(backItem);
+    revision++;
 }
 
 void MenuSystem::clearItems() {
     items.clear();
     currentIndex = 0;
     scrollOffset = 0;
+    revision++;
+}
+
+void MenuSystem::setDataSource(MenuDataSource* source) {
+    dataSource = source;
+    currentIndex = 0;
+    scrollOffset = 0;
+    revision++;
 }
 
 void MenuSystem::setColors(uint16_t primary, uint16_t secondary, uint16_t bg, uint16_t highlight) {
@@ -77,7 +88,14 @@ void MenuSystem::setColors(uint16_t primary, uint16_t secondary, uint16_t bg, ui
 }
 
 int MenuSystem::getVisibleStartIndex() {
-    if (items.size() <= config.maxVisibleItems) {
+    int count = getItemCount();
+    
+    // Data source rows may have gone away since the last draw
+    if (currentIndex >= count) {
+        currentIndex = max(0, count - 1);
+    }
+    if (count <= config.maxVisibleItems) {
+        scrollOffset = 0;
         return 0;
     }
     
@@ -94,16 +112,31 @@ int MenuSystem::getVisibleStartIndex() {
 int MenuSystem::getVisibleEndIndex() {
     int start = getVisibleStartIndex();
     int end = start + config.maxVisibleItems;
-    if (end > items.size()) {
-        end = items.size();
+    if (end > getItemCount()) {
+        end = getItemCount();
     }
     return end;
 }
 
+// Label of row `index`, data source rows first. Valid until the next call.
+const char* MenuSystem::getLabel(int index, bool& enabled) {
+    int sourceCount = getSourceCount();
+    enabled = true;
+    if (index < sourceCount) {
+        labelBuf[0] = '\0';
+        dataSource->formatLabel(index, labelBuf, sizeof(labelBuf));
+        return labelBuf;
+    }
+    MenuItem& item = items[index - sourceCount];
+    enabled = item.enabled;
+    return item.label.c_str();
+}
+
 void MenuSystem::drawMenuItem(int index, int yPos, bool isSelected) {
-    if (index < 0 || index >= items.size()) return;
+    if (index < 0 || index >= getItemCount()) return;
     
-    MenuItem& item = items[index];
+    bool enabled;
+    const char* label = getLabel(index, enabled);
     
     // Draw selection background
     if (isSelected) {
@@ -122,24 +155,34 @@ void MenuSystem::drawMenuItem(int index, int yPos, bool isSelected) {
     canvas->setTextDatum(middle_left);
     
     // Draw text
-    uint16_t textColor = isSelected ? highlightColor : (item.enabled ? primaryColor : TFT_DARKGREY);
+    uint16_t textColor = isSelected ? highlightColor : (enabled ? primaryColor : TFT_DARKGREY);
     canvas->setTextColor(textColor);
     
-    String displayText = item.label;
-    int maxChars = (canvas->width() - config.padding * 3 - config.scrollbarWidth) / 6;
-    if (displayText.length() > maxChars) {
-        displayText = displayText.substring(0, maxChars - 3) + "...";
+    int graphicWidth = 0;
+    if (index < getSourceCount()) {
+        int right = canvas->width() - config.padding * 2 - config.scrollbarWidth - 2;
+        graphicWidth = dataSource->drawRowGraphic(index, canvas, right, yPos + 2, config.itemHeight - 6, textColor);
+    }
+    
+    int maxChars = (canvas->width() - config.padding * 3 - config.scrollbarWidth - graphicWidth) / 6;
+    maxChars = min(maxChars, MENU_LABEL_MAX - 1);
+    if (label != labelBuf) {
+        strlcpy(labelBuf, label, sizeof(labelBuf));
+    }
+    if ((int)strlen(labelBuf) > maxChars && maxChars > 3) {
+        strcpy(labelBuf + maxChars - 3, "...");
     }
     
     canvas->drawString(
-        displayText, 
+        labelBuf, 
         config.padding * 2, 
         yPos + config.itemHeight / 2
     );
 }
 
 void MenuSystem::drawScrollbar() {
-    if (items.size() <= config.maxVisibleItems) return;
+    int count = getItemCount();
+    if (count <= config.maxVisibleItems) return;
     
     int scrollbarX = canvas->width() - config.scrollbarWidth - 1;
     int scrollbarHeight = canvas->height() - 25;
@@ -149,10 +192,10 @@ void MenuSystem::drawScrollbar() {
     canvas->drawRect(scrollbarX, scrollbarY, config.scrollbarWidth, scrollbarHeight, secondaryColor);
     
     // Calculate thumb position and size
-    float itemRatio = (float)config.maxVisibleItems / items.size();
+    float itemRatio = (float)config.maxVisibleItems / count;
     int thumbHeight = max(10, (int)(scrollbarHeight * itemRatio));
     
-    float scrollRatio = (float)scrollOffset / (items.size() - config.maxVisibleItems);
+    float scrollRatio = (float)scrollOffset / (count - config.maxVisibleItems);
     int thumbY = scrollbarY + (int)((scrollbarHeight - thumbHeight) * scrollRatio);
     
     // Draw thumb
@@ -162,6 +205,11 @@ void MenuSystem::drawScrollbar() {
 void MenuSystem::draw() {
     canvas->fillSprite(backgroundColor);
     
+    if (dialog.type != DIALOG_NONE) {
+        drawDialog();
+        return;
+    }
+    
     // Draw title
     if (title.length() > 0) {
         canvas->setTextSize(config.fontSize + 1);
@@ -184,11 +232,13 @@ void MenuSystem::draw() {
     int endIdx = getVisibleEndIndex();
     
     // Draw menu items
+    if (dataSource != nullptr) dataSource->beginRows();
     int yPos = 25;
     for (int i = startIdx; i < endIdx; i++) {
         drawMenuItem(i, yPos, i == currentIndex);
         yPos += config.itemHeight;
     }
+    if (dataSource != nullptr) dataSource->endRows();
     
     // Draw scrollbar
     drawScrollbar();
@@ -203,37 +253,60 @@ void MenuSystem::draw() {
 }
 
 void MenuSystem::navigateUp() {
-    if (items.empty()) return;
+    if (dialog.type != DIALOG_NONE) {
+        // Any press dismisses a message and cancels a confirmation
+        if (dialogAcceptsInput()) closeDialog(false);
+        return;
+    }
+    int count = getItemCount();
+    if (count == 0) return;
     
+    revision++;
     currentIndex--;
     if (currentIndex < 0) {
-        currentIndex = items.size() - 1;
-        scrollOffset = max(0, (int)items.size() - config.maxVisibleItems);
+        currentIndex = count - 1;
+        scrollOffset = max(0, count - config.maxVisibleItems);
     }
 }
 
 void MenuSystem::navigateDown() {
-    if (items.empty()) return;
+    if (dialog.type != DIALOG_NONE) {
+        if (dialogAcceptsInput()) closeDialog(false);
+        return;
+    }
+    if (isEmpty()) return;
     
+    revision++;
     currentIndex++;
-    if (currentIndex >= items.size()) {
+    if (currentIndex >= getItemCount()) {
         currentIndex = 0;
         scrollOffset = 0;
     }
 }
 
 void MenuSystem::select() {
-    if (items.empty() || currentIndex < 0 || currentIndex >= items.size()) return;
+    if (dialog.type != DIALOG_NONE) {
+        if (dialogAcceptsInput()) closeDialog(dialog.type == DIALOG_CONFIRM);
+        return;
+    }
+    if (currentIndex < 0 || currentIndex >= getItemCount()) return;
     
-    MenuItem& item = items[currentIndex];
+    int sourceCount = getSourceCount();
+    if (currentIndex < sourceCount) {
+        dataSource->onSelect(currentIndex);
+        return;
+    }
+    
+    MenuItem& item = items[currentIndex - sourceCount];
     if (item.enabled && item.action) {
         item.action();
     }
 }
 
 void MenuSystem::setCurrentIndex(int idx) {
-    if (idx >= 0 && idx < items.size()) {
+    if (idx >= 0 && idx < getItemCount()) {
         currentIndex = idx;
+        revision++;
         
         // Adjust scroll offset if needed
         if (currentIndex < scrollOffset) {
@@ -243,3 +316,130 @@ void MenuSystem::setCurrentIndex(int idx) {
         }
     }
 }
+
+void MenuSystem::update() {
+    if (dialog.type == DIALOG_NONE) return;
+    
+    if (dialog.type == DIALOG_PROGRESS) {
+        int percent = dialog.percent;
+        bool done = dialog.poll ? dialog.poll(percent) : true;
+        if (percent != dialog.percent) {
+            dialog.percent = percent;
+            revision++;
+        }
+        if (done) {
+            closeDialog(false);
+        }
+        return;
+    }
+    
+    if (dialog.timeoutMs > 0 && millis() - dialog.openedAt >= dialog.timeoutMs) {
+        closeDialog(false);
+    }
+}
+
+void MenuSystem::showMessage(const String& title, const String& body, uint32_t timeoutMs,
+                             std::function<void()> onClose, uint16_t bodyColor) {
+    dialog = MenuDialog();
+    dialog.type = DIALOG_MESSAGE;
+    dialog.title = title;
+    dialog.body = body;
+    dialog.bodyColor = bodyColor ? bodyColor : primaryColor;
+    dialog.openedAt = millis();
+    dialog.timeoutMs = timeoutMs;
+    dialog.onClose = onClose;
+    revision++;
+}
+
+void MenuSystem::showConfirm(const String& title, const String& body, std::function<void()> onConfirm,
+                             std::function<void()> onCancel, uint32_t timeoutMs) {
+    dialog = MenuDialog();
+    dialog.type = DIALOG_CONFIRM;
+    dialog.title = title;
+    dialog.body = body;
+    dialog.bodyColor = TFT_RED;
+    dialog.openedAt = millis();
+    dialog.timeoutMs = timeoutMs;
+    dialog.onConfirm = onConfirm;
+    dialog.onClose = onCancel;
+    revision++;
+}
+
+void MenuSystem::showProgress(const String& title, std::function<bool(int&)> poll,
+                              std::function<void()> onDone) {
+    dialog = MenuDialog();
+    dialog.type = DIALOG_PROGRESS;
+    dialog.title = title;
+    dialog.bodyColor = primaryColor;
+    dialog.openedAt = millis();
+    dialog.poll = poll;
+    dialog.onClose = onDone;
+    revision++;
+}
+
+bool MenuSystem::dialogAcceptsInput() const {
+    return dialog.type != DIALOG_PROGRESS && millis() - dialog.openedAt >= DIALOG_INPUT_GUARD_MS;
+}
+
+void MenuSystem::closeDialog(bool confirmed) {
+    // The callback may open another dialog or rebuild this menu, so detach it first
+    std::function<void()> callback = confirmed ? dialog.onConfirm : dialog.onClose;
+    dialog = MenuDialog();
+    revision++;
+    if (callback) {
+        callback();
+    }
+}
+
+void MenuSystem::drawDialog() {
+    int w = canvas->width();
+    int h = canvas->height();
+    int y = config.padding;
+    
+    // Title-less dialogs are short notices, centered in large text
+    if (dialog.title.length() == 0) {
+        canvas->setTextSize(config.fontSize + 1);
+        canvas->setTextDatum(middle_center);
+        canvas->setTextColor(dialog.bodyColor);
+        canvas->drawString(dialog.body, w / 2, h / 2);
+        return;
+    }
+    
+    canvas->setTextSize(config.fontSize + 1);
+    canvas->setTextDatum(top_center);
+    canvas->setTextColor(highlightColor);
+    canvas->drawString(dialog.title, w / 2, y);
+    y += 25;
+    
+    canvas->setTextSize(config.fontSize);
+    canvas->setTextDatum(top_left);
+    canvas->setTextColor(dialog.bodyColor);
+    int start = 0;
+    while (start < (int)dialog.body.length()) {
+        int end = dialog.body.indexOf('\n', start);
+        if (end < 0) end = dialog.body.length();
+        canvas->drawString(dialog.body.substring(start, end), config.padding * 2, y);
+        y += 10;
+        start = end + 1;
+    }
+    
+    if (dialog.type == DIALOG_PROGRESS) {
+        int barX = config.padding * 2;
+        int barW = w - config.padding * 4;
+        int barY = h / 2;
+        canvas->drawRect(barX, barY, barW, 10, secondaryColor);
+        if (dialog.percent >= 0) {
+            canvas->fillRect(barX + 1, barY + 1, (barW - 2) * min(dialog.percent, 100) / 100, 8, primaryColor);
+        }
+        return;
+    }
+    
+    canvas->setTextDatum(bottom_center);
+    if (dialog.type == DIALOG_CONFIRM) {
+        canvas->setTextColor(primaryColor);
+        canvas->drawString("Press: Cancel | Hold: Confirm", w / 2, h - 2);
+    } else if (dialog.timeoutMs == 0) {
+        canvas->setTextColor(TFT_DARKGREY);
+        canvas->drawString("Press or hold to go back", w / 2, h - 2);
+    }
+}
@@ -16,6 +16,54 @@ struct MenuItem {
         : label(lbl), action(act) {}
 };
 
+// Lazily formatted menu rows. Only the visible rows are formatted, into a
+// fixed scratch buffer, so the row count does not affect memory or render time.
+class MenuDataSource {
+public:
+    virtual ~MenuDataSource() {}
+    
+    virtual int getCount() = 0;
+    virtual void formatLabel(int index, char* buf, size_t len) = 0;
+    virtual void onSelect(int index) {}
+    
+    // Called around each batch of formatLabel() calls
+    virtual void beginRows() {}
+    virtual void endRows() {}
+    
+    // Changes whenever the rows would render differently
+    virtual uint32_t getRevision() { return 0; }
+    
+    // Optional graphic at the right end of a row, drawn ending at x `right`.
+    // Returns the width it took, the label is shortened to leave it room.
+    virtual int drawRowGraphic(int index, M5Canvas* canvas, int right, int y, int h, uint16_t color) { return 0; }
+};
+
+#define MENU_LABEL_MAX 64
+
+// Modal dialog shown on top of a menu
+enum DialogType {
+    DIALOG_NONE = 0,
+    DIALOG_MESSAGE,   // Dismissed by any button or after a timeout
+    DIALOG_CONFIRM,   // Hold confirms, press cancels, timeout cancels
+    DIALOG_PROGRESS   // Polled until done, ignores input
+};
+
+struct MenuDialog {
+    DialogType type = DIALOG_NONE;
+    String title;
+    String body;                    // Lines separated by '\n'
+    uint16_t bodyColor = 0;
+    uint32_t openedAt = 0;
+    uint32_t timeoutMs = 0;         // 0 = no timeout
+    int percent = -1;               // Progress dialogs only
+    std::function<bool(int&)> poll; // Returns true once finished
+    std::function<void()> onConfirm;
+    std::function<void()> onClose;  // Dismissed, cancelled, timed out or finished
+};
+
+// Ignore input right after a dialog opens so the press that opened it does not close it
+#define DIALOG_INPUT_GUARD_MS 300
+
 // Menu configuration for different screen sizes
 struct MenuConfig {
     int itemHeight;
@@ -38,10 +86,19 @@ private:
     uint16_t secondaryColor;
     uint16_t backgroundColor;
     uint16_t highlightColor;
+    MenuDialog dialog;
+    uint32_t revision;
+    MenuDataSource* dataSource;     // Rows before the static items, if set
+    char labelBuf[MENU_LABEL_MAX];
     
     void autoConfigureForScreen();
+    void drawDialog();
+    void closeDialog(bool confirmed);
+    bool dialogAcceptsInput() const;
     void drawScrollbar();
     void drawMenuItem(int index, int yPos, bool isSelected);
+    const char* getLabel(int index, bool& enabled);
+    int getSourceCount() { return dataSource != nullptr ? dataSource->getCount() : 0; }
     int getVisibleStartIndex();
     int getVisibleEndIndex();
     
@@ -53,18 +110,36 @@ public:
     void addBackItem(std::function<void()> action);
     void clearItems();
     
+    // Show rows from a data source above the static items (e.g. "< Back")
+    void setDataSource(MenuDataSource* source);
+    
     void setColors(uint16_t primary, uint16_t secondary, uint16_t bg, uint16_t highlight);
     
     void draw();
     void navigateUp();
     void navigateDown();
     void select();
+    void update();
+    
+    // Non-blocking modal dialogs, driven by draw()/update() and the usual input calls
+    void showMessage(const String& title, const String& body, uint32_t timeoutMs = 0,
+                     std::function<void()> onClose = nullptr, uint16_t bodyColor = 0);
+    void showConfirm(const String& title, const String& body, std::function<void()> onConfirm,
+                     std::function<void()> onCancel = nullptr, uint32_t timeoutMs = 10000);
+    void showProgress(const String& title, std::function<bool(int&)> poll,
+                      std::function<void()> onDone = nullptr);
+    bool hasDialog() const { return dialog.type != DIALOG_NONE; }
+    
+    // Changes on every change that affects what draw() renders
+    uint32_t getRevision() const {
+        return revision + (dataSource != nullptr ? dataSource->getRevision() : 0);
+    }
     
     int getCurrentIndex() const { return currentIndex; }
     void setCurrentIndex(int idx);
     
-    bool isEmpty() const { return items.empty(); }
-    int getItemCount() const { return items.size(); }
+    bool isEmpty() { return getItemCount() == 0; }
+    int getItemCount() { return getSourceCount() + items.size(); }
 };
 
 #endif // MENU_SYSTEM_H
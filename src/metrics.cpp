@@ -0,0 +1,177 @@
+#include "metrics.h"
+
+struct MetricInfo {
+  const char* name;
+  const char* help;
+};
+
+static const MetricInfo counter_info[METRIC_COUNTER_COUNT] = {
+  {"gotchi_sniffer_frames_total", "Management frames handled by the sniffer callback"},
+  {"gotchi_pwngrid_beacons_total", "Pwngrid beacons parsed"},
+  {"gotchi_db_queue_drops_total", "Friends and packets lost to a full DB queue"},
+  {"gotchi_db_packets_total", "Packets written to storage"},
+  {"gotchi_db_friends_total", "Friends merged into storage"},
+  {"gotchi_db_errors_total", "Failed DB writes"},
+  {"gotchi_ui_frames_total", "Frames rendered by the UI task"},
+  {"gotchi_advertise_errors_total", "Pwngrid advertisements that failed to send"},
+  {"gotchi_log_dropped_total", "Log messages lost to a full log ring"},
+};
+
+static const MetricInfo gauge_info[METRIC_GAUGE_COUNT] = {
+  {"gotchi_db_packet_queue_depth", "Packets waiting to be written"},
+  {"gotchi_db_friend_queue_depth", "Friends waiting to be merged"},
+  {"gotchi_peers_nearby", "Pwngrid peers seen this run"},
+};
+
+static const MetricInfo histogram_info[METRIC_HISTOGRAM_COUNT] = {
+  {"gotchi_sniffer_callback_seconds", "Time spent in the promiscuous callback"},
+  {"gotchi_pwngrid_beacon_seconds", "Time spent parsing a pwngrid beacon"},
+  {"gotchi_db_packet_write_seconds", "Time to append a packet to storage"},
+  {"gotchi_db_friend_write_seconds", "Time to merge a friend into storage"},
+  {"gotchi_db_queue_latency_seconds", "Time from capture to stored"},
+  {"gotchi_ui_frame_seconds", "Time to render and push a UI frame"},
+  {"gotchi_advertise_seconds", "Time to send a pwngrid advertisement"},
+};
+
+struct HistogramSlot {
+  uint32_t buckets[METRIC_HIST_BUCKETS];
+  uint64_t sum_us;
+  uint32_t max_us;
+};
+
+static uint32_t counters[portNUM_PROCESSORS][METRIC_COUNTER_COUNT];
+static int32_t gauges[METRIC_GAUGE_COUNT];
+static HistogramSlot histograms[portNUM_PROCESSORS][METRIC_HISTOGRAM_COUNT];
+
+static uint8_t bucketFor(uint32_t us) {
+  if (us <= 1) return 0;
+  uint8_t i = 32 - __builtin_clz(us - 1);
+  return i < METRIC_HIST_BUCKETS - 1 ? i : METRIC_HIST_BUCKETS - 1;
+}
+
+void metricInc(MetricCounter c, uint32_t n) {
+  __atomic_fetch_add(&counters[xPortGetCoreID()][c], n, __ATOMIC_RELAXED);
+}
+
+void metricSet(MetricGauge g, int32_t value) {
+  __atomic_store_n(&gauges[g], value, __ATOMIC_RELAXED);
+}
+
+void metricObserve(MetricHistogram h, uint32_t us) {
+  HistogramSlot& slot = histograms[xPortGetCoreID()][h];
+  __atomic_fetch_add(&slot.buckets[bucketFor(us)], 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&slot.sum_us, (uint64_t)us, __ATOMIC_RELAXED);
+  uint32_t seen = __atomic_load_n(&slot.max_us, __ATOMIC_RELAXED);
+  while (us > seen && !__atomic_compare_exchange_n(&slot.max_us, &seen, us, true,
+                                                   __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+}
+
+uint64_t getMetricCounter(MetricCounter c) {
+  uint64_t total = 0;
+  for (int core = 0; core < portNUM_PROCESSORS; core++) {
+    total += __atomic_load_n(&counters[core][c], __ATOMIC_RELAXED);
+  }
+  return total;
+}
+
+int32_t getMetricGauge(MetricGauge g) {
+  return __atomic_load_n(&gauges[g], __ATOMIC_RELAXED);
+}
+
+void getMetricHistogram(MetricHistogram h, MetricHistogramSnapshot* out) {
+  memset(out, 0, sizeof(*out));
+  for (int core = 0; core < portNUM_PROCESSORS; core++) {
+    HistogramSlot& slot = histograms[core][h];
+    for (int i = 0; i < METRIC_HIST_BUCKETS; i++) {
+      uint32_t n = __atomic_load_n(&slot.buckets[i], __ATOMIC_RELAXED);
+      out->buckets[i] += n;
+      out->count += n;
+    }
+    out->sum_us += __atomic_load_n(&slot.sum_us, __ATOMIC_RELAXED);
+    uint32_t max_us = __atomic_load_n(&slot.max_us, __ATOMIC_RELAXED);
+    if (max_us > out->max_us) out->max_us = max_us;
+  }
+}
+
+void metricHistogramDelta(MetricHistogramSnapshot* now, const MetricHistogramSnapshot& before) {
+  for (int i = 0; i < METRIC_HIST_BUCKETS; i++) {
+    now->buckets[i] -= before.buckets[i];
+  }
+  now->count -= before.count;
+  now->sum_us -= before.sum_us;
+}
+
+uint32_t metricQuantileUs(const MetricHistogramSnapshot& s, float q) {
+  if (s.count == 0) return 0;
+  uint32_t rank = (uint32_t)(q * s.count);
+  if (rank >= s.count) rank = s.count - 1;
+  uint32_t seen = 0;
+  for (int i = 0; i < METRIC_HIST_BUCKETS - 1; i++) {
+    seen += s.buckets[i];
+    if (seen > rank) return 1UL << i;
+  }
+  return s.max_us;
+}
+
+uint32_t metricMeanUs(const MetricHistogramSnapshot& s) {
+  return s.count ? (uint32_t)(s.sum_us / s.count) : 0;
+}
+
+// ========== Prometheus exposition ==========
+#define METRICS_FAMILY_MAX 2048
+
+static size_t appendf(char* buf, size_t len, const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(buf + len, METRICS_FAMILY_MAX - len, fmt, args);
+  va_end(args);
+  if (n < 0) return len;
+  return len + n < METRICS_FAMILY_MAX ? len + n : METRICS_FAMILY_MAX - 1;
+}
+
+static size_t appendHeader(char* buf, size_t len, const MetricInfo& info, const char* type) {
+  return appendf(buf, len, "# HELP %s %s\n# TYPE %s %s\n", info.name, info.help, info.name, type);
+}
+
+bool writeMetricsPrometheus(MetricsSink sink, void* ctx) {
+  // Only one scrape at a time can come from the portal task
+  static char buf[METRICS_FAMILY_MAX];
+  size_t len;
+
+  for (int c = 0; c < METRIC_COUNTER_COUNT; c++) {
+    len = appendHeader(buf, 0, counter_info[c], "counter");
+    len = appendf(buf, len, "%s %llu\n", counter_info[c].name,
+                  (unsigned long long)getMetricCounter((MetricCounter)c));
+    if (!sink(ctx, buf, len)) return false;
+  }
+
+  for (int g = 0; g < METRIC_GAUGE_COUNT; g++) {
+    len = appendHeader(buf, 0, gauge_info[g], "gauge");
+    len = appendf(buf, len, "%s %d\n", gauge_info[g].name, (int)getMetricGauge((MetricGauge)g));
+    if (!sink(ctx, buf, len)) return false;
+  }
+
+  len = appendf(buf, 0, "# HELP gotchi_heap_free_bytes Free internal heap\n# TYPE gotchi_heap_free_bytes gauge\n"
+                        "gotchi_heap_free_bytes %u\n", (unsigned)ESP.getFreeHeap());
+  len = appendf(buf, len, "# HELP gotchi_heap_min_free_bytes Lowest free heap since boot\n"
+                          "# TYPE gotchi_heap_min_free_bytes gauge\ngotchi_heap_min_free_bytes %u\n",
+                (unsigned)ESP.getMinFreeHeap());
+  if (!sink(ctx, buf, len)) return false;
+
+  MetricHistogramSnapshot snap;
+  for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++) {
+    const MetricInfo& info = histogram_info[h];
+    getMetricHistogram((MetricHistogram)h, &snap);
+    len = appendHeader(buf, 0, info, "histogram");
+    uint32_t cumulative = 0;
+    for (int i = 0; i < METRIC_HIST_BUCKETS - 1; i++) {
+      cumulative += snap.buckets[i];
+      len = appendf(buf, len, "%s_bucket{le=\"%.6f\"} %u\n", info.name, (1UL << i) / 1e6, (unsigned)cumulative);
+    }
+    len = appendf(buf, len, "%s_bucket{le=\"+Inf\"} %u\n%s_sum %.6f\n%s_count %u\n",
+                  info.name, (unsigned)snap.count, info.name, snap.sum_us / 1e6, info.name, (unsigned)snap.count);
+    if (!sink(ctx, buf, len)) return false;
+  }
+  return true;
+}
@@ -0,0 +1,75 @@
+#ifndef _METRICS_H_
+#define _METRICS_H_
+
+#include "Arduino.h"
+
+// Counters, gauges and latency histograms for the hot paths. Recording is
+// lock-free: each core only updates its own slot with relaxed atomics and
+// readers add the slots up. Exposed as Prometheus text at /api/metrics and
+// on the Metrics page of the settings menu.
+
+// Bucket i counts observations up to 2^i us (1 us .. 4.2 s), the last one is +Inf
+#define METRIC_HIST_BUCKETS 24
+
+enum MetricCounter : uint8_t {
+  METRIC_SNIFFER_FRAMES,
+  METRIC_PWNGRID_BEACONS,
+  METRIC_QUEUE_DROPS,
+  METRIC_DB_PACKETS,
+  METRIC_DB_FRIENDS,
+  METRIC_DB_ERRORS,
+  METRIC_UI_FRAMES,
+  METRIC_ADVERTISE_ERRORS,
+  METRIC_LOG_DROPS,
+  METRIC_COUNTER_COUNT
+};
+
+enum MetricGauge : uint8_t {
+  METRIC_PACKET_QUEUE_DEPTH,
+  METRIC_FRIEND_QUEUE_DEPTH,
+  METRIC_PEERS_NEARBY,
+  METRIC_GAUGE_COUNT
+};
+
+enum MetricHistogram : uint8_t {
+  METRIC_SNIFFER_CALLBACK,
+  METRIC_PWNGRID_BEACON,
+  METRIC_DB_PACKET_WRITE,
+  METRIC_DB_FRIEND_WRITE,
+  METRIC_DB_QUEUE_LATENCY,  // Enqueued by the sniffer to stored
+  METRIC_UI_FRAME,
+  METRIC_ADVERTISE,
+  METRIC_HISTOGRAM_COUNT
+};
+
+struct MetricHistogramSnapshot {
+  uint32_t buckets[METRIC_HIST_BUCKETS];  // Not cumulative
+  uint32_t count;
+  uint64_t sum_us;
+  uint32_t max_us;
+};
+
+void metricInc(MetricCounter c, uint32_t n = 1);
+void metricSet(MetricGauge g, int32_t value);
+void metricObserve(MetricHistogram h, uint32_t us);
+
+inline void metricObserveSince(MetricHistogram h, int64_t start_us) {
+  metricObserve(h, (uint32_t)(esp_timer_get_time() - start_us));
+}
+
+uint64_t getMetricCounter(MetricCounter c);
+int32_t getMetricGauge(MetricGauge g);
+void getMetricHistogram(MetricHistogram h, MetricHistogramSnapshot* out);
+
+// Subtract an earlier snapshot, for measuring a window
+void metricHistogramDelta(MetricHistogramSnapshot* now, const MetricHistogramSnapshot& before);
+// Upper bound of the bucket holding quantile q (0..1), 0 when empty
+uint32_t metricQuantileUs(const MetricHistogramSnapshot& s, float q);
+uint32_t metricMeanUs(const MetricHistogramSnapshot& s);
+
+typedef bool (*MetricsSink)(void* ctx, const char* data, size_t len);
+
+// Prometheus text exposition format, one metric family per sink call
+bool writeMetricsPrometheus(MetricsSink sink, void* ctx);
+
+#endif
@@ -0,0 +1,194 @@
+#include "microbench.h"
+
+#if MICROBENCH
+
+#include "logger.h"
+#include <stdarg.h>
+#if defined(ESP_PLATFORM)
+#include "esp_cpu.h"
+#endif
+
+static BenchCase* bench_head = nullptr;
+static BenchCase* bench_tail = nullptr;
+
+BenchCase::BenchCase(const char* name, BenchFn fn, int64_t arg, bool has_arg)
+  : name(name), fn(fn), arg(arg), has_arg(has_arg), next(nullptr) {
+  // Static constructors, in file order
+  if (bench_tail != nullptr) {
+    bench_tail->next = this;
+  } else {
+    bench_head = this;
+  }
+  bench_tail = this;
+}
+
+static inline uint32_t benchCycleCount() {
+#if defined(ESP_PLATFORM)
+  return esp_cpu_get_cycle_count();
+#else
+  return 0;  // No portable cycle counter on the host, times only
+#endif
+}
+
+void BenchState::startTiming() {
+  if (running_) return;
+  running_ = true;
+  start_cycles_ = benchCycleCount();
+  start_us_ = esp_timer_get_time();
+}
+
+void BenchState::stopTiming() {
+  if (!running_) return;
+  int64_t now_us = esp_timer_get_time();
+  uint32_t now_cycles = benchCycleCount();
+  running_ = false;
+  elapsed_ns_ += (uint64_t)(now_us - start_us_) * 1000;
+  cycles_ += (uint32_t)(now_cycles - start_cycles_);  // Wraps every ~18 s at 240 MHz
+}
+
+// ========== JSON output ==========
+struct BenchWriter {
+  BenchSink sink;
+  void* ctx;
+  bool ok;
+  size_t len;
+  char buf[768];
+};
+
+static void benchOut(BenchWriter& w, const char* fmt, ...) {
+  if (!w.ok) return;
+  if (w.len > sizeof(w.buf) - 256) {
+    w.ok = w.sink(w.ctx, w.buf, w.len);
+    w.len = 0;
+  }
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(w.buf + w.len, sizeof(w.buf) - w.len, fmt, ap);
+  va_end(ap);
+  if (n > 0) {
+    w.len += min((size_t)n, sizeof(w.buf) - w.len - 1);
+  }
+}
+
+static void benchContext(BenchWriter& w, uint32_t min_time_ms) {
+#if defined(ESP_PLATFORM)
+  const char* host = "esp32";
+  unsigned mhz = getCpuFrequencyMhz();
+#else
+  const char* host = "native";
+  unsigned mhz = 0;
+#endif
+  benchOut(w, "{\n\"context\":{\"host_name\":\"%s\",\"executable\":\"gotchi\",\"num_cpus\":%d,"
+              "\"mhz_per_cpu\":%u,\"cpu_scaling_enabled\":false,\"library_build_type\":\"release\","
+              "\"min_time_ms\":%u},\n\"benchmarks\":[",
+           host, portNUM_PROCESSORS, mhz, (unsigned)min_time_ms);
+}
+
+static void benchResult(BenchWriter& w, const char* name, const BenchState& state, bool first) {
+  benchOut(w, "%s\n{\"name\":\"%s\",\"run_name\":\"%s\",\"run_type\":\"iteration\","
+              "\"repetitions\":1,\"repetition_index\":0,\"threads\":1,",
+           first ? "" : ",", name, name);
+  if (state.error() != nullptr) {
+    benchOut(w, "\"error_occurred\":true,\"error_message\":\"%s\"}", state.error());
+    return;
+  }
+  uint64_t iters = state.iterations();
+  double ns = (double)state.elapsedNs() / iters;
+  double seconds = state.elapsedNs() / 1e9;
+  benchOut(w, "\"iterations\":%llu,\"real_time\":%.3f,\"cpu_time\":%.3f,\"time_unit\":\"ns\"",
+           (unsigned long long)iters, ns, ns);
+  if (state.itemsProcessed() > 0 && seconds > 0) {
+    benchOut(w, ",\"items_per_second\":%.1f", state.itemsProcessed() / seconds);
+  }
+  if (state.bytesProcessed() > 0 && seconds > 0) {
+    benchOut(w, ",\"bytes_per_second\":%.1f", state.bytesProcessed() / seconds);
+  }
+  if (state.cycles() > 0) {
+    benchOut(w, ",\"cycles_per_iteration\":%.1f", (double)state.cycles() / iters);
+  }
+  if (state.label() != nullptr) {
+    benchOut(w, ",\"label\":\"%s\"", state.label());
+  }
+  benchOut(w, "}");
+}
+
+// ========== Runner ==========
+bool runMicrobenchmarks(BenchSink sink, void* ctx, const char* filter, uint32_t min_time_ms) {
+  if (min_time_ms == 0) {
+    min_time_ms = MICROBENCH_MIN_TIME_MS;
+  }
+  uint64_t min_ns = (uint64_t)min_time_ms * 1000000;
+
+  BenchWriter* w = new BenchWriter{sink, ctx, true, 0, {}};
+  benchContext(*w, min_time_ms);
+
+  bool first = true;
+  for (BenchCase* c = bench_head; c != nullptr && w->ok; c = c->next) {
+    char name[64];
+    if (c->has_arg) {
+      snprintf(name, sizeof(name), "%s/%lld", c->name, (long long)c->arg);
+    } else {
+      snprintf(name, sizeof(name), "%s", c->name);
+    }
+    if (filter != nullptr && strstr(name, filter) == nullptr) continue;
+
+    // Grow the iteration count until a run lasts min_time_ms
+    uint64_t iters = 1;
+    while (true) {
+      BenchState state(iters, c->arg);
+      c->fn(state);
+      uint64_t ns = state.elapsedNs();
+      if (state.error() != nullptr || ns >= min_ns || iters >= MICROBENCH_MAX_ITERATIONS) {
+        benchResult(*w, name, state, first);
+        break;
+      }
+      uint64_t next = ns > 0 ? (uint64_t)(iters * 1.4 * min_ns / ns) : iters * 10;
+      next = min(next, iters * 10);
+      next = max(next, iters + 1);
+      iters = min(next, (uint64_t)MICROBENCH_MAX_ITERATIONS);
+    }
+    first = false;
+    vTaskDelay(1);  // Let the idle task in between cases
+  }
+  benchOut(*w, "\n]}\n");
+  if (w->ok && w->len > 0) {
+    w->ok = sink(ctx, w->buf, w->len);
+  }
+  bool ok = w->ok;
+  delete w;
+  return ok;
+}
+
+#if defined(ESP_PLATFORM)
+
+static bool benchSerialSink(void* ctx, const char* data, size_t len) {
+  Serial.write((const uint8_t*)data, len);
+  return true;
+}
+
+static void benchTask(void* pv) {
+  vTaskDelay(pdMS_TO_TICKS(MICROBENCH_WARMUP_MS));
+  pauseLog(true);
+  Serial.println("\n=== BENCH BEGIN ===");
+  if (!runMicrobenchmarks(benchSerialSink, nullptr, nullptr, 0)) {
+    Serial.println("Bench: Run failed");
+  }
+  Serial.println("=== BENCH END ===");
+  pauseLog(false);
+  vTaskDelete(NULL);
+}
+
+void startMicrobenchmarks() {
+  if (xTaskCreatePinnedToCore(benchTask, "microbench", 12288, NULL, MICROBENCH_PRIORITY, NULL,
+                              1) != pdPASS) {
+    Serial.println("Bench: Failed to start");
+  }
+}
+
+#else
+
+void startMicrobenchmarks() {}
+
+#endif
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef _MICROBENCH_H_
+#define _MICROBENCH_H_
+
+#include "Arduino.h"
+
+// Microbenchmarks for the hot paths, built only with -DMICROBENCH=1. Cases
+// live in bench_cases.cpp and read like Google Benchmark ones:
+//
+//   static void benchSomething(BenchState& state) {
+//     ...setup, not timed...
+//     for (auto _ : state) {
+//       benchKeep(something());
+//     }
+//     state.setItemsProcessed(state.iterations());
+//   }
+//   BENCHMARK(benchSomething);
+//
+// Each case is rerun with more iterations until a run lasts at least
+// MICROBENCH_MIN_TIME_MS. Results are Google Benchmark JSON, so two commits
+// compare with tools/bench_diff.py (or Google's compare.py). On the device
+// they also carry CPU cycles per iteration from esp_cpu_get_cycle_count().
+//
+// Host:   .pio/build/native/program bench [--filter s] [--min-time ms] [--out file]
+// Device: -DMICROBENCH=1, the JSON is printed on serial after boot between
+//         "=== BENCH BEGIN ===" and "=== BENCH END ===". The DB cases write
+//         records, so use a scratch device.
+
+#ifndef MICROBENCH
+#define MICROBENCH 0
+#endif
+#ifndef MICROBENCH_MIN_TIME_MS
+#define MICROBENCH_MIN_TIME_MS 500
+#endif
+#ifndef MICROBENCH_MAX_ITERATIONS
+#define MICROBENCH_MAX_ITERATIONS 100000000
+#endif
+#ifndef MICROBENCH_WARMUP_MS
+#define MICROBENCH_WARMUP_MS 10000  // Device: let boot, storage and identity settle first
+#endif
+#ifndef MICROBENCH_PRIORITY
+#define MICROBENCH_PRIORITY 5       // Device: above the loop and UI tasks on its core
+#endif
+
+#if MICROBENCH
+
+class BenchState {
+public:
+  struct Value {
+    ~Value() {}  // Not trivial, so `auto _` draws no unused warning
+  };
+
+  class Iterator {
+  public:
+    Iterator(BenchState* state, uint64_t left) : state_(state), left_(left) {}
+    Value operator*() const { return Value(); }
+    Iterator& operator++() {
+      left_--;
+      return *this;
+    }
+    bool operator!=(const Iterator&) {
+      if (left_ != 0) return true;
+      state_->stopTiming();
+      return false;
+    }
+
+  private:
+    BenchState* state_;
+    uint64_t left_;
+  };
+
+  BenchState(uint64_t iterations, int64_t arg) : iterations_(iterations), arg_(arg) {}
+
+  Iterator begin() {
+    startTiming();
+    return Iterator(this, iterations_);
+  }
+  Iterator end() { return Iterator(this, 0); }
+
+  // Leave per-iteration setup out of the measurement
+  void pauseTiming() { stopTiming(); }
+  void resumeTiming() { startTiming(); }
+
+  uint64_t iterations() const { return iterations_; }
+  int64_t arg() const { return arg_; }
+  void setItemsProcessed(uint64_t items) { items_ = items; }
+  void setBytesProcessed(uint64_t bytes) { bytes_ = bytes; }
+  void setLabel(const char* label) { label_ = label; }
+  // Reported instead of a result, the loop is not entered after this
+  void skipWithError(const char* error) {
+    error_ = error;
+    iterations_ = 0;
+  }
+
+  uint64_t elapsedNs() const { return elapsed_ns_; }
+  uint64_t cycles() const { return cycles_; }
+  uint64_t itemsProcessed() const { return items_; }
+  uint64_t bytesProcessed() const { return bytes_; }
+  const char* label() const { return label_; }
+  const char* error() const { return error_; }
+
+private:
+  void startTiming();
+  void stopTiming();
+
+  uint64_t iterations_;
+  int64_t arg_;
+  bool running_ = false;
+  int64_t start_us_ = 0;
+  uint32_t start_cycles_ = 0;
+  uint64_t elapsed_ns_ = 0;
+  uint64_t cycles_ = 0;
+  uint64_t items_ = 0;
+  uint64_t bytes_ = 0;
+  const char* label_ = nullptr;
+  const char* error_ = nullptr;
+};
+
+typedef void (*BenchFn)(BenchState& state);
+
+struct BenchCase {
+  BenchCase(const char* name, BenchFn fn, int64_t arg, bool has_arg);
+  const char* name;
+  BenchFn fn;
+  int64_t arg;
+  bool has_arg;
+  BenchCase* next;
+};
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+#define BENCHMARK(fn) static BenchCase BENCH_CONCAT(bench_case_, __LINE__)(#fn, fn, 0, false)
+#define BENCHMARK_ARG(fn, a) static BenchCase BENCH_CONCAT(bench_case_, __LINE__)(#fn, fn, a, true)
+
+// Keeps the compiler from dropping a result or the work that produced it
+template <class T>
+inline void benchKeep(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+typedef bool (*BenchSink)(void* ctx, const char* data, size_t len);
+
+// Runs the cases whose name contains filter (all when null) and writes the
+// results as JSON. min_time_ms 0 uses MICROBENCH_MIN_TIME_MS.
+bool runMicrobenchmarks(BenchSink sink, void* ctx, const char* filter, uint32_t min_time_ms);
+
+// Device: runs every case once boot has settled and prints the JSON on serial
+void startMicrobenchmarks();
+
+#endif
+
+#endif
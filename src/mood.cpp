@@ -106,15 +106,31 @@ String homeygotchi_moods_short_desc[] = {
 String* palnagotchi_moods = palnagotchi_default_moods;
 String* palnagotchi_moods_desc = palnagotchi_moods_default_desc;
 
-uint8_t current_mood = 0;
-String current_phrase = "";
-String current_face = "";
-bool current_broken = false;
+// Set from loop() jobs, read by the UI task: copied in and out under the lock
+static MoodSnapshot current_mood = {};
+static portMUX_TYPE mood_mux = portMUX_INITIALIZER_UNLOCKED;
 
-uint8_t getCurrentMoodId() { return current_mood; }
-String getCurrentMoodFace() { return current_face; }
-String getCurrentMoodPhrase() { return current_phrase; }
-bool isCurrentMoodBroken() { return current_broken; }
+void getMoodSnapshot(MoodSnapshot& out) {
+  portENTER_CRITICAL(&mood_mux);
+  out = current_mood;
+  portEXIT_CRITICAL(&mood_mux);
+}
+
+uint8_t getCurrentMoodId() { return current_mood.id; }
+String getMoodFace(uint8_t mood) { return mood < MOOD_COUNT ? palnagotchi_moods[mood] : ""; }
+bool isCurrentMoodBroken() { return current_mood.broken; }
+
+String getCurrentMoodFace() {
+  MoodSnapshot mood;
+  getMoodSnapshot(mood);
+  return mood.face;
+}
+
+String getCurrentMoodPhrase() {
+  MoodSnapshot mood;
+  getMoodSnapshot(mood);
+  return mood.phrase;
+}
 
 void initMood() {
   //Serial.println("Initting Mood");
@@ -127,19 +143,18 @@ void initMood() {
 
 void setMood(uint8_t mood, String face, String phrase, bool broken) {
   //Serial.println("Setting Mood...");
-  current_mood = mood;
-  current_broken = broken;
-
-  if (face != "") {
-    current_face = face;
-  } else {
-    current_face = palnagotchi_moods[current_mood];
+  if (face == "") {
+    face = palnagotchi_moods[mood];
   }
-
-  if (phrase != "") {
-    current_phrase = phrase;
-  } else {
-    current_phrase = palnagotchi_moods_desc[current_mood];
+  if (phrase == "") {
+    phrase = palnagotchi_moods_desc[mood];
   }
+
+  portENTER_CRITICAL(&mood_mux);
+  current_mood.id = mood;
+  current_mood.broken = broken;
+  strlcpy(current_mood.face, face.c_str(), sizeof(current_mood.face));
+  strlcpy(current_mood.phrase, phrase.c_str(), sizeof(current_mood.phrase));
+  portEXIT_CRITICAL(&mood_mux);
   //Serial.println("Mood has been set.");
 }
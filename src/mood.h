@@ -2,11 +2,24 @@
 #include "M5Unified.h"
 
 #define MOOD_BROKEN 19
+#define MOOD_COUNT 22
+#define MOOD_FACE_MAX 32
+#define MOOD_PHRASE_MAX 48
+
+struct MoodSnapshot {
+  uint8_t id;
+  bool broken;
+  char face[MOOD_FACE_MAX];
+  char phrase[MOOD_PHRASE_MAX];
+};
 
 void initMood();
 void setMood(uint8_t mood, String face = "", String phrase = "",
              bool broken = false);
 uint8_t getCurrentMoodId();
+String getMoodFace(uint8_t mood);
 String getCurrentMoodFace();
 String getCurrentMoodPhrase();
 bool isCurrentMoodBroken();
+// The current mood in one consistent copy, while other tasks may call setMood()
+void getMoodSnapshot(MoodSnapshot& out);
@@ -9,11 +9,28 @@
 #include "pwn.h"
 #include "ui.h"
 #include "ai.h"
+#include "scheduler.h"
+#include "affinity_bench.h"
+#include "microbench.h"
+#include "boot.h"
+#include "logger.h"
+#include "tracer.h"
 
 uint8_t state;
-unsigned long lastRun = 0;
 int lastPersonality = 0;
 
+// Mode switches requested from the UI task, applied by loop()
+enum ModeRequest {
+  MODE_REQUEST_NONE = 0,
+  MODE_REQUEST_AP_ENTER,
+  MODE_REQUEST_AP_EXIT
+};
+volatile uint8_t mode_request = MODE_REQUEST_NONE;
+
+void startAPConfigMode();
+void stopAPConfigMode();
+void initJobs();
+
 void initM5() {
   auto cfg = M5.config();
   M5.begin(cfg);
@@ -26,63 +43,93 @@ void initM5() {
   #endif
 }
 
-void setup() {
-  Serial.begin(115200);
-  delay(1000); // Give serial time to initialize
-  Serial.println("\n\n=== BOOT START ===");
-  randomSeed(esp_random());
-  initM5();
-  Serial.println("Init: Config...");
-  initConfig();
-  Serial.println("Init: AP Config...");
-  initAPConfig();
-  Serial.println("Init: Mood...");
-  initMood();
-  Serial.println("Init: Pwning...");
-  initPwning();
-  Serial.println("Init: UI...");
-  initUi();
-  Serial.println("Init: Complete");
-  
+void initBrain() {
   lastPersonality = getPersonality();
   Serial.printf("Personality: %s (%d)\n", getPersonalityText().c_str(), getPersonality());
-  
+
   if (getPersonality() == AI ) {
     Serial.println("Starting AI brain...");
     startBrain();
   } else {
     Serial.println("Running in Friendly mode (no AI)");
   }
-  
+}
+
+// Boot graph: the face and the sniffer come up first, storage (SD detection),
+// GPS probing and the grid identity (RSA keygen on first boot) finish in the
+// background. Dependencies refer to the enum, keep both in the same order.
+enum BootStageId {
+  BOOT_M5,
+  BOOT_CONFIG,
+  BOOT_MOOD,
+  BOOT_AP_CONFIG,
+  BOOT_PWN_STATE,
+  BOOT_RADIO,
+  BOOT_UI,
+  BOOT_JOBS,
+  BOOT_STORAGE,
+  BOOT_GPS,
+  BOOT_IDENTITY,
+  BOOT_BRAIN,
+};
+
+static const BootStage boot_stages[] = {
+  {"m5",       initM5,          BOOT_MAIN,       0},
+  {"config",   initConfig,      BOOT_WAIT,       0},
+  {"mood",     initMood,        BOOT_WAIT,       BOOT_DEP(BOOT_M5)},
+  {"apConfig", initAPConfig,    BOOT_WAIT,       0},
+  {"pwnState", initPwnState,    BOOT_WAIT,       BOOT_DEP(BOOT_CONFIG)},
+  {"radio",    initPwnRadio,    BOOT_WAIT,       BOOT_DEP(BOOT_PWN_STATE)},
+  {"ui",       initUi,          BOOT_WAIT,       BOOT_DEP(BOOT_CONFIG) | BOOT_DEP(BOOT_MOOD) | BOOT_DEP(BOOT_PWN_STATE)},
+  {"jobs",     initJobs,        BOOT_MAIN,       BOOT_DEP(BOOT_UI) | BOOT_DEP(BOOT_RADIO)},
+  {"storage",  initPwnStorage,  BOOT_BACKGROUND, BOOT_DEP(BOOT_PWN_STATE)},  // DB workers read its queues
+  {"gps",      initPwnGPS,      BOOT_BACKGROUND, 0},
+  {"identity", initPwnIdentity, BOOT_BACKGROUND, BOOT_DEP(BOOT_CONFIG)},
+  {"brain",    initBrain,       BOOT_BACKGROUND, BOOT_DEP(BOOT_RADIO)},
+};
+
+void setup() {
+  Serial.begin(115200);
+  if (BOOT_SERIAL_WAIT_MS > 0) {
+    delay(BOOT_SERIAL_WAIT_MS); // Give a USB serial monitor time to attach
+  }
+  Serial.println("\n\n=== BOOT START ===");
+  randomSeed(esp_random());
+  initLog();
+  initTrace();
+
+  bootRun(boot_stages, sizeof(boot_stages) / sizeof(boot_stages[0]));
+  logTaskLayout();
+#if AFFINITY_BENCHMARK
+  startAffinityBenchmark();
+#endif
+#if MICROBENCH
+  startMicrobenchmarks();
+#endif
+
   state = STATE_INIT;
   Serial.println("=== BOOT COMPLETE ===\n");
 }
 
 uint8_t current_channel = 1;
-uint32_t last_mood_switch = 10001;
 
 void wakeUp() {
   for (uint8_t i = 0; i < 3; i++) {
     //Serial.println("WakeUp - Setting Mood...");
     setMood(i);
-    //Serial.println("WakeUp - Updating UI...");
-    updateUi();
     //Serial.println("WakeUp - Delaying 1250...");
     //delay(1250);
   }
+  uiPostRedraw();
 }
 
 void advertise(uint8_t channel) {
   //Serial.println("Advertise...");
-  uint32_t elapsed = millis() - last_mood_switch;
-  if (elapsed > 50000) {
-    setMood(random(2, 21));
-    last_mood_switch = millis();
-  }
-
   esp_err_t result = pwngridAdvertise(channel, getCurrentMoodFace());
 
-  if (result == ESP_ERR_WIFI_IF) {
+  if (result == ESP_ERR_INVALID_STATE) {
+    return;  // Identity still being set up in the background
+  } else if (result == ESP_ERR_WIFI_IF) {
     setMood(MOOD_BROKEN, "", "Error: invalid interface", true);
     state = STATE_HALT;
   } else if (result == ESP_ERR_INVALID_ARG) {
@@ -95,10 +142,13 @@ void advertise(uint8_t channel) {
   //Serial.println("Advertise Done.");
 }
 
-void loop() {
-  //Serial.printf("Loop Begin\nFree heap: %d bytes\n", ESP.getFreeHeap());
-  unsigned long now = millis();
+// ========== Loop jobs ==========
+// Dispatched by the scheduler from loop(), each one checks the state it runs in
 
+void personalityJob(void*) {
+  if (!isBootStageDone(BOOT_BRAIN)) {
+    return;  // initBrain() starts the brain for the personality set at boot
+  }
   int currentPersonality = getPersonality();
   if (lastPersonality != currentPersonality) {
     lastPersonality = currentPersonality;
@@ -112,14 +162,73 @@ void loop() {
         break;
     }
   }
+}
 
-  M5.update();
-  #ifdef ARDUINO_M5STACK_CARDPUTER
-    M5Cardputer.update();
-  #endif
+void goneFriendsJob(void*) {
+  // Capture keeps running on the portal channel in AP mode too
+  if (state == STATE_WAKE || state == STATE_AP_CONFIG) {
+    checkPwngridGoneFriends();
+  }
+}
 
+void advertiseJob(void*) {
+  if (state != STATE_WAKE) return;
+
+  advertise(wifi_get_channel());
+  if (getPersonality() == FRIENDLY) {
+    current_channel++;
+    if (current_channel > 14) {
+      current_channel = 0;
+    }
+    Serial.printf("MANU Mode: Hopping to channel: %d\n", current_channel);
+    wifi_set_channel(current_channel);
+  }
+}
+
+void moodJob(void*) {
+  if (state == STATE_WAKE) {
+    setMood(random(2, 21));
+  }
+}
+
+void apConfigJob(void*) {
+  if (state != STATE_AP_CONFIG) return;
+
+  handleAPConfig();
+  // Check if AP mode timed out
+  if (!isAPModeActive()) {
+    stopAPConfigMode();
+  }
+}
+
+void statsJob(void*) {
+  schedDumpStats();
+}
+
+void traceSerialJob(void*) {
+  pollTraceSerial();
+}
+
+void initJobs() {
+  schedEvery("personality", 500, personalityJob);
+  schedEvery("gone-friends", 1000, goneFriendsJob);
+  // pwngridAdvertise() waits 102 ms on the channel
+  schedEvery("advertise", 15000, advertiseJob, nullptr, SCHED_PRIO_HIGH, 250);
+  schedEvery("mood", 50000, moodJob, nullptr, SCHED_PRIO_LOW);
+  schedEvery("ap-config", 1000, apConfigJob);
+  if (SCHED_STATS_INTERVAL_MS > 0) {
+    schedEvery("sched-stats", SCHED_STATS_INTERVAL_MS, statsJob, nullptr, SCHED_PRIO_LOW);
+  }
+  if (isTraceEnabled()) {
+    // A dump takes a few seconds at 115200 baud
+    schedEvery("trace-serial", 250, traceSerialJob, nullptr, SCHED_PRIO_LOW, 10000);
+  }
+}
+
+void loop() {
   if (state == STATE_HALT) {
     Serial.println("Loop - STATE_HALT");
+    schedIdle(SCHED_MAX_IDLE_MS);
     return;
   }
 
@@ -129,49 +238,39 @@ void loop() {
     state = STATE_WAKE;
   }
 
-  if (state == STATE_AP_CONFIG) {
-    //Serial.println("Loop - STATE_AP_CONFIG");
-    handleAPConfig();
-    // Check if AP mode timed out
-    if (!isAPModeActive()) {
-      exitAPConfigMode();
-    }
-    updateUi(false);
-    return;
-  }
-
-  if (state == STATE_WAKE) {
-    //Serial.println("Loop - STATE_WAKE");
-    checkPwngridGoneFriends();
-    if (now - lastRun >= 15000) {   // 15 000 ms = 15 s
-      //Serial.printf("Now: %d Last Run: %d Personality: %s\n", now, lastRun, getPersonalityText());
-      lastRun = now;                // update timer
-      advertise(wifi_get_channel());
-      if (getPersonality() == FRIENDLY) {
-        current_channel++;
-        if (current_channel > 14) {
-          current_channel = 0;
-        }
-        Serial.printf("MANU Mode: Hopping to channel: %d\n", current_channel);
-        wifi_set_channel(current_channel);
-      }
-    }
+  uint8_t request = mode_request;
+  mode_request = MODE_REQUEST_NONE;
+  if (request == MODE_REQUEST_AP_ENTER && state != STATE_AP_CONFIG) {
+    startAPConfigMode();
+  } else if (request == MODE_REQUEST_AP_EXIT && state == STATE_AP_CONFIG) {
+    stopAPConfigMode();
   }
 
-  updateUi(true);
-  //Serial.println("Done loop");
+  // Rendering happens in the UI task, sleep until the next job is due
+  schedIdle(schedRun());
 }
 
-void enterAPConfigMode() {
+void startAPConfigMode() {
   state = STATE_AP_CONFIG;
   startAPMode();
+  uiPostRedraw();
 }
 
-void exitAPConfigMode() {
+void stopAPConfigMode() {
   stopAPMode();
-  // Reinitialize WiFi for normal operation
-  initPwning();
   state = STATE_WAKE;
+  uiPostRedraw();
+}
+
+// Called from the UI task, the switch itself happens in loop()
+void enterAPConfigMode() {
+  mode_request = MODE_REQUEST_AP_ENTER;
+  schedWake();
+}
+
+void exitAPConfigMode() {
+  mode_request = MODE_REQUEST_AP_EXIT;
+  schedWake();
 }
 
 uint8_t getDeviceState() {
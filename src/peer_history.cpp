@@ -0,0 +1,226 @@
+#include "peer_history.h"
+#include "pwn.h"
+#include "identity.h"
+#include "events.h"
+#include <stdarg.h>
+
+#define PEER_HISTORY_NONE 0xff
+
+static const uint16_t tier_length[PEER_HISTORY_TIERS] = {
+  PEER_HISTORY_SECONDS, PEER_HISTORY_MINUTES, PEER_HISTORY_HOURS,
+};
+static const uint32_t tier_period[PEER_HISTORY_TIERS] = {1, 60, 3600};
+static const uint16_t tier_offset[PEER_HISTORY_TIERS] = {
+  0, PEER_HISTORY_SECONDS, PEER_HISTORY_SECONDS + PEER_HISTORY_MINUTES,
+};
+#define PEER_HISTORY_BUCKETS (PEER_HISTORY_SECONDS + PEER_HISTORY_MINUTES + PEER_HISTORY_HOURS)
+#define PEER_HISTORY_LONGEST_TIER max(max(PEER_HISTORY_SECONDS, PEER_HISTORY_MINUTES), PEER_HISTORY_HOURS)
+
+static PeerHistoryBucket* history = nullptr;  // slots * PEER_HISTORY_BUCKETS
+static uint8_t history_slots = 0;
+static uint8_t slot_of_peer[256];
+static uint8_t slot_peer[PEER_HISTORY_SLOTS];
+static uint32_t slot_heard[PEER_HISTORY_SLOTS];  // Seconds since boot
+static portMUX_TYPE history_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t nowSeconds() {
+  return (uint32_t)(esp_timer_get_time() / 1000000);
+}
+
+void initPeerHistory() {
+  size_t slots = PEER_HISTORY_SLOTS;
+  const char* where = "PSRAM";
+  history = (PeerHistoryBucket*)heap_caps_calloc(slots * PEER_HISTORY_BUCKETS, sizeof(PeerHistoryBucket),
+                                                 MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (history == nullptr) {
+    slots = min(PEER_HISTORY_SLOTS_NO_PSRAM, PEER_HISTORY_SLOTS);
+    where = "RAM";
+    history = (PeerHistoryBucket*)calloc(slots * PEER_HISTORY_BUCKETS, sizeof(PeerHistoryBucket));
+    if (history == nullptr) {
+      Serial.println("History: Not enough memory, peer history disabled");
+      return;
+    }
+  }
+  memset(slot_of_peer, PEER_HISTORY_NONE, sizeof(slot_of_peer));
+  memset(slot_peer, PEER_HISTORY_NONE, sizeof(slot_peer));
+  history_slots = slots;
+  Serial.printf("History: %u peers in %s, %u bytes\n", (unsigned)slots, where,
+                (unsigned)(slots * PEER_HISTORY_BUCKETS * sizeof(PeerHistoryBucket)));
+}
+
+// Slot for a peer heard now, taking the least recently heard one when all
+// are in use. Called with history_mux held.
+static uint8_t claimSlot(uint8_t peer, uint32_t now) {
+  uint8_t slot = 0;
+  for (uint8_t s = 0; s < history_slots; s++) {
+    if (slot_peer[s] == PEER_HISTORY_NONE) {
+      slot = s;
+      break;
+    }
+    if (slot_heard[s] < slot_heard[slot]) {
+      slot = s;
+    }
+  }
+  if (slot_peer[slot] != PEER_HISTORY_NONE) {
+    slot_of_peer[slot_peer[slot]] = PEER_HISTORY_NONE;
+  }
+  slot_peer[slot] = peer;
+  slot_of_peer[peer] = slot;
+  memset(&history[slot * PEER_HISTORY_BUCKETS], 0, PEER_HISTORY_BUCKETS * sizeof(PeerHistoryBucket));
+  return slot;
+}
+
+void peerHistoryRecord(uint8_t peer, signed int rssi) {
+  if (history_slots == 0) {
+    return;
+  }
+  uint32_t now = nowSeconds();
+  rssi = constrain(rssi, -128, 127);
+
+  portENTER_CRITICAL(&history_mux);
+  uint8_t slot = slot_of_peer[peer];
+  if (slot == PEER_HISTORY_NONE) {
+    slot = claimSlot(peer, now);
+  }
+  slot_heard[slot] = now;
+  PeerHistoryBucket* rings = &history[slot * PEER_HISTORY_BUCKETS];
+  for (uint8_t t = 0; t < PEER_HISTORY_TIERS; t++) {
+    uint32_t period = now / tier_period[t] + 1;  // 0 marks a bucket never used
+    PeerHistoryBucket& b = rings[tier_offset[t] + period % tier_length[t]];
+    if (b.period != period) {
+      b.period = period;
+      b.rssi_sum = 0;
+      b.beacons = 0;
+      b.rssi_min = rssi;
+      b.rssi_max = rssi;
+    }
+    if (b.beacons < UINT16_MAX) {
+      b.rssi_sum += rssi;
+      b.beacons++;
+    }
+    b.rssi_min = min((int)b.rssi_min, rssi);
+    b.rssi_max = max((int)b.rssi_max, rssi);
+  }
+  portEXIT_CRITICAL(&history_mux);
+}
+
+uint32_t getPeerHistoryPeriod(PeerHistoryTier tier) {
+  return tier_period[tier];
+}
+
+int getPeerHistory(uint8_t peer, PeerHistoryTier tier, PeerHistoryBucket* out, int max) {
+  if (history_slots == 0 || max <= 0) {
+    return 0;
+  }
+  uint32_t current = nowSeconds() / tier_period[tier] + 1;
+  int n = min(max, (int)tier_length[tier]);
+  n = min((uint32_t)n, current);  // Nothing before boot
+
+  portENTER_CRITICAL(&history_mux);
+  uint8_t slot = slot_of_peer[peer];
+  if (slot == PEER_HISTORY_NONE) {
+    portEXIT_CRITICAL(&history_mux);
+    return 0;
+  }
+  const PeerHistoryBucket* ring = &history[slot * PEER_HISTORY_BUCKETS + tier_offset[tier]];
+  for (int i = 0; i < n; i++) {
+    uint32_t period = current - (n - 1 - i);
+    const PeerHistoryBucket& b = ring[period % tier_length[tier]];
+    if (b.period == period) {
+      out[i] = b;
+    } else {
+      out[i] = {period, 0, 0, 0, 0};
+    }
+  }
+  portEXIT_CRITICAL(&history_mux);
+  return n;
+}
+
+// ========== JSON ==========
+struct HistoryWriter {
+  PeerHistorySink sink;
+  void* ctx;
+  bool ok;
+  size_t len;
+  char buf[512];
+};
+
+// Output that does not fit is flushed and formatted again, never cut
+static void historyOut(HistoryWriter& w, const char* fmt, ...) {
+  va_list ap;
+  for (int attempt = 0; attempt < 2 && w.ok; attempt++) {
+    va_start(ap, fmt);
+    int n = vsnprintf(w.buf + w.len, sizeof(w.buf) - w.len, fmt, ap);
+    va_end(ap);
+    if (n < 0) {
+      return;
+    }
+    if ((size_t)n < sizeof(w.buf) - w.len) {
+      w.len += n;
+      return;
+    }
+    // Flush and retry; a piece too big for an empty buffer fails the output
+    w.ok = w.len > 0 && w.sink(w.ctx, w.buf, w.len);
+    w.len = 0;
+  }
+}
+
+// One column of a tier, null where the peer was not heard
+static void historyColumn(HistoryWriter& w, const char* key, const PeerHistoryBucket* b, int n, char what) {
+  historyOut(w, ",\"%s\":[", key);
+  for (int i = 0; i < n; i++) {
+    const char* sep = i > 0 ? "," : "";
+    if (what == 'n') {
+      historyOut(w, "%s%u", sep, (unsigned)b[i].beacons);
+    } else if (b[i].beacons == 0) {
+      historyOut(w, "%snull", sep);
+    } else if (what == 'a') {
+      historyOut(w, "%s%.1f", sep, (double)b[i].rssi_sum / b[i].beacons);
+    } else {
+      historyOut(w, "%s%d", sep, what == 'l' ? b[i].rssi_min : b[i].rssi_max);
+    }
+  }
+  historyOut(w, "]");
+}
+
+bool writePeerHistoryJson(uint8_t peer, PeerHistorySink sink, void* ctx) {
+  if (peer >= getPwngridRunTotalPeers()) {
+    return false;
+  }
+  PeerHistoryBucket* buckets = new PeerHistoryBucket[PEER_HISTORY_LONGEST_TIER];
+  if (getPeerHistory(peer, PEER_HISTORY_1S, buckets, 1) == 0) {
+    delete[] buckets;
+    return false;
+  }
+
+  HistoryWriter* w = new HistoryWriter{sink, ctx, true, 0, {}};
+  pwngrid_peer& p = getPwngridPeers()[peer];
+  char identity[PWN_IDENTITY_HEX_LEN + 1];
+  char name[40];
+  identityToHex(p.identity, identity);
+  appendJsonString(name, sizeof(name), p.name);
+  historyOut(*w, "{\"peer\":%u,\"name\":\"%s\",\"identity\":\"%s\",\"gone\":%s,\"now\":%u,\"tiers\":[",
+             (unsigned)peer, name, identity, p.gone ? "true" : "false",
+             (unsigned)nowSeconds());
+  for (uint8_t t = 0; t < PEER_HISTORY_TIERS; t++) {
+    PeerHistoryTier tier = (PeerHistoryTier)t;
+    int n = getPeerHistory(peer, tier, buckets, tier_length[t]);
+    // Period numbers are offset by one, see peerHistoryRecord()
+    uint32_t start = n > 0 ? (buckets[0].period - 1) * tier_period[t] : 0;
+    historyOut(*w, "%s\n{\"period\":%u,\"start\":%u", t > 0 ? "," : "", (unsigned)tier_period[t],
+               (unsigned)start);
+    historyColumn(*w, "beacons", buckets, n, 'n');
+    historyColumn(*w, "min", buckets, n, 'l');
+    historyColumn(*w, "avg", buckets, n, 'a');
+    historyColumn(*w, "max", buckets, n, 'h');
+    historyOut(*w, "}");
+  }
+  historyOut(*w, "\n]}\n");
+  if (w->ok && w->len > 0) {
+    w->ok = sink(ctx, w->buf, w->len);
+  }
+  bool ok = w->ok;
+  delete w;
+  delete[] buckets;
+  return ok;
+}
@@ -0,0 +1,63 @@
+#ifndef _PEER_HISTORY_H_
+#define _PEER_HISTORY_H_
+
+#include "Arduino.h"
+
+// How each peer's signal and presence evolved over the session. Every
+// pwngrid beacon lands in three rings per peer at once: 1 s, 1 min and 1 h
+// buckets of min/avg/max RSSI and beacon count, a bucket with no beacons
+// meaning the peer was not heard. A bucket is tagged with its period
+// number, so a stale one reads as empty and gaps cost nothing to skip.
+// Rings live in PSRAM for up to PEER_HISTORY_SLOTS peers, the least
+// recently heard peer gives its slot up when a new one needs it. Served as
+// JSON at /api/peer/<id>/history and drawn as a sparkline in the Friends
+// menu.
+
+#ifndef PEER_HISTORY_SLOTS
+#define PEER_HISTORY_SLOTS 64      // 2.4 KB each with the default rings
+#endif
+#ifndef PEER_HISTORY_SLOTS_NO_PSRAM
+#define PEER_HISTORY_SLOTS_NO_PSRAM 4
+#endif
+#ifndef PEER_HISTORY_SECONDS
+#define PEER_HISTORY_SECONDS 120
+#endif
+#ifndef PEER_HISTORY_MINUTES
+#define PEER_HISTORY_MINUTES 60
+#endif
+#ifndef PEER_HISTORY_HOURS
+#define PEER_HISTORY_HOURS 24
+#endif
+
+enum PeerHistoryTier : uint8_t {
+  PEER_HISTORY_1S,
+  PEER_HISTORY_1M,
+  PEER_HISTORY_1H,
+  PEER_HISTORY_TIERS
+};
+
+struct PeerHistoryBucket {
+  uint32_t period;  // Seconds since boot / tier period
+  int32_t rssi_sum;
+  uint16_t beacons;
+  int8_t rssi_min;
+  int8_t rssi_max;
+};
+
+void initPeerHistory();
+
+// A beacon from peer index `peer` (see getPwngridPeers)
+void peerHistoryRecord(uint8_t peer, signed int rssi);
+
+// Copies the last `max` buckets of a tier, oldest first, ending with the
+// current one. Buckets without beacons come back with beacons 0. Returns
+// how many were copied, 0 when the peer has no history.
+int getPeerHistory(uint8_t peer, PeerHistoryTier tier, PeerHistoryBucket* out, int max);
+uint32_t getPeerHistoryPeriod(PeerHistoryTier tier);  // Seconds
+
+typedef bool (*PeerHistorySink)(void* ctx, const char* data, size_t len);
+
+// All three tiers as JSON, false when the peer has no history or the sink failed
+bool writePeerHistoryJson(uint8_t peer, PeerHistorySink sink, void* ctx);
+
+#endif
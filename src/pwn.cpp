@@ -2,6 +2,13 @@
 #include "identity.h"
 #include "config.h"
 #include "GPSAnalyse.h"
+#include "events.h"
+#include "task_config.h"
+#include "metrics.h"
+#include "logger.h"
+#include "tracer.h"
+#include "peer_history.h"
+#include "string_pool.h"
 #include <Preferences.h>
 #include <freertos/FreeRTOS.h>
 
@@ -20,7 +27,8 @@ extern "C" esp_err_t esp_wifi_internal_tx(wifi_interface_t ifx, const void *buff
 
 // ========== Global State ==========
 static GPSAnalyse GPS;
-static bool hasGPS = false;
+static volatile bool hasGPS = false;
+static volatile bool identity_ready = false;
 static portMUX_TYPE gRadioMux = portMUX_INITIALIZER_UNLOCKED;
 static QueueHandle_t pktQueue = nullptr;
 static QueueHandle_t frQueue = nullptr;
@@ -44,7 +52,9 @@ static std::set<DeauthTarget> deauthHistory;
 // Pwngrid state
 static uint64_t pwngrid_friends_tot = 0;
 static uint64_t pwngrid_friends_run = 0;
-static pwngrid_peer pwngrid_peers[255];
+static constexpr uint8_t PWNGRID_MAX_PEERS = 255;
+static pwngrid_peer pwngrid_peers[PWNGRID_MAX_PEERS];
+static volatile uint32_t pwngrid_peers_revision = 0;  // Bumped whenever a peer is added or updated
 static String pwngrid_last_friend_name = "";
 static uint64_t pwngrid_pwned_tot = 0;
 static uint64_t pwngrid_pwned_run = 0;
@@ -72,10 +82,31 @@ int wifi_get_channel() {
     return primary;
 }
 
+// Set while the AP portal is up, the SoftAP can't follow the sniffer around
+static volatile uint8_t locked_channel = 0;
+
 void wifi_set_channel(int ch) {
+    if (locked_channel != 0 && ch != locked_channel) {
+        return;
+    }
     esp_wifi_set_channel(ch, WIFI_SECOND_CHAN_NONE);
+    publishEvent(EVENT_CHANNEL, 0, ch);
+}
+
+void lockPwnChannel(uint8_t channel) {
+    locked_channel = 0;
+    wifi_set_channel(channel);
+    locked_channel = channel;
+    Serial.printf("Pwn: Channel locked to %d\n", channel);
+}
+
+void unlockPwnChannel() {
+    locked_channel = 0;
+    Serial.println("Pwn: Channel unlocked");
 }
 
+bool isPwnChannelLocked() { return locked_channel != 0; }
+
 static void MAC2str(const uint8_t mac[6], char *out) {
     sprintf(out, "%02x:%02x:%02x:%02x:%02x:%02x",
             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
@@ -93,8 +124,17 @@ static void dbFriendTask(void *pv) {
     pwngrid_peer item;
     for (;;) {
         if (xQueueReceive(frQueue, &item, portMAX_DELAY) == pdTRUE) {
+            metricSet(METRIC_FRIEND_QUEUE_DEPTH, uxQueueMessagesWaiting(frQueue));
+            int64_t start = esp_timer_get_time();
             if (!mergeFriend(item, pwngrid_friends_tot)) {
-                Serial.println("Merge failed for friend");
+                LOG_E("Merge failed for friend %s", item.name.c_str());
+                metricInc(METRIC_DB_ERRORS);
+            } else {
+                metricObserveSince(METRIC_DB_FRIEND_WRITE, start);
+                if (!item.gone) {  // Gone records were last pinged minutes before
+                    metricObserve(METRIC_DB_QUEUE_LATENCY, (uint32_t)(start - item.last_ping * 1000));
+                }
+                metricInc(METRIC_DB_FRIENDS);
             }
         }
     }
@@ -102,23 +142,40 @@ static void dbFriendTask(void *pv) {
 
 static void dbPacketTask(void *pv) {
     packet_item_t item;
+    uint32_t saved = 0;
     for (;;) {
         if (xQueueReceive(pktQueue, &item, portMAX_DELAY) == pdTRUE) {
+            metricSet(METRIC_PACKET_QUEUE_DEPTH, uxQueueMessagesWaiting(pktQueue));
+            int64_t start = esp_timer_get_time();
             if (!addPacket(item)) {
-                Serial.println("Insert failed for packet");
+                LOG_E("Insert failed for %s packet", item.type);
+                metricInc(METRIC_DB_ERRORS);
             } else {
-                Serial.println("Packet saved to DB");
+                int64_t now = esp_timer_get_time();
+                metricObserve(METRIC_DB_PACKET_WRITE, now - start);
+                metricObserve(METRIC_DB_QUEUE_LATENCY, (now / 1000 - item.ts_ms) * 1000);
+                metricInc(METRIC_DB_PACKETS);
+                publishEvent(EVENT_COUNTER, COUNTER_PACKETS, ++saved);
             }
         }
     }
 }
 
-static void initDBWorkers() {
-    frQueue = xQueueCreate(32, sizeof(pwngrid_peer));
-    xTaskCreatePinnedToCore(dbFriendTask, "dbFriendTask", 4096, NULL, 1, NULL, 1);
+// Queues exist from the start so early captures wait for storage to come up
+static void initDBQueues() {
+    if (frQueue != nullptr) return;
 
+    frQueue = xQueueCreate(32, sizeof(pwngrid_peer));
     pktQueue = xQueueCreate(32, sizeof(packet_item_t));
-    xTaskCreatePinnedToCore(dbPacketTask, "dbPacketTask", 4096, NULL, 1, NULL, 1);
+}
+
+static void initDBWorkers() {
+    static bool started = false;
+    if (started) return;
+    started = true;
+
+    startTask(TASK_DB_FRIEND, dbFriendTask);
+    startTask(TASK_DB_PACKET, dbPacketTask);
 }
 
 
@@ -137,18 +194,20 @@ void enqueue_packet_from_sniffer(const uint8_t *pkt, size_t len, const uint8_t m
     it.ts_ms = (int64_t)(esp_timer_get_time() / 1000);
     
     if (xQueueSend(pktQueue, &it, 0) != pdTRUE) {
-        Serial.println("Failed enqueuing packet");
-    } else {
-        Serial.println("Packet added to queue");
+        LOG_W("Failed enqueuing packet");
+        metricInc(METRIC_QUEUE_DROPS);
     }
+    metricSet(METRIC_PACKET_QUEUE_DEPTH, uxQueueMessagesWaiting(pktQueue));
 }
 
 void enqueue_friend_from_sniffer(pwngrid_peer &a_friend) {
     if (!frQueue) return;
     
     if (xQueueSend(frQueue, &a_friend, 0) != pdTRUE) {
-        Serial.println("Failed enqueuing friend");
+        LOG_W("Failed enqueuing friend");
+        metricInc(METRIC_QUEUE_DROPS);
     }
+    metricSet(METRIC_FRIEND_QUEUE_DEPTH, uxQueueMessagesWaiting(frQueue));
 }
 
 
@@ -157,25 +216,206 @@ uint64_t getPwngridTotalPeers() { return pwngrid_friends_tot; }
 uint64_t getPwngridRunTotalPeers() { return pwngrid_friends_run; }
 String getPwngridLastFriendName() { return pwngrid_last_friend_name; }
 pwngrid_peer *getPwngridPeers() { return pwngrid_peers; }
+uint32_t getPwngridPeersRevision() { return pwngrid_peers_revision; }
 uint64_t getPwngridTotalPwned() { return pwngrid_pwned_tot; }
 uint64_t getPwngridRunPwned() { return pwngrid_pwned_run; }
 
-signed int getPwngridClosestRssi() {
-    signed int closest = -1000;
-    for (uint8_t i = 0; i < pwngrid_friends_tot; i++) {
-        if (!pwngrid_peers[i].gone && pwngrid_peers[i].rssi > closest) {
-            closest = pwngrid_peers[i].rssi;
+
+// ========== Peer Presence ==========
+// A peer is gone once AWAY_THRESHOLD_MS pass without a beacon from it. The
+// deadlines of present peers sit in a binary min-heap of peer indices, so
+// the periodic check only looks at the root and a beacon from a known peer
+// is one sift down. Deadlines are esp_timer time and never wrap.
+static constexpr uint8_t PRESENCE_NONE = 0xff;
+static uint8_t presence_heap[PWNGRID_MAX_PEERS];
+static uint8_t presence_slot[PWNGRID_MAX_PEERS];  // Heap position + 1, 0 while gone
+static int64_t presence_deadline[PWNGRID_MAX_PEERS];
+static uint8_t presence_count = 0;
+static portMUX_TYPE presence_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static void presenceSwap(uint8_t a, uint8_t b) {
+    uint8_t peer_a = presence_heap[a];
+    uint8_t peer_b = presence_heap[b];
+    presence_heap[a] = peer_b;
+    presence_heap[b] = peer_a;
+    presence_slot[peer_b] = a + 1;
+    presence_slot[peer_a] = b + 1;
+}
+
+static void presenceSiftUp(uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (presence_deadline[presence_heap[parent]] <= presence_deadline[presence_heap[pos]]) {
+            break;
+        }
+        presenceSwap(pos, parent);
+        pos = parent;
+    }
+}
+
+static void presenceSiftDown(uint8_t pos) {
+    for (;;) {
+        uint16_t child = 2 * pos + 1;
+        if (child >= presence_count) {
+            break;
+        }
+        if (child + 1 < presence_count &&
+            presence_deadline[presence_heap[child + 1]] < presence_deadline[presence_heap[child]]) {
+            child++;
         }
+        if (presence_deadline[presence_heap[pos]] <= presence_deadline[presence_heap[child]]) {
+            break;
+        }
+        presenceSwap(pos, child);
+        pos = child;
+    }
+}
+
+// Pushes the peer's deadline out, true when it was not present before.
+// Called with presence_mux held.
+static bool presenceTouch(uint8_t peer, int64_t now_us) {
+    presence_deadline[peer] = now_us + (int64_t)AWAY_THRESHOLD_MS * 1000;
+    if (presence_slot[peer] != 0) {
+        presenceSiftDown(presence_slot[peer] - 1);  // Deadlines only grow
+        return false;
     }
+    presence_heap[presence_count] = peer;
+    presence_slot[peer] = presence_count + 1;
+    presence_count++;
+    presenceSiftUp(presence_count - 1);
+    return true;
+}
+
+// Removes and returns a peer whose deadline has passed, PRESENCE_NONE when
+// there is none. Called with presence_mux held.
+static uint8_t presencePopExpired(int64_t now_us) {
+    if (presence_count == 0 || presence_deadline[presence_heap[0]] > now_us) {
+        return PRESENCE_NONE;
+    }
+    uint8_t peer = presence_heap[0];
+    presence_slot[peer] = 0;
+    presence_count--;
+    if (presence_count > 0) {
+        presence_heap[0] = presence_heap[presence_count];
+        presence_slot[presence_heap[0]] = 1;
+        presenceSiftDown(0);
+    }
+    return peer;
+}
+
+
+// ========== Peer Ordering ==========
+// Smoothed RSSI per peer and two orderings of the table, kept up to date as
+// beacons arrive so nothing sorts per frame: by smoothed RSSI with present
+// peers ahead of gone ones, and by last seen. A beacon moves its peer past
+// the ones it overtook, a few places in the RSSI order and at most the
+// peers heard since in the last seen one. Guarded by presence_mux.
+static constexpr uint8_t RSSI_EWMA_SHIFT = 2;  // A beacon weighs 1/4
+static constexpr int32_t RSSI_GONE_OFFSET = 0x10000;
+
+struct PeerOrder {
+    uint8_t peers[PWNGRID_MAX_PEERS];  // Largest key first
+    uint8_t rank[PWNGRID_MAX_PEERS];   // Position of each peer in peers
+    uint8_t count;
+};
+static PeerOrder order_by_rssi;
+static PeerOrder order_by_seen;
+static int16_t rssi_ewma[PWNGRID_MAX_PEERS];  // dBm x16
+static int32_t rssi_key[PWNGRID_MAX_PEERS];
+static int64_t seen_key[PWNGRID_MAX_PEERS];
+
+// Moves the peer to its place after its key changed
+template <typename T>
+static void orderUpdate(PeerOrder &o, uint8_t peer, const T *key) {
+    uint8_t pos = o.rank[peer];
+    while (pos > 0 && key[o.peers[pos - 1]] < key[peer]) {
+        o.peers[pos] = o.peers[pos - 1];
+        o.rank[o.peers[pos]] = pos;
+        pos--;
+    }
+    while (pos + 1 < o.count && key[o.peers[pos + 1]] > key[peer]) {
+        o.peers[pos] = o.peers[pos + 1];
+        o.rank[o.peers[pos]] = pos;
+        pos++;
+    }
+    o.peers[pos] = peer;
+    o.rank[peer] = pos;
+}
+
+template <typename T>
+static void orderInsert(PeerOrder &o, uint8_t peer, const T *key) {
+    o.peers[o.count] = peer;
+    o.rank[peer] = o.count;
+    o.count++;
+    orderUpdate(o, peer, key);
+}
+
+// A beacon from the peer, called with presence_mux held
+static void peerOrderSeen(uint8_t peer, signed int rssi, int64_t now_us, bool is_new) {
+    if (is_new) {
+        rssi_ewma[peer] = rssi * 16;
+    } else {
+        rssi_ewma[peer] += (rssi * 16 - rssi_ewma[peer]) >> RSSI_EWMA_SHIFT;
+    }
+    pwngrid_peers[peer].rssi_avg = (rssi_ewma[peer] + 8) >> 4;
+    rssi_key[peer] = rssi_ewma[peer];
+    seen_key[peer] = now_us;
+    if (is_new) {
+        orderInsert(order_by_rssi, peer, rssi_key);
+        orderInsert(order_by_seen, peer, seen_key);
+    } else {
+        orderUpdate(order_by_rssi, peer, rssi_key);
+        orderUpdate(order_by_seen, peer, seen_key);
+    }
+}
+
+// Called with presence_mux held
+static void peerOrderGone(uint8_t peer) {
+    rssi_key[peer] = rssi_ewma[peer] - RSSI_GONE_OFFSET;
+    orderUpdate(order_by_rssi, peer, rssi_key);
+}
+
+signed int getPwngridClosestRssi() {
+    portENTER_CRITICAL(&presence_mux);
+    signed int closest = presence_count > 0 ? pwngrid_peers[order_by_rssi.peers[0]].rssi_avg : -1000;
+    portEXIT_CRITICAL(&presence_mux);
     return closest;
 }
 
+int getPwngridNearbyPeer(int row) {
+    // Present peers were all heard after every gone one, so they lead the
+    // last seen order too and the gone ones follow from row presence_count
+    int peer = -1;
+    portENTER_CRITICAL(&presence_mux);
+    if (row >= 0 && row < presence_count) {
+        peer = order_by_rssi.peers[row];
+    } else if (row >= presence_count && row < order_by_seen.count) {
+        peer = order_by_seen.peers[row];
+    }
+    portEXIT_CRITICAL(&presence_mux);
+    return peer;
+}
+
 void checkPwngridGoneFriends() {
-    unsigned long now = millis();
-    for (uint8_t i = 0; i < pwngrid_friends_tot; i++) {
-        if (now - pwngrid_peers[i].last_ping > AWAY_THRESHOLD_MS) {
+    int64_t now = esp_timer_get_time();
+    for (;;) {
+        portENTER_CRITICAL(&presence_mux);
+        uint8_t i = presencePopExpired(now);
+        if (i != PRESENCE_NONE) {
             pwngrid_peers[i].gone = true;
+            peerOrderGone(i);
+        }
+        uint8_t present = presence_count;
+        portEXIT_CRITICAL(&presence_mux);
+        if (i == PRESENCE_NONE) {
+            return;
         }
+
+        LOG_D("Peer %s gone", pwngrid_peers[i].name.c_str());
+        pwngrid_peers_revision++;
+        metricSet(METRIC_PEERS_NEARBY, present);
+        publishEvent(EVENT_PEER_GONE, i, 0);
+        enqueue_friend_from_sniffer(pwngrid_peers[i]);
     }
 }
 
@@ -193,7 +433,7 @@ static const uint8_t pwngrid_beacon_raw[] = {
     0x11, 0x04,                                      // Capability info
 };
 
-esp_err_t pwngridAdvertise(uint8_t channel, String face) {
+size_t buildPwngridBeacon(const String &face, uint8_t *frame, size_t cap) {
     DynamicJsonDocument pal_json(2048);
     auto id = ensurePwnIdentity(true);
     
@@ -217,64 +457,109 @@ esp_err_t pwngridAdvertise(uint8_t channel, String face) {
 
     String pal_json_str;
     serializeJson(pal_json, pal_json_str);
-    uint16_t pal_json_len = measureJson(pal_json);
-    uint8_t header_len = 2 + ((pal_json_len / 255) * 2);
-    
-    uint8_t pwngrid_beacon_frame[sizeof(pwngrid_beacon_raw) + pal_json_len + header_len];
-    memcpy(pwngrid_beacon_frame, pwngrid_beacon_raw, sizeof(pwngrid_beacon_raw));
+    size_t pal_json_len = pal_json_str.length();
+    size_t header_len = 2 * ((pal_json_len + 254) / 255);
+    size_t frame_len = sizeof(pwngrid_beacon_raw) + pal_json_len + header_len;
+    if (frame_len > cap) {
+        return 0;
+    }
+    memcpy(frame, pwngrid_beacon_raw, sizeof(pwngrid_beacon_raw));
 
     int frame_byte = sizeof(pwngrid_beacon_raw);
-    for (int i = 0; i < pal_json_len; i++) {
+    for (size_t i = 0; i < pal_json_len; i++) {
         if (i % 255 == 0) {
-            pwngrid_beacon_frame[frame_byte++] = 0xde;  // AC tag
+            frame[frame_byte++] = 0xde;  // AC tag
             uint8_t payload_len = (pal_json_len - i < 255) ? (pal_json_len - i) : 255;
-            pwngrid_beacon_frame[frame_byte++] = payload_len;
+            frame[frame_byte++] = payload_len;
         }
-        pwngrid_beacon_frame[frame_byte++] = isAscii(pal_json_str[i]) ? 
+        frame[frame_byte++] = isAscii(pal_json_str[i]) ? 
             (uint8_t)pal_json_str[i] : (uint8_t)'?';
     }
+    return frame_len;
+}
+
+esp_err_t pwngridAdvertise(uint8_t channel, String face) {
+    if (!identity_ready) {
+        return ESP_ERR_INVALID_STATE;  // Key generation still running at boot
+    }
+    TRACE_SCOPE("advertise");
+    int64_t start = esp_timer_get_time();
+
+    uint8_t pwngrid_beacon_frame[PWNGRID_BEACON_MAX];
+    size_t len = buildPwngridBeacon(face, pwngrid_beacon_frame, sizeof(pwngrid_beacon_frame));
+    if (len == 0) {
+        metricInc(METRIC_ADVERTISE_ERRORS);
+        return ESP_ERR_INVALID_SIZE;
+    }
 
-    esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
+    wifi_set_channel(channel);
     delay(102);
-    return esp_wifi_80211_tx(WIFI_IF_AP, pwngrid_beacon_frame, 
-                            sizeof(pwngrid_beacon_frame), false);
+    esp_err_t err = esp_wifi_80211_tx(WIFI_IF_AP, pwngrid_beacon_frame, len, false);
+    if (err != ESP_OK) {
+        metricInc(METRIC_ADVERTISE_ERRORS);
+    }
+    metricObserveSince(METRIC_ADVERTISE, start);
+    return err;
 }
 
 
 // ========== Pwngrid Peer Management ==========
 void pwngridAddPeer(DynamicJsonDocument &json, signed int rssi, int channel) {
-    String identity = json["identity"].as<String>();
+    TRACE_INSTANT("pwngridPeer");
+    uint8_t identity[PWN_IDENTITY_LEN];
+    if (!identityFromHex(json["identity"] | "", identity)) {
+        LOG_D("Ignoring pwngrid peer without a valid identity");
+        return;
+    }
+    int64_t now = esp_timer_get_time();
 
     // Check if peer already exists
     for (uint8_t i = 0; i < pwngrid_friends_run; i++) {
-        if (pwngrid_peers[i].identity == identity) {
-            pwngrid_peers[i].last_ping = millis();
+        if (memcmp(pwngrid_peers[i].identity, identity, PWN_IDENTITY_LEN) == 0) {
+            portENTER_CRITICAL(&presence_mux);
+            bool returned = presenceTouch(i, now);
+            peerOrderSeen(i, rssi, now, false);
+            pwngrid_peers[i].last_ping = now / 1000;
             pwngrid_peers[i].gone = false;
             pwngrid_peers[i].rssi = rssi;
+            uint8_t present = presence_count;
+            portEXIT_CRITICAL(&presence_mux);
+            peerHistoryRecord(i, rssi);
+
+            pwngrid_peers_revision++;
+            publishEvent(returned ? EVENT_PEER_SEEN : EVENT_PEER_RSSI, i, rssi);
+            if (returned) {
+                metricSet(METRIC_PEERS_NEARBY, present);
+                enqueue_friend_from_sniffer(pwngrid_peers[i]);
+            }
             return;
         }
     }
+    if (pwngrid_friends_run >= PWNGRID_MAX_PEERS) {
+        return;  // Table full, only the peers already in it are tracked
+    }
 
     // Add new peer
-    pwngrid_peer &peer = pwngrid_peers[pwngrid_friends_run];
+    uint8_t index = pwngrid_friends_run;
+    pwngrid_peer &peer = pwngrid_peers[index];
     peer.rssi = rssi;
-    peer.last_ping = millis();
+    peer.last_ping = now / 1000;
     peer.gone = false;
     peer.name = json["name"].as<String>();
-    peer.face = json["face"].as<String>();
+    peer.face = internString(json["face"] | "");
     peer.epoch = json["epoch"].as<int>();
-    peer.grid_version = json["grid_version"].as<String>();
-    peer.identity = identity;
+    peer.grid_version = internString(json["grid_version"] | "");
+    memcpy(peer.identity, identity, PWN_IDENTITY_LEN);
     peer.pwnd_run = json["pwnd_run"].as<int>();
     peer.pwnd_tot = json["pwnd_tot"].as<int>();
-    peer.session_id = json["session_id"].as<String>();
+    strlcpy(peer.session_id, json["session_id"] | "", sizeof(peer.session_id));
     peer.timestamp = json["timestamp"].as<int>();
     peer.uptime = json["uptime"].as<int>();
-    peer.version = json["version"].as<String>();
+    peer.version = internString(json["version"] | "");
     peer.channel = channel;
 
     pwngrid_last_friend_name = peer.name;
-    Serial.println("pwngrid_last_friend_name: " + pwngrid_last_friend_name);
+    LOG_D("pwngrid_last_friend_name: %s", pwngrid_last_friend_name.c_str());
 
     // Add GPS coordinates if available
     if (hasGPS && GPS.isConnected() && GPS.hasValidFix()) {
@@ -291,19 +576,30 @@ void pwngridAddPeer(DynamicJsonDocument &json, signed int rssi, int channel) {
             peer.longitude = -peer.longitude;
         }
         
-        Serial.printf("📍 Spotted %s at: Lat=%.6f, Lon=%.6f (Fix: %c)\n",
-                     peer.name.c_str(), peer.latitude, peer.longitude, GPS.s_GNRMC.State);
+        LOG_I("Spotted %s at: Lat=%.6f, Lon=%.6f (Fix: %c)",
+              peer.name.c_str(), peer.latitude, peer.longitude, GPS.s_GNRMC.State);
     } else {
         peer.has_gps = false;
         if (hasGPS && !GPS.isConnected()) {
-            Serial.println("⚠️  GPS not connected - no coordinates saved");
+            LOG_W("GPS not connected - no coordinates saved");
         } else if (hasGPS && !GPS.hasValidFix()) {
-            Serial.println("⚠️  GPS has no fix - waiting for satellites...");
+            LOG_D("GPS has no fix - waiting for satellites...");
         }
     }
 
+    portENTER_CRITICAL(&presence_mux);
+    presenceTouch(index, now);
+    peerOrderSeen(index, rssi, now, true);
+    uint8_t present = presence_count;
+    portEXIT_CRITICAL(&presence_mux);
+    peerHistoryRecord(index, rssi);
+
     enqueue_friend_from_sniffer(peer);
+    publishEvent(EVENT_PEER_SEEN, index, rssi);
     pwngrid_friends_run++;
+    pwngrid_peers_revision++;
+    metricSet(METRIC_PEERS_NEARBY, present);
+    publishEvent(EVENT_COUNTER, COUNTER_PEERS, pwngrid_friends_run);
     saveStats();
 }
 
@@ -451,7 +747,7 @@ static String extractSSIDfromProbe(const uint8_t *frame, int len) {
     return "";
 }
 
-static String extractSSIDfromAP(const uint8_t *frame, int len) {
+String extractSSIDfromAP(const uint8_t *frame, int len) {
     int pos = 36;  // beacon header
     while (pos + 2 < len) {
         uint8_t tag = frame[pos];
@@ -622,9 +918,8 @@ static void handlePacket(wifi_promiscuous_pkt_t *snifferPacket) {
     }
 
     if (hasEapol) {
-        Serial.println("We have EAPOL");
-        drawMood(pwnagotchi_moods[10], "I love EAPOLs!", false, 
-                 getPwngridLastFriendName(), getPwngridClosestRssi());
+        LOG_I("We have EAPOL on channel %d", rx_channel);
+        uiPostMood(pwnagotchi_moods[10].c_str(), "I love EAPOLs!", false, 2000);
 
         env.eapol_packets++;
         env.got_handshake = true;
@@ -632,6 +927,7 @@ static void handlePacket(wifi_promiscuous_pkt_t *snifferPacket) {
         pwngrid_pwned_run++;
         pwngrid_pwned_tot++;
         saveStats();
+        publishEvent(EVENT_COUNTER, COUNTER_PWNED, pwngrid_pwned_run);
 
         if (pkt_len >= 24) {
             // Extract BSSID
@@ -699,7 +995,8 @@ static void handlePacket(wifi_promiscuous_pkt_t *snifferPacket) {
 
 
 // ========== Pwngrid Packet Reassembly ==========
-static void processPwngridBeacon(wifi_promiscuous_pkt_t *snifferPacket) {
+void processPwngridBeacon(wifi_promiscuous_pkt_t *snifferPacket) {
+    TRACE_SCOPE("pwngridBeacon");
     int raw_len = snifferPacket->rx_ctrl.sig_len;
     int len = raw_len - 4;
     
@@ -735,6 +1032,7 @@ static void processPwngridBeacon(wifi_promiscuous_pkt_t *snifferPacket) {
             }
         } else if (fullPacket.length() > 0) {
             if (millis() - fullPacketStartTime > PACKET_TIMEOUT_MS) {
+                TRACE_INSTANT("pwngridBeaconTimeout");
                 fullPacket = "";
                 return;
             }
@@ -757,6 +1055,8 @@ static void processPwngridBeacon(wifi_promiscuous_pkt_t *snifferPacket) {
 // ========== Promiscuous Sniffer Callback ==========
 void pwnSnifferCallback(void *buf, wifi_promiscuous_pkt_type_t type) {
     if (type != WIFI_PKT_MGMT) return;
+    TRACE_SCOPE("sniffer");
+    int64_t start = esp_timer_get_time();
 
     wifi_promiscuous_pkt_t *snifferPacket = (wifi_promiscuous_pkt_t *)buf;
 
@@ -771,9 +1071,15 @@ void pwnSnifferCallback(void *buf, wifi_promiscuous_pkt_type_t type) {
         getMAC(addr, snifferPacket->payload, 10);
         
         if (String(addr) == "de:ad:be:ef:de:ad") {
+            int64_t beacon_start = esp_timer_get_time();
             processPwngridBeacon(snifferPacket);
+            metricObserveSince(METRIC_PWNGRID_BEACON, beacon_start);
+            metricInc(METRIC_PWNGRID_BEACONS);
         }
     }
+
+    metricInc(METRIC_SNIFFER_FRAMES);
+    metricObserveSince(METRIC_SNIFFER_CALLBACK, start);
 }
 
 static const wifi_promiscuous_filter_t filter = {
@@ -782,31 +1088,60 @@ static const wifi_promiscuous_filter_t filter = {
 
 
 // ========== Initialization ==========
-void initPwning() {
-    Serial.println("Init Pwning processes");
+void resumePwnSniffer() {
+    esp_wifi_set_promiscuous_filter(&filter);
+    esp_wifi_set_promiscuous_rx_cb(&pwnSnifferCallback);
+    esp_wifi_set_promiscuous(true);
+}
+
+// Hidden AP, only there so beacons and deauths can be sent on WIFI_IF_AP
+void resetPwnAP() {
+    wifi_config_t ap_cfg = {0};
+    ap_cfg.ap.ssid_len = 0;
+    ap_cfg.ap.channel = 6;
+    ap_cfg.ap.authmode = WIFI_AUTH_OPEN;
+    ap_cfg.ap.max_connection = 0;
+    esp_wifi_set_config(WIFI_IF_AP, &ap_cfg);
+}
+
+static bool pwning_initialized = false;
+
+// Counters, environment and DB queues; the rest of pwning builds on these
+void initPwnState() {
     env.reset();
     loadStats();
+    initStringPool();
+    internStaticString(GRID_VERSION);
+    internStaticString(PWNGRID_VERSION);
+    initPeerHistory();
+    initDBQueues();
+}
+
+// Mount storage (SD detection can take seconds) and start draining the queues
+void initPwnStorage() {
     initDB();
     initDBWorkers();
+}
+
+void initPwnGPS() {
+    bool found = false;
 
     // Initialize GPS with device-specific pins
     // M5Stack GPS modules typically use Grove port or Hat connector
-    hasGPS = false;
-    
     #if defined(ARDUINO_M5STACK_STICKC) || defined(ARDUINO_M5STACK_STICKC_PLUS) || defined(ARDUINO_M5STACK_STICKC_PLUS2)
         // M5StickC/Plus: Grove port (G32=RX, G33=TX) or Hat (G0=RX, G26=TX)
         // Try Grove port first (most common for GPS Hat)
         Serial.println("GPS: Trying StickC Grove port (G32/G33)");
         if (GPS.begin(32, 33, 9600)) {
             GPS.start();
-            hasGPS = true;
+            found = true;
             Serial.println("GPS: Initialized on Grove port");
         } else {
             // Try Hat connector
             Serial.println("GPS: Trying StickC Hat port (G0/G26)");
             if (GPS.begin(0, 26, 9600)) {
                 GPS.start();
-                hasGPS = true;
+                found = true;
                 Serial.println("GPS: Initialized on Hat port");
             }
         }
@@ -815,7 +1150,7 @@ void initPwning() {
         Serial.println("GPS: Trying AtomS3 Grove port (G2/G1)");
         if (GPS.begin(2, 1, 9600)) {
             GPS.start();
-            hasGPS = true;
+            found = true;
             Serial.println("GPS: Initialized on AtomS3 Grove");
         }
     #elif defined(ARDUINO_M5STACK_CARDPUTER)
@@ -823,7 +1158,7 @@ void initPwning() {
         Serial.println("GPS: Trying Cardputer Grove A (G1/G2)");
         if (GPS.begin(1, 2, 9600)) {
             GPS.start();
-            hasGPS = true;
+            found = true;
             Serial.println("GPS: Initialized on Cardputer Grove A");
         }
     #else
@@ -831,17 +1166,30 @@ void initPwning() {
         Serial.println("GPS: Trying generic pins (G16/G17)");
         if (GPS.begin(16, 17, 9600)) {
             GPS.start();
-            hasGPS = true;
+            found = true;
             Serial.println("GPS: Initialized on generic pins");
         }
     #endif
     
-    if (!hasGPS) {
+    hasGPS = found;
+    if (!found) {
         Serial.println("GPS: No GPS module detected - continuing without GPS");
     }
+}
 
+// Loads the grid identity, generating the RSA key pair on first boot
+void initPwnIdentity() {
     auto id = ensurePwnIdentity(true);
     setDeviceName(id.name.c_str());
+    identity_ready = true;
+}
+
+void initPwnRadio() {
+    if (pwning_initialized) {
+        resumePwnSniffer();
+        return;
+    }
+
     esp_log_level_set("wifi", ESP_LOG_NONE);
 
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
@@ -849,24 +1197,30 @@ void initPwning() {
     esp_wifi_set_storage(WIFI_STORAGE_RAM);
     esp_wifi_set_mode(WIFI_MODE_APSTA);
 
-    esp_wifi_set_promiscuous_filter(&filter);
-    esp_wifi_set_promiscuous(true);
-    esp_wifi_set_promiscuous_rx_cb(&pwnSnifferCallback);
-
-    // Initialize stealth AP interface
-    wifi_config_t ap_cfg = {0};
-    ap_cfg.ap.ssid_len = 0;
-    ap_cfg.ap.channel = 6;
-    ap_cfg.ap.authmode = WIFI_AUTH_OPEN;
-    ap_cfg.ap.max_connection = 0;
-    esp_wifi_set_config(WIFI_IF_AP, &ap_cfg);
+    resumePwnSniffer();
+    resetPwnAP();
 
     esp_wifi_start();
-    esp_wifi_set_channel(random(1, 14), WIFI_SECOND_CHAN_NONE);
+    wifi_set_channel(random(1, 14));
     delay(1);
+    pwning_initialized = true;
     Serial.println("Pwngrid initialised.");
 }
 
+void initPwning() {
+    if (pwning_initialized) {
+        resumePwnSniffer();
+        return;
+    }
+
+    Serial.println("Init Pwning processes");
+    initPwnState();
+    initPwnStorage();
+    initPwnGPS();
+    initPwnIdentity();
+    initPwnRadio();
+}
+
 // ========== Frame Transmission ==========
 esp_err_t sendRawFrame(wifi_interface_t ifx, const void *frame, int len, const char *tag) {
     wifi_mode_t mode;
@@ -974,7 +1328,7 @@ void performDeauthCycle() {
         Serial.printf("✅ Deauth cycle complete (%d target)\n", deauthCount);
     }
 
-    esp_wifi_set_channel(originalChannel, WIFI_SECOND_CHAN_NONE);
+    wifi_set_channel(originalChannel);
 }
 
 // ========== GPS Functions ==========
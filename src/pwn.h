@@ -16,8 +16,7 @@
 #define PWNGRID_VERSION "1.8.4"
 #define MAX_PKT_SAVE    800
 
-extern void drawMood(String face, String phrase, bool broken,
-                      String last_friend_name, signed int rssi);
+extern bool uiPostMood(const char* face, const char* phrase, bool broken, uint32_t hold_ms);
 
 struct BeaconEntry {
     uint8_t mac[6]{};
@@ -34,18 +33,52 @@ struct BeaconEntry {
 int wifi_get_channel();
 void wifi_set_channel(int ch);
 
+// Pin the sniffer to one channel, wifi_set_channel() ignores other channels
+// until unlocked. Used while the AP portal shares the radio.
+void lockPwnChannel(uint8_t channel);
+void unlockPwnChannel();
+bool isPwnChannelLocked();
+
 // Pwngrid system
+// Boot stages, see boot_stages in palnagotchi.ino. State comes first, radio
+// needs it; storage, GPS and identity can finish in the background.
+void initPwnState();
+void initPwnStorage();
+void initPwnGPS();
+void initPwnIdentity();
+void initPwnRadio();
+// All of the above in order. Safe to call again: once initialised it only
+// makes sure the sniffer is on
 void initPwning();
+void resumePwnSniffer();
+void resetPwnAP();
 esp_err_t pwngridAdvertise(uint8_t channel, String face);
 pwngrid_peer* getPwngridPeers();
+uint32_t getPwngridPeersRevision();
 uint64_t getPwngridRunTotalPeers();
 uint64_t getPwngridTotalPeers();
 String getPwngridLastFriendName();
+// Smoothed RSSI of the closest present peer, -1000 when nobody is around
 signed int getPwngridClosestRssi();
+// Peer index shown at `row`: present peers closest first, then gone ones
+// most recently seen first. -1 past the end.
+int getPwngridNearbyPeer(int row);
 void checkPwngridGoneFriends();
 uint64_t getPwngridRunPwned();
 uint64_t getPwngridTotalPwned();
 
+// Capture pipeline entry points, instrumented in metrics.h
+void pwnSnifferCallback(void *buf, wifi_promiscuous_pkt_type_t type);
+void enqueue_packet_from_sniffer(const uint8_t *pkt, size_t len, const uint8_t mac_bssid[6],
+                                 const char *type, uint8_t channel);
+
+// Steps of the pipeline above, called on their own by the microbenchmarks
+#define PWNGRID_BEACON_MAX 1024
+// Our advertisement as a beacon frame, returns its length or 0 if over cap
+size_t buildPwngridBeacon(const String &face, uint8_t *frame, size_t cap);
+void processPwngridBeacon(wifi_promiscuous_pkt_t *snifferPacket);
+String extractSSIDfromAP(const uint8_t *frame, int len);
+
 // Attack operations
 void performDeauthCycle();
 
@@ -0,0 +1,272 @@
+#include "scheduler.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "tracer.h"
+
+#define SCHED_NONE -1
+
+struct SchedJob {
+  SchedJobFn fn;
+  void* arg;
+  uint32_t expires;      // Tick
+  uint32_t period;       // Ticks, 0 for one-shot
+  uint32_t budget_us;
+  uint32_t last_report;
+  int8_t next;
+  int8_t prev;
+  int8_t slot;           // Index into wheel[], SCHED_NONE when not queued
+  SchedPriority prio;
+  bool used;
+  SchedJobStats stats;
+};
+
+static SchedJob jobs[SCHED_MAX_JOBS];
+static int8_t wheel[SCHED_WHEEL_LEVELS * SCHED_WHEEL_SLOTS];
+static uint32_t wheel_tick = 0;
+static bool sched_started = false;
+static TaskHandle_t loop_task = nullptr;
+
+// From the 64 bit timer, so ticks wrap cleanly at 2^32 unlike millis() / SCHED_TICK_MS
+static uint32_t nowTick() {
+  return (uint32_t)(esp_timer_get_time() / (SCHED_TICK_MS * 1000));
+}
+
+static void unlink(int id) {
+  SchedJob& j = jobs[id];
+  if (j.slot == SCHED_NONE) return;
+  if (j.prev != SCHED_NONE) {
+    jobs[j.prev].next = j.next;
+  } else {
+    wheel[j.slot] = j.next;
+  }
+  if (j.next != SCHED_NONE) {
+    jobs[j.next].prev = j.prev;
+  }
+  j.slot = SCHED_NONE;
+}
+
+// Queue on the lowest level whose range covers the delay. Jobs further out
+// than the top level land in its last slot and are re-queued on cascade.
+static void enqueue(int id) {
+  SchedJob& j = jobs[id];
+  bool overdue = (int32_t)(j.expires - wheel_tick) < 0;
+  uint32_t delta = overdue ? 0 : j.expires - wheel_tick;
+
+  int slot;
+  if (delta < SCHED_WHEEL_SLOTS) {
+    slot = (overdue ? wheel_tick : j.expires) & (SCHED_WHEEL_SLOTS - 1);
+  } else if (delta < (1u << (2 * SCHED_WHEEL_BITS))) {
+    slot = SCHED_WHEEL_SLOTS + ((j.expires >> SCHED_WHEEL_BITS) & (SCHED_WHEEL_SLOTS - 1));
+  } else {
+    uint32_t e = delta < (1u << (3 * SCHED_WHEEL_BITS)) ? j.expires
+                                                        : wheel_tick + (1u << (3 * SCHED_WHEEL_BITS)) - 1;
+    slot = 2 * SCHED_WHEEL_SLOTS + ((e >> (2 * SCHED_WHEEL_BITS)) & (SCHED_WHEEL_SLOTS - 1));
+  }
+
+  j.slot = slot;
+  j.prev = SCHED_NONE;
+  j.next = wheel[slot];
+  if (j.next != SCHED_NONE) {
+    jobs[j.next].prev = id;
+  }
+  wheel[slot] = id;
+}
+
+static void cascade(int level) {
+  int slot = level * SCHED_WHEEL_SLOTS + ((wheel_tick >> (level * SCHED_WHEEL_BITS)) & (SCHED_WHEEL_SLOTS - 1));
+  int id = wheel[slot];
+  wheel[slot] = SCHED_NONE;
+  while (id != SCHED_NONE) {
+    int next = jobs[id].next;
+    jobs[id].slot = SCHED_NONE;
+    enqueue(id);
+    id = next;
+  }
+}
+
+static void start() {
+  for (int i = 0; i < SCHED_WHEEL_LEVELS * SCHED_WHEEL_SLOTS; i++) {
+    wheel[i] = SCHED_NONE;
+  }
+  wheel_tick = nowTick();
+  sched_started = true;
+}
+
+static int addJob(const char* name, uint32_t delay_ms, uint32_t period_ms, SchedJobFn fn, void* arg,
+                  SchedPriority prio, uint32_t budget_ms) {
+  if (!sched_started) start();
+
+  for (int id = 0; id < SCHED_MAX_JOBS; id++) {
+    SchedJob& j = jobs[id];
+    if (j.used) continue;
+
+    memset(&j, 0, sizeof(j));
+    j.used = true;
+    j.fn = fn;
+    j.arg = arg;
+    j.prio = prio;
+    j.period = (period_ms + SCHED_TICK_MS - 1) / SCHED_TICK_MS;
+    j.budget_us = budget_ms * 1000;
+    j.expires = nowTick() + (delay_ms + SCHED_TICK_MS - 1) / SCHED_TICK_MS;
+    j.slot = SCHED_NONE;
+    j.stats.name = name;
+    j.stats.period_ms = period_ms;
+    enqueue(id);
+    return id;
+  }
+
+  Serial.printf("Sched: No slot left for job %s\n", name);
+  return -1;
+}
+
+int schedEvery(const char* name, uint32_t period_ms, SchedJobFn fn, void* arg,
+               SchedPriority prio, uint32_t budget_ms) {
+  return addJob(name, period_ms, period_ms, fn, arg, prio, budget_ms);
+}
+
+int schedOnce(const char* name, uint32_t delay_ms, SchedJobFn fn, void* arg,
+              SchedPriority prio, uint32_t budget_ms) {
+  return addJob(name, delay_ms, 0, fn, arg, prio, budget_ms);
+}
+
+void schedCancel(int id) {
+  if (id < 0 || id >= SCHED_MAX_JOBS || !jobs[id].used) return;
+  unlink(id);
+  jobs[id].used = false;
+}
+
+static void runJob(int id, uint32_t now) {
+  SchedJob& j = jobs[id];
+  uint32_t late_ms = (now - j.expires) * SCHED_TICK_MS;
+
+  int64_t start = esp_timer_get_time();
+  TRACE_BEGIN(j.stats.name);
+  j.fn(j.arg);
+  TRACE_END(j.stats.name);
+  uint32_t took = (uint32_t)(esp_timer_get_time() - start);
+
+  // The job may have cancelled itself
+  if (!j.used) return;
+
+  j.stats.runs++;
+  j.stats.total_us += took;
+  j.stats.max_us = max(j.stats.max_us, took);
+  j.stats.max_late_ms = max(j.stats.max_late_ms, late_ms);
+
+  if (j.budget_us && took > j.budget_us) {
+    j.stats.overruns++;
+    if (j.stats.overruns == 1 || millis() - j.last_report > 10000) {
+      Serial.printf("Sched: %s overran its %lu ms budget: %lu us (%lu overruns)\n", j.stats.name,
+                    (unsigned long)(j.budget_us / 1000), (unsigned long)took, (unsigned long)j.stats.overruns);
+      j.last_report = millis();
+    }
+  }
+
+  if (j.period == 0) {
+    j.used = false;
+    return;
+  }
+
+  // Stay on the original grid, but don't replay periods that were missed
+  j.expires += j.period;
+  uint32_t current = nowTick();
+  if ((int32_t)(j.expires - current) <= 0) {
+    uint32_t skipped = (current - j.expires) / j.period + 1;
+    j.stats.missed += skipped;
+    j.expires += skipped * j.period;
+  }
+  enqueue(id);
+}
+
+uint32_t schedRun() {
+  if (!sched_started) start();
+  if (loop_task == nullptr) loop_task = xTaskGetCurrentTaskHandle();
+
+  int8_t due[SCHED_MAX_JOBS];
+  int n = 0;
+  uint32_t now = nowTick();
+
+  while ((int32_t)(now - wheel_tick) >= 0) {
+    int idx = wheel_tick & (SCHED_WHEEL_SLOTS - 1);
+    if (idx == 0) {
+      if (((wheel_tick >> SCHED_WHEEL_BITS) & (SCHED_WHEEL_SLOTS - 1)) == 0) {
+        cascade(2);
+      }
+      cascade(1);
+    }
+
+    int id = wheel[idx];
+    wheel[idx] = SCHED_NONE;
+    while (id != SCHED_NONE) {
+      int next = jobs[id].next;
+      jobs[id].slot = SCHED_NONE;
+      if ((int32_t)(jobs[id].expires - wheel_tick) > 0) {
+        enqueue(id);  // A full wheel turn early
+      } else {
+        // Highest priority first, then oldest deadline
+        int k = n++;
+        while (k > 0 && (jobs[due[k - 1]].prio < jobs[id].prio ||
+                         (jobs[due[k - 1]].prio == jobs[id].prio &&
+                          (int32_t)(jobs[due[k - 1]].expires - jobs[id].expires) > 0))) {
+          due[k] = due[k - 1];
+          k--;
+        }
+        due[k] = id;
+      }
+      id = next;
+    }
+    wheel_tick++;
+  }
+
+  for (int i = 0; i < n; i++) {
+    if (jobs[due[i]].used && jobs[due[i]].slot == SCHED_NONE) {
+      runJob(due[i], now);
+    }
+  }
+
+  // Next occupied level 0 slot, or the next cascade
+  uint32_t ticks = SCHED_WHEEL_SLOTS - (wheel_tick & (SCHED_WHEEL_SLOTS - 1));
+  for (uint32_t t = 0; t < ticks; t++) {
+    if (wheel[(wheel_tick + t) & (SCHED_WHEEL_SLOTS - 1)] != SCHED_NONE) {
+      ticks = t;
+      break;
+    }
+  }
+  int32_t left = (int32_t)(wheel_tick + ticks - nowTick());
+  if (left <= 0) return 0;
+  uint32_t ms = left * SCHED_TICK_MS;
+  return ms < SCHED_MAX_IDLE_MS ? ms : SCHED_MAX_IDLE_MS;
+}
+
+void schedIdle(uint32_t ms) {
+  if (ms == 0) {
+    taskYIELD();
+    return;
+  }
+  // The idle task runs meanwhile, where automatic light sleep can kick in
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms));
+}
+
+void schedWake() {
+  if (loop_task != nullptr) {
+    xTaskNotifyGive(loop_task);
+  }
+}
+
+bool schedGetStats(int id, SchedJobStats* out) {
+  if (id < 0 || id >= SCHED_MAX_JOBS || !jobs[id].used) return false;
+  *out = jobs[id].stats;
+  return true;
+}
+
+void schedDumpStats() {
+  Serial.println("Sched: job             period   runs  avg us  max us  late ms  overruns  missed");
+  for (const SchedJob& j : jobs) {
+    if (!j.used) continue;
+    const SchedJobStats& s = j.stats;
+    Serial.printf("Sched: %-16s %6lu %6lu %7lu %7lu %8lu %9lu %7lu\n", s.name, (unsigned long)s.period_ms,
+                  (unsigned long)s.runs, (unsigned long)(s.runs ? s.total_us / s.runs : 0), (unsigned long)s.max_us,
+                  (unsigned long)s.max_late_ms, (unsigned long)s.overruns, (unsigned long)s.missed);
+  }
+}
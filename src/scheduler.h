@@ -0,0 +1,70 @@
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+#include "Arduino.h"
+
+// Cooperative scheduler for the main loop's periodic and one-shot jobs.
+// Jobs sit in a hierarchical timer wheel (3 levels of 64 slots, SCHED_TICK_MS
+// resolution, about 45 minutes of range before re-queuing), so arming,
+// cancelling and expiring a job is O(1) whatever the number of jobs.
+// Periods and delays are rounded up to whole ticks. Everything runs on the
+// loop task; only schedWake() may be called from elsewhere.
+
+#ifndef SCHED_MAX_JOBS
+#define SCHED_MAX_JOBS 16
+#endif
+#ifndef SCHED_TICK_MS
+#define SCHED_TICK_MS 10
+#endif
+#ifndef SCHED_DEFAULT_BUDGET_MS
+#define SCHED_DEFAULT_BUDGET_MS 20   // Longer runs are reported as overruns
+#endif
+#ifndef SCHED_MAX_IDLE_MS
+#define SCHED_MAX_IDLE_MS 1000
+#endif
+#ifndef SCHED_STATS_INTERVAL_MS
+#define SCHED_STATS_INTERVAL_MS 300000  // 0 disables the periodic stats dump
+#endif
+
+#define SCHED_WHEEL_BITS 6
+#define SCHED_WHEEL_SLOTS (1 << SCHED_WHEEL_BITS)
+#define SCHED_WHEEL_LEVELS 3
+
+enum SchedPriority : uint8_t {
+  SCHED_PRIO_LOW = 0,
+  SCHED_PRIO_NORMAL = 1,
+  SCHED_PRIO_HIGH = 2,
+};
+
+typedef void (*SchedJobFn)(void* arg);
+
+struct SchedJobStats {
+  const char* name;
+  uint32_t period_ms;  // 0 for one-shot jobs
+  uint32_t runs;
+  uint32_t overruns;   // Runs longer than the job's budget
+  uint32_t missed;     // Periods skipped because the job ran too late
+  uint64_t total_us;
+  uint32_t max_us;
+  uint32_t max_late_ms;
+};
+
+// Both return a job id, or -1 when every slot is taken
+int schedEvery(const char* name, uint32_t period_ms, SchedJobFn fn, void* arg = nullptr,
+               SchedPriority prio = SCHED_PRIO_NORMAL, uint32_t budget_ms = SCHED_DEFAULT_BUDGET_MS);
+int schedOnce(const char* name, uint32_t delay_ms, SchedJobFn fn, void* arg = nullptr,
+              SchedPriority prio = SCHED_PRIO_NORMAL, uint32_t budget_ms = SCHED_DEFAULT_BUDGET_MS);
+void schedCancel(int id);
+
+// Run every due job, highest priority first. Returns the ms until the
+// wheel next needs attention.
+uint32_t schedRun();
+
+// Block the loop task for up to `ms`, or until schedWake()
+void schedIdle(uint32_t ms);
+void schedWake();
+
+bool schedGetStats(int id, SchedJobStats* out);
+void schedDumpStats();
+
+#endif
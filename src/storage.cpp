@@ -12,6 +12,7 @@ StorageManager::StorageManager() {
     sdAvailable = false;
     sdFormatted = false;
     littleFSAvailable = false;
+    progress = 0;
     sdCSPin = -1;
     sdMOSIPin = -1;
     sdMISOPin = -1;
@@ -210,18 +211,37 @@ bool StorageManager::formatSD() {
     }
     
     Serial.println("SD: Formatting... (this may take a while)");
+    progress = 0;
     
     // Note: SD library doesn't have a format function
     // We'll create a filesystem structure by creating directories
     
-    // Try to remove all files
+    // Count files first so progress can be reported while removing them
+    int total = 0;
     File root = SD.open("/");
+    if (root) {
+        File file = root.openNextFile();
+        while (file) {
+            if (!file.isDirectory()) {
+                total++;
+            }
+            file = root.openNextFile();
+        }
+        root.close();
+    }
+    
+    // Try to remove all files
+    int removed = 0;
+    root = SD.open("/");
     if (root) {
         File file = root.openNextFile();
         while (file) {
             if (!file.isDirectory()) {
                 String path = String("/") + file.name();
+                file.close();
                 SD.remove(path.c_str());
+                removed++;
+                progress = removed * 90 / max(total, 1);
             }
             file = root.openNextFile();
         }
@@ -239,6 +259,7 @@ bool StorageManager::formatSD() {
     SD.remove("/test.tmp");
     
     sdFormatted = true;
+    progress = 100;
     Serial.println("SD: Format complete");
     return true;
 }
@@ -297,6 +318,17 @@ bool StorageManager::switchToLittleFS() {
 
 bool StorageManager::migrateDataToSD() {
     const char* files[] = {"/friends.ndjson", "/packets.ndjson"};
+    size_t grandTotal = 0;
+    size_t copiedTotal = 0;
+    progress = 0;
+    
+    for (const char* filename : files) {
+        File f = LittleFS.open(filename, FILE_READ);
+        if (f) {
+            grandTotal += f.size();
+            f.close();
+        }
+    }
     
     for (const char* filename : files) {
         if (!LittleFS.exists(filename)) {
@@ -326,6 +358,8 @@ bool StorageManager::migrateDataToSD() {
             size_t bytesRead = src.read(buffer, sizeof(buffer));
             dst.write(buffer, bytesRead);
             totalBytes += bytesRead;
+            copiedTotal += bytesRead;
+            progress = copiedTotal * 100 / max(grandTotal, (size_t)1);
         }
         
         src.close();
@@ -335,12 +369,24 @@ bool StorageManager::migrateDataToSD() {
         Serial.printf("Storage: Migrated %s (%d bytes)\n", filename, totalBytes);
     }
     
+    progress = 100;
     Serial.println("Storage: Migration to SD complete");
     return true;
 }
 
 bool StorageManager::migrateDataToLittleFS() {
     const char* files[] = {"/friends.ndjson", "/packets.ndjson"};
+    size_t grandTotal = 0;
+    size_t copiedTotal = 0;
+    progress = 0;
+    
+    for (const char* filename : files) {
+        File f = SD.open(filename, FILE_READ);
+        if (f) {
+            grandTotal += f.size();
+            f.close();
+        }
+    }
     
     for (const char* filename : files) {
         if (!SD.exists(filename)) {
@@ -370,6 +416,8 @@ bool StorageManager::migrateDataToLittleFS() {
             size_t bytesRead = src.read(buffer, sizeof(buffer));
             dst.write(buffer, bytesRead);
             totalBytes += bytesRead;
+            copiedTotal += bytesRead;
+            progress = copiedTotal * 100 / max(grandTotal, (size_t)1);
         }
         
         src.close();
@@ -379,6 +427,7 @@ bool StorageManager::migrateDataToLittleFS() {
         Serial.printf("Storage: Migrated %s (%d bytes)\n", filename, totalBytes);
     }
     
+    progress = 100;
     Serial.println("Storage: Migration to LittleFS complete");
     return true;
 }
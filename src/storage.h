@@ -19,6 +19,7 @@ private:
     bool sdAvailable;
     bool sdFormatted;
     bool littleFSAvailable;
+    volatile uint8_t progress;  // 0-100, for long operations run off the UI task
     
     // SD card pins for different devices
     int sdCSPin;
@@ -49,6 +50,7 @@ public:
     bool isSDActive() const { return currentStorage == STORAGE_SD; }
     StorageType getStorageType() const { return currentStorage; }
     const char* getStorageTypeName() const;
+    uint8_t getProgress() const { return progress; }
     
     // File operations using active storage
     File open(const char* path, const char* mode);
@@ -0,0 +1,108 @@
+#include "string_pool.h"
+#include <esp_heap_caps.h>
+
+#define STRING_POOL_SLOTS (STRING_POOL_ENTRIES * 2)  // Open addressing, at most half full
+
+static const char* pool_str[STRING_POOL_ENTRIES] = {""};
+static uint8_t pool_len[STRING_POOL_ENTRIES];
+static uint16_t pool_slot[STRING_POOL_SLOTS];  // Entry id, 0 while free
+static uint16_t pool_count = 1;
+static char* arena = nullptr;
+static size_t arena_size = 0;
+static size_t arena_used = 0;
+static bool pool_full_logged = false;
+static portMUX_TYPE pool_mux = portMUX_INITIALIZER_UNLOCKED;
+
+void initStringPool() {
+  if (arena != nullptr) {
+    return;
+  }
+  const char* where = "PSRAM";
+  arena_size = STRING_POOL_ARENA;
+  arena = (char*)heap_caps_malloc(arena_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (arena == nullptr) {
+    where = "RAM";
+    arena_size = STRING_POOL_ARENA_NO_PSRAM;
+    arena = (char*)malloc(arena_size);
+    if (arena == nullptr) {
+      arena_size = 0;
+      Serial.println("String pool: Not enough memory, only literals are kept");
+      return;
+    }
+  }
+  Serial.printf("String pool: %u entries, %u bytes in %s\n", STRING_POOL_ENTRIES, (unsigned)arena_size, where);
+}
+
+static uint32_t poolHash(const char* s, size_t len) {
+  uint32_t h = 2166136261u;  // FNV-1a
+  for (size_t i = 0; i < len; i++) {
+    h = (h ^ (uint8_t)s[i]) * 16777619u;
+  }
+  return h;
+}
+
+static uint16_t intern(const char* s, bool copy) {
+  if (s == nullptr || s[0] == '\0') {
+    return STRING_POOL_EMPTY;
+  }
+  size_t len = strnlen(s, STRING_POOL_MAX_LEN);
+  uint32_t slot = poolHash(s, len) & (STRING_POOL_SLOTS - 1);
+
+  portENTER_CRITICAL(&pool_mux);
+  for (;;) {
+    uint16_t id = pool_slot[slot];
+    if (id == 0) {
+      break;
+    }
+    if (pool_len[id] == len && memcmp(pool_str[id], s, len) == 0) {
+      portEXIT_CRITICAL(&pool_mux);
+      return id;
+    }
+    slot = (slot + 1) & (STRING_POOL_SLOTS - 1);
+  }
+
+  uint16_t id = STRING_POOL_EMPTY;
+  if (pool_count < STRING_POOL_ENTRIES && (!copy || arena_used + len + 1 <= arena_size)) {
+    const char* str = s;
+    if (copy) {
+      char* dst = arena + arena_used;
+      memcpy(dst, s, len);
+      dst[len] = '\0';
+      arena_used += len + 1;
+      str = dst;
+    }
+    id = pool_count++;
+    pool_str[id] = str;
+    pool_len[id] = len;
+    pool_slot[slot] = id;
+  }
+  bool log_full = id == STRING_POOL_EMPTY && !pool_full_logged;
+  pool_full_logged = pool_full_logged || log_full;
+  portEXIT_CRITICAL(&pool_mux);
+
+  if (log_full) {
+    Serial.printf("String pool: Full at %u entries, %u bytes, new strings read as empty\n",
+                  (unsigned)pool_count, (unsigned)arena_used);
+  }
+  return id;
+}
+
+uint16_t internString(const char* s) {
+  return intern(s, true);
+}
+
+uint16_t internStaticString(const char* s) {
+  return intern(s, false);
+}
+
+const char* pooledString(uint16_t id) {
+  return id < pool_count ? pool_str[id] : "";
+}
+
+uint16_t getStringPoolCount() {
+  return pool_count;
+}
+
+size_t getStringPoolBytes() {
+  return arena_used;
+}
@@ -0,0 +1,37 @@
+#ifndef _STRING_POOL_H_
+#define _STRING_POOL_H_
+
+#include "Arduino.h"
+
+// Strings that repeat across peers (faces, grid and peer versions) kept
+// once and referred to by 16-bit ids, so a peer record carries no heap Strings
+// for them and equal values compare as equal ids. Literals are referenced
+// where they sit in flash, anything else is copied into an arena allocated
+// once at boot. Nothing is ever removed: a string from pooledString() stays
+// valid for the whole run, so only values with few distinct ones belong here.
+
+#ifndef STRING_POOL_ENTRIES
+#define STRING_POOL_ENTRIES 512
+#endif
+#ifndef STRING_POOL_ARENA
+#define STRING_POOL_ARENA 8192            // PSRAM
+#endif
+#ifndef STRING_POOL_ARENA_NO_PSRAM
+#define STRING_POOL_ARENA_NO_PSRAM 2048
+#endif
+#define STRING_POOL_MAX_LEN 63            // Longer strings are cut
+#define STRING_POOL_EMPTY 0               // Id of ""
+
+void initStringPool();
+
+// Id of s, added when new. STRING_POOL_EMPTY for null or empty strings, and
+// once the pool is full.
+uint16_t internString(const char* s);
+// The same for a string that outlives the pool, like a literal; not copied
+uint16_t internStaticString(const char* s);
+const char* pooledString(uint16_t id);
+
+uint16_t getStringPoolCount();
+size_t getStringPoolBytes();
+
+#endif
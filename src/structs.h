@@ -3,18 +3,19 @@
 
 typedef struct {
   int epoch;
-  String face;
-  String grid_version;
-  String identity;
+  uint16_t face;          // String pool ids, see string_pool.h
+  uint16_t grid_version;
+  uint16_t version;
+  char session_id[18];    // MAC style, "aa:bb:cc:dd:ee:ff"
+  uint8_t identity[32];   // Binary fingerprint, PWN_IDENTITY_LEN in identity.h
   String name;
   int pwnd_run;
   int pwnd_tot;
-  String session_id;
   int timestamp;
   int uptime;
-  String version;
   signed int rssi;
-  int last_ping;
+  signed int rssi_avg;  // Smoothed over recent beacons, what the UI shows
+  int64_t last_ping;  // ms since boot, from esp_timer
   bool gone;
   int channel;
   double latitude;
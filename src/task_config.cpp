@@ -0,0 +1,37 @@
+#include "task_config.h"
+
+const TaskPlacement task_placement[TASK_COUNT] = {
+  {"uiTask",       TASK_UI_STACK,          TASK_UI_PRIORITY,          TASK_UI_CORE},
+  {"dbFriendTask", TASK_DB_STACK,          TASK_DB_PRIORITY,          TASK_DB_CORE},
+  {"dbPacketTask", TASK_DB_STACK,          TASK_DB_PRIORITY,          TASK_DB_CORE},
+  {"GPSTask",      TASK_GPS_STACK,         TASK_GPS_PRIORITY,         TASK_GPS_CORE},
+  {"think",        TASK_BRAIN_STACK,       TASK_BRAIN_PRIORITY,       TASK_BRAIN_CORE},
+  {"storageJob",   TASK_STORAGE_JOB_STACK, TASK_STORAGE_JOB_PRIORITY, TASK_STORAGE_JOB_CORE},
+  {"httpd",        TASK_HTTPD_STACK,       TASK_HTTPD_PRIORITY,       TASK_HTTPD_CORE},
+  {"logDrain",     TASK_LOG_STACK,         TASK_LOG_PRIORITY,         TASK_LOG_CORE},
+};
+
+BaseType_t getTaskCore(TaskId id) {
+#if CONFIG_FREERTOS_UNICORE
+  return TASK_ANY_CORE;
+#else
+  return task_placement[id].core;
+#endif
+}
+
+bool startTask(TaskId id, TaskFunction_t fn, void* arg, TaskHandle_t* handle) {
+  const TaskPlacement& t = task_placement[id];
+  return xTaskCreatePinnedToCore(fn, t.name, t.stack, arg, t.priority, handle, getTaskCore(id)) == pdPASS;
+}
+
+void logTaskLayout() {
+  Serial.printf("Task layout %d:\n", TASK_LAYOUT);
+  for (const TaskPlacement& t : task_placement) {
+    BaseType_t core = getTaskCore((TaskId)(&t - task_placement));
+    if (core == TASK_ANY_CORE) {
+      Serial.printf("  %-13s any core, priority %u, %u bytes\n", t.name, (unsigned)t.priority, (unsigned)t.stack);
+    } else {
+      Serial.printf("  %-13s core %d, priority %u, %u bytes\n", t.name, (int)core, (unsigned)t.priority, (unsigned)t.stack);
+    }
+  }
+}
@@ -0,0 +1,148 @@
+#ifndef _TASK_CONFIG_H_
+#define _TASK_CONFIG_H_
+
+#include "Arduino.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Core, priority and stack of every task the firmware creates, in one place.
+// The Wi-Fi stack runs on core 0 and the Arduino loop on core 1 (priority 1).
+// Pick a preset with -DTASK_LAYOUT=<n> and/or override single entries with
+// -DTASK_<NAME>_CORE/_PRIORITY/_STACK. Build with -DAFFINITY_BENCHMARK=1 to
+// measure a layout (see affinity_bench.h).
+
+#define TASK_ANY_CORE tskNO_AFFINITY
+
+#define TASK_LAYOUT_LEGACY 0    // UI, DB workers and GPS on core 1 with the loop, brain unpinned
+#define TASK_LAYOUT_SPLIT 1     // Capture side (DB workers, GPS, brain) on core 0 next to Wi-Fi
+#define TASK_LAYOUT_APP_CORE 2  // Everything on core 1, core 0 left to Wi-Fi alone
+
+#ifndef TASK_LAYOUT
+#define TASK_LAYOUT TASK_LAYOUT_LEGACY
+#endif
+
+#if TASK_LAYOUT == TASK_LAYOUT_SPLIT
+  #define TASK_CAPTURE_CORE 0
+  #define TASK_BRAIN_CORE_DEFAULT 0
+  #define TASK_HTTPD_CORE_DEFAULT 0
+#elif TASK_LAYOUT == TASK_LAYOUT_APP_CORE
+  #define TASK_CAPTURE_CORE 1
+  #define TASK_BRAIN_CORE_DEFAULT 1
+  #define TASK_HTTPD_CORE_DEFAULT 1
+#else
+  #define TASK_CAPTURE_CORE 1
+  #define TASK_BRAIN_CORE_DEFAULT TASK_ANY_CORE
+  #define TASK_HTTPD_CORE_DEFAULT 0
+#endif
+
+// UI rendering and input
+#ifndef TASK_UI_CORE
+#define TASK_UI_CORE 1
+#endif
+#ifndef TASK_UI_PRIORITY
+#define TASK_UI_PRIORITY 1
+#endif
+#ifndef TASK_UI_STACK
+#define TASK_UI_STACK 8192
+#endif
+
+// Friend and packet database writers
+#ifndef TASK_DB_CORE
+#define TASK_DB_CORE TASK_CAPTURE_CORE
+#endif
+#ifndef TASK_DB_PRIORITY
+#define TASK_DB_PRIORITY 1
+#endif
+#ifndef TASK_DB_STACK
+#define TASK_DB_STACK 4096
+#endif
+
+// GPS UART reader
+#ifndef TASK_GPS_CORE
+#define TASK_GPS_CORE TASK_CAPTURE_CORE
+#endif
+#ifndef TASK_GPS_PRIORITY
+#define TASK_GPS_PRIORITY 1
+#endif
+#ifndef TASK_GPS_STACK
+#define TASK_GPS_STACK 4096
+#endif
+
+// AI decision loop
+#ifndef TASK_BRAIN_CORE
+#define TASK_BRAIN_CORE TASK_BRAIN_CORE_DEFAULT
+#endif
+#ifndef TASK_BRAIN_PRIORITY
+#define TASK_BRAIN_PRIORITY 1
+#endif
+#ifndef TASK_BRAIN_STACK
+#define TASK_BRAIN_STACK 8192
+#endif
+
+// Storage format/migration jobs started from the menu
+#ifndef TASK_STORAGE_JOB_CORE
+#define TASK_STORAGE_JOB_CORE TASK_ANY_CORE
+#endif
+#ifndef TASK_STORAGE_JOB_PRIORITY
+#define TASK_STORAGE_JOB_PRIORITY 1
+#endif
+#ifndef TASK_STORAGE_JOB_STACK
+#define TASK_STORAGE_JOB_STACK 4096
+#endif
+
+// AP portal HTTP server
+#ifndef TASK_HTTPD_CORE
+#define TASK_HTTPD_CORE TASK_HTTPD_CORE_DEFAULT
+#endif
+#ifndef TASK_HTTPD_PRIORITY
+#define TASK_HTTPD_PRIORITY (tskIDLE_PRIORITY + 5)
+#endif
+#ifndef TASK_HTTPD_STACK
+#define TASK_HTTPD_STACK 10240
+#endif
+
+// Deferred log drain, writes to Serial
+#ifndef TASK_LOG_CORE
+#define TASK_LOG_CORE TASK_ANY_CORE
+#endif
+#ifndef TASK_LOG_PRIORITY
+#define TASK_LOG_PRIORITY 1
+#endif
+#ifndef TASK_LOG_STACK
+#define TASK_LOG_STACK 3072
+#endif
+
+#ifndef AFFINITY_BENCHMARK
+#define AFFINITY_BENCHMARK 0
+#endif
+
+enum TaskId : uint8_t {
+  TASK_UI,
+  TASK_DB_FRIEND,
+  TASK_DB_PACKET,
+  TASK_GPS,
+  TASK_BRAIN,
+  TASK_STORAGE_JOB,
+  TASK_HTTPD,
+  TASK_LOG,
+  TASK_COUNT
+};
+
+struct TaskPlacement {
+  const char* name;
+  uint32_t stack;
+  UBaseType_t priority;
+  BaseType_t core;  // TASK_ANY_CORE for unpinned
+};
+
+extern const TaskPlacement task_placement[TASK_COUNT];
+
+// Core to use for `id` on this chip (single core chips are never pinned)
+BaseType_t getTaskCore(TaskId id);
+
+// Create task `id` with its placement from the table
+bool startTask(TaskId id, TaskFunction_t fn, void* arg = nullptr, TaskHandle_t* handle = nullptr);
+
+void logTaskLayout();
+
+#endif
@@ -0,0 +1,203 @@
+#include "tracer.h"
+#include "logger.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+#if TRACE_ENABLED
+
+struct TraceRecord {
+  int64_t ts_us;
+  const char* name;
+  char phase;     // 'B', 'E' or 'i'
+  uint8_t core;
+  uint8_t task;   // Slot in task_handles
+};
+
+static TraceRecord* trace_rings[portNUM_PROCESSORS];
+static uint32_t trace_heads[portNUM_PROCESSORS];  // Events written since boot
+static uint32_t trace_mask = 0;
+static volatile bool trace_on = false;
+static bool trace_dumping = false;
+
+// Tasks get a small id the first time they record, slot 0 takes the
+// overflow. Entries are never reused, so readers need no lock.
+static TaskHandle_t task_handles[TRACE_MAX_TASKS];
+static char task_names[TRACE_MAX_TASKS][16] = {"other"};
+static uint8_t task_count = 1;
+static uint8_t last_task[portNUM_PROCESSORS];
+static portMUX_TYPE task_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint8_t taskSlot(TaskHandle_t h) {
+  uint8_t n = __atomic_load_n(&task_count, __ATOMIC_ACQUIRE);
+  for (uint8_t i = 1; i < n; i++) {
+    if (task_handles[i] == h) return i;
+  }
+
+  uint8_t slot = 0;
+  portENTER_CRITICAL(&task_mux);
+  for (uint8_t i = n; i < task_count; i++) {
+    if (task_handles[i] == h) slot = i;
+  }
+  if (slot == 0 && task_count < TRACE_MAX_TASKS) {
+    slot = task_count;
+    task_handles[slot] = h;
+    strlcpy(task_names[slot], pcTaskGetName(h), sizeof(task_names[slot]));
+    __atomic_store_n(&task_count, slot + 1, __ATOMIC_RELEASE);
+  }
+  portEXIT_CRITICAL(&task_mux);
+  return slot;
+}
+
+void traceEvent(const char* name, char phase) {
+  if (!trace_on) return;
+
+  uint8_t core = xPortGetCoreID();
+  TaskHandle_t h = xTaskGetCurrentTaskHandle();
+  uint8_t task = last_task[core];
+  if (task_handles[task] != h) {
+    task = taskSlot(h);
+    last_task[core] = task;
+  }
+
+  uint32_t i = __atomic_fetch_add(&trace_heads[core], 1, __ATOMIC_RELAXED);
+  TraceRecord& e = trace_rings[core][i & trace_mask];
+  e.ts_us = esp_timer_get_time();
+  e.name = name;
+  e.phase = phase;
+  e.core = core;
+  e.task = task;
+}
+
+void initTrace() {
+  size_t events = TRACE_RING_EVENTS;
+  const char* where = "PSRAM";
+  for (int c = 0; c < portNUM_PROCESSORS; c++) {
+    trace_rings[c] = (TraceRecord*)heap_caps_malloc(events * sizeof(TraceRecord),
+                                                    MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  }
+  if (trace_rings[portNUM_PROCESSORS - 1] == nullptr) {
+    // No PSRAM, settle for a short history in internal RAM
+    events = TRACE_RING_EVENTS / 16;
+    where = "RAM";
+    for (int c = 0; c < portNUM_PROCESSORS; c++) {
+      free(trace_rings[c]);
+      trace_rings[c] = (TraceRecord*)malloc(events * sizeof(TraceRecord));
+      if (trace_rings[c] == nullptr) {
+        Serial.println("Trace: Not enough memory, tracing disabled");
+        return;
+      }
+    }
+  }
+  trace_mask = events - 1;
+  trace_on = true;
+  Serial.printf("Trace: %u events per core in %s, send 't' to dump\n", (unsigned)events, where);
+}
+
+bool isTraceEnabled() {
+  return trace_mask != 0;
+}
+
+struct TraceWriter {
+  TraceSink sink;
+  void* ctx;
+  bool ok;
+  bool first;
+  size_t len;
+  char buf[1024];
+};
+
+static void traceOut(TraceWriter& w, const char* fmt, ...) {
+  if (!w.ok) return;
+  if (w.len > sizeof(w.buf) - 192) {
+    w.ok = w.sink(w.ctx, w.buf, w.len);
+    w.len = 0;
+  }
+  va_list ap;
+  va_start(ap, fmt);
+  int n = vsnprintf(w.buf + w.len, sizeof(w.buf) - w.len, fmt, ap);
+  va_end(ap);
+  if (n > 0) {
+    w.len += min((size_t)n, sizeof(w.buf) - w.len - 1);
+  }
+}
+
+static void traceSeparator(TraceWriter& w) {
+  traceOut(w, w.first ? "\n" : ",\n");
+  w.first = false;
+}
+
+bool writeTraceJson(TraceSink sink, void* ctx) {
+  if (!isTraceEnabled() || __atomic_exchange_n(&trace_dumping, true, __ATOMIC_ACQUIRE)) {
+    return false;
+  }
+  bool was_on = trace_on;
+  trace_on = false;
+  vTaskDelay(pdMS_TO_TICKS(2));  // Let events being written land
+
+  TraceWriter* w = new TraceWriter{sink, ctx, true, true, 0, {}};
+  traceOut(*w, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  traceSeparator(*w);
+  traceOut(*w, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"gotchi\"}}");
+  uint8_t tasks = __atomic_load_n(&task_count, __ATOMIC_ACQUIRE);
+  for (uint8_t t = 0; t < tasks; t++) {
+    traceSeparator(*w);
+    traceOut(*w, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+             (unsigned)t, task_names[t]);
+  }
+
+  for (int c = 0; c < portNUM_PROCESSORS; c++) {
+    uint32_t head = __atomic_load_n(&trace_heads[c], __ATOMIC_RELAXED);
+    uint32_t start = head > trace_mask ? head - trace_mask - 1 : 0;
+    for (uint32_t i = start; i != head && w->ok; i++) {
+      const TraceRecord& e = trace_rings[c][i & trace_mask];
+      traceSeparator(*w);
+      traceOut(*w, "{\"name\":\"%s\",\"ph\":\"%c\",%s\"ts\":%lld,\"pid\":0,\"tid\":%u,\"args\":{\"core\":%u}}",
+               e.name, e.phase, e.phase == 'i' ? "\"s\":\"t\"," : "",
+               (long long)e.ts_us, (unsigned)e.task, (unsigned)e.core);
+    }
+  }
+  traceOut(*w, "\n]}\n");
+  if (w->ok && w->len > 0) {
+    w->ok = sink(ctx, w->buf, w->len);
+  }
+  bool ok = w->ok;
+  delete w;
+
+  trace_on = was_on;
+  __atomic_store_n(&trace_dumping, false, __ATOMIC_RELEASE);
+  return ok;
+}
+
+static bool traceSerialSink(void* ctx, const char* data, size_t len) {
+  Serial.write((const uint8_t*)data, len);
+  return true;
+}
+
+void dumpTraceSerial() {
+  pauseLog(true);
+  Serial.println("\n=== TRACE BEGIN ===");
+  if (!writeTraceJson(traceSerialSink, nullptr)) {
+    Serial.println("Trace: Dump failed");
+  }
+  Serial.println("=== TRACE END ===");
+  pauseLog(false);
+}
+
+void pollTraceSerial() {
+  while (Serial.available() > 0) {
+    if (Serial.read() == 't') {
+      dumpTraceSerial();
+    }
+  }
+}
+
+#else
+
+void initTrace() {}
+bool isTraceEnabled() { return false; }
+bool writeTraceJson(TraceSink sink, void* ctx) { return false; }
+void dumpTraceSerial() {}
+void pollTraceSerial() {}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef _TRACER_H_
+#define _TRACER_H_
+
+#include "Arduino.h"
+
+// Timeline tracer for finding out what ran when the UI stutters. Built
+// only with -DTRACE_ENABLED=1, otherwise every TRACE_* macro compiles to
+// nothing. Events (begin, end, instant) carry a us timestamp, the core and
+// the task, and go into a per-core ring in PSRAM that keeps the most recent
+// TRACE_RING_EVENTS. Dump the rings as Chrome trace JSON from /api/trace,
+// or by sending 't' on the serial console, and open the file in
+// ui.perfetto.dev or chrome://tracing.
+//
+//   void mergeFriend(...) {
+//     TRACE_SCOPE("mergeFriend");
+//     ...
+//
+// Names must be string literals, only the pointer is recorded.
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+#ifndef TRACE_RING_EVENTS
+#define TRACE_RING_EVENTS 8192  // Per core, power of two, 16 bytes each
+#endif
+#ifndef TRACE_MAX_TASKS
+#define TRACE_MAX_TASKS 24
+#endif
+
+#if TRACE_ENABLED
+
+void traceEvent(const char* name, char phase);
+
+class TraceScope {
+public:
+  explicit TraceScope(const char* name) : name_(name) { traceEvent(name_, 'B'); }
+  ~TraceScope() { traceEvent(name_, 'E'); }
+private:
+  const char* name_;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_BEGIN(name) traceEvent(name, 'B')
+#define TRACE_END(name) traceEvent(name, 'E')
+#define TRACE_INSTANT(name) traceEvent(name, 'i')
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+
+#else
+
+#define TRACE_BEGIN(name) do {} while (0)
+#define TRACE_END(name) do {} while (0)
+#define TRACE_INSTANT(name) do {} while (0)
+#define TRACE_SCOPE(name) do {} while (0)
+
+#endif
+
+typedef bool (*TraceSink)(void* ctx, const char* data, size_t len);
+
+// Allocates the rings, a no-op unless TRACE_ENABLED
+void initTrace();
+bool isTraceEnabled();
+
+// Chrome trace JSON, oldest event first per core. Recording is paused
+// while the rings are read.
+bool writeTraceJson(TraceSink sink, void* ctx);
+void dumpTraceSerial();
+// Dumps the trace when 't' arrives on the serial console
+void pollTraceSerial();
+
+#endif
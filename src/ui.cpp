@@ -4,6 +4,11 @@
 #include "ap_config.h"
 #include "menu_system.h"
 #include "storage.h"
+#include "face_atlas.h"
+#include "task_config.h"
+#include "metrics.h"
+#include "tracer.h"
+#include "peer_history.h"
 
 M5Canvas canvas_top(&M5.Display);
 M5Canvas canvas_main(&M5.Display);
@@ -23,18 +28,91 @@ bool ninjaMode = false;
 long displayOnSince = millis();
 bool isDisplayOn = true;
 
+// Inputs each canvas was last rendered from. A canvas is only redrawn and
+// pushed over SPI when one of its inputs changed or it was invalidated.
+struct TopCanvasState {
+  bool valid = false;
+  int channel = -1;
+  uint32_t uptime_s = 0;
+  int32_t battery = -1;
+  int personality = -1;
+};
+
+struct BottomCanvasState {
+  bool valid = false;
+  uint64_t friends_run = 0;
+  uint64_t friends_tot = 0;
+  uint64_t pwned_run = 0;
+  uint64_t pwned_tot = 0;
+  int personality = -1;
+};
+
+enum MainView {
+  VIEW_NONE = 0,
+  VIEW_MOOD,
+  VIEW_MENU,
+  VIEW_AP_CONFIG
+};
+
+struct MainCanvasState {
+  bool valid = false;
+  MainView view = VIEW_NONE;
+  String face;
+  String phrase;
+  bool broken = false;
+  String friend_name;
+  int8_t rssi_level = -1;
+  const void* menu = nullptr;
+  uint32_t menu_revision = 0;
+};
+
+TopCanvasState top_state;
+BottomCanvasState bot_state;
+MainCanvasState main_state;
+
+// Render pacing and statistics
+uint32_t ui_frame_interval_ms = 1000 / UI_MAX_FPS;
+uint32_t ui_last_frame_ms = 0;
+uint32_t ui_frame_time_us = 0;
+uint32_t ui_spi_bytes_window = 0;
+uint32_t ui_spi_bytes_per_sec = 0;
+uint32_t ui_spi_window_start = 0;
+int32_t ui_battery_level = -1;
+uint32_t ui_battery_polled_at = 0;
+
+// UI task state
+TaskHandle_t uiTaskHandle = nullptr;
+QueueHandle_t uiQueue = nullptr;
+uint16_t* front_top = nullptr;
+uint16_t* front_main = nullptr;
+uint16_t* front_bot = nullptr;
+bool ui_write_open = false;
+
+// Mood posted by another subsystem, shown instead of the current mood until it expires
+struct MoodOverride {
+  bool active = false;
+  String face;
+  String phrase;
+  bool broken = false;
+  uint32_t until_ms = 0;
+};
+MoodOverride mood_override;
+
 // New menu system instances
 MenuSystem* mainMenu = nullptr;
 MenuSystem* settingsMenu = nullptr;
 MenuSystem* nearbyMenu = nullptr;
+MenuSystem* historyMenu = nullptr;
 MenuSystem* personalityMenu = nullptr;
 MenuSystem* storageMenu = nullptr;
+MenuSystem* metricsMenu = nullptr;
 MenuSystem* currentMenu = nullptr;
 
 enum MenuState {
   MENU_NONE = 0,
   MENU_MAIN = 1,
   MENU_FRIENDS = 2,
+  MENU_HISTORY = 3,
   MENU_SETTINGS = 4,
   MENU_ABOUT = 8,
   MENU_AP_CONFIG = 40,
@@ -50,13 +128,124 @@ bool getIsDisplayOn() {
   return isDisplayOn;
 }
 
+// Wait for pending DMA transfers and release the display bus
+static void finishUiWrite() {
+  if (!ui_write_open) {
+    return;
+  }
+  M5.Display.waitDMA();
+  M5.Display.endWrite();
+  ui_write_open = false;
+}
+
 void setIsDisplayOn(bool _isDisplayOn) {
+  finishUiWrite();
   isDisplayOn = _isDisplayOn;
   if (!isDisplayOn) {
     M5.Display.sleep();
   } else {
     M5.Display.wakeup(); 
+    invalidateUi();
+  }
+}
+
+void invalidateUi() {
+  top_state.valid = false;
+  bot_state.valid = false;
+  main_state.valid = false;
+}
+
+void setUiMaxFps(uint8_t fps) {
+  if (fps == 0) {
+    fps = 1;
+  }
+  ui_frame_interval_ms = 1000 / fps;
+}
+
+uint8_t getUiMaxFps() {
+  return ui_frame_interval_ms > 0 ? 1000 / ui_frame_interval_ms : 0;
+}
+
+uint32_t getUiFrameTimeUs() {
+  return ui_frame_time_us;
+}
+
+uint32_t getUiSpiBytesPerSec() {
+  return ui_spi_bytes_per_sec;
+}
+
+bool uiPostMood(const char* face, const char* phrase, bool broken, uint32_t hold_ms) {
+  if (!uiQueue) {
+    return false;
   }
+
+  ui_event_t ev;
+  ev.type = UI_EVENT_MOOD;
+  ev.broken = broken;
+  ev.hold_ms = hold_ms;
+  strlcpy(ev.face, face ? face : "", sizeof(ev.face));
+  strlcpy(ev.phrase, phrase ? phrase : "", sizeof(ev.phrase));
+  return xQueueSend(uiQueue, &ev, 0) == pdTRUE;
+}
+
+bool uiPostRedraw() {
+  if (!uiQueue) {
+    return false;
+  }
+
+  ui_event_t ev = {};
+  ev.type = UI_EVENT_REDRAW;
+  return xQueueSend(uiQueue, &ev, 0) == pdTRUE;
+}
+
+static void handleUiEvent(const ui_event_t& ev) {
+  switch (ev.type) {
+    case UI_EVENT_MOOD:
+      mood_override.active = true;
+      mood_override.face = ev.face;
+      mood_override.phrase = ev.phrase;
+      mood_override.broken = ev.broken;
+      mood_override.until_ms = millis() + ev.hold_ms;
+      break;
+
+    case UI_EVENT_REDRAW:
+    default:
+      invalidateUi();
+      break;
+  }
+}
+
+// The UI task owns the display, the canvases and button input
+static void uiTask(void* pv) {
+  ui_event_t ev;
+  for (;;) {
+    if (xQueueReceive(uiQueue, &ev, pdMS_TO_TICKS(UI_INPUT_POLL_MS)) == pdTRUE) {
+      do {
+        handleUiEvent(ev);
+      } while (xQueueReceive(uiQueue, &ev, 0) == pdTRUE);
+    }
+
+    // Release the bus as soon as the last frame finished streaming
+    if (ui_write_open && !M5.Display.dmaBusy()) {
+      M5.Display.endWrite();
+      ui_write_open = false;
+    }
+
+    M5.update();
+    #ifdef ARDUINO_M5STACK_CARDPUTER
+      M5Cardputer.update();
+    #endif
+
+    updateUi(getDeviceState() != STATE_AP_CONFIG);
+  }
+}
+
+static uint16_t* allocFrontBuffer(M5Canvas& canvas) {
+#if UI_DOUBLE_BUFFER
+  return (uint16_t*)heap_caps_malloc(canvas.bufferLength(), MALLOC_CAP_DMA);
+#else
+  return nullptr;
+#endif
 }
 
 void initUi() {
@@ -81,9 +270,26 @@ void initUi() {
   canvas_top.createSprite(display_w, canvas_top_h);
   canvas_bot.createSprite(display_w, canvas_bot_h);
   canvas_main.createSprite(display_w, canvas_h);
+
+  // Front buffers are optional, pushes fall back to blocking pushSprite()
+  front_top = allocFrontBuffer(canvas_top);
+  front_bot = allocFrontBuffer(canvas_bot);
+  front_main = allocFrontBuffer(canvas_main);
+  if (!front_top || !front_bot || !front_main) {
+    Serial.println("UI: Not enough DMA memory, double buffering disabled");
+    free(front_top);
+    free(front_bot);
+    free(front_main);
+    front_top = front_bot = front_main = nullptr;
+  }
   
+  initFaceAtlas(canvas_main);
+
   // Initialize menus
   initMenus();
+
+  uiQueue = xQueueCreate(UI_QUEUE_LEN, sizeof(ui_event_t));
+  startTask(TASK_UI, uiTask, NULL, &uiTaskHandle);
 }
 
 bool keyboard_changed = false;
@@ -92,17 +298,20 @@ bool keyboard_changed = false;
 void closeMenu();
 void openMainMenu();
 void openFriendsMenu();
+void openHistoryMenu();
 void openSettingsMenu();
 void openAboutMenu();
 void openPersonalityMenu();
 void openAPConfigMenu();
 void openStorageMenu();
+void openMetricsMenu();
 void toggleNinjaMode();
 
 // Forward declarations for button functions
 bool toggleMenuBtnPressed();
 bool isNextPressed();
 String getRssiBars(signed int rssi);
+static int8_t getRssiLevel(signed int rssi);
 void setPersonalityFriendly();
 void setPersonalityAI();
 void formatSDCard();
@@ -110,6 +319,199 @@ void switchToSDStorage();
 void switchToInternalStorage();
 void showStorageInfo();
 
+#define SPARKLINE_MINUTES 30
+#define SPARKLINE_RSSI_MIN -95
+#define SPARKLINE_RSSI_MAX -30
+
+// Peers seen since boot, in the order the peer table keeps them
+
+class NearbyPeersSource : public MenuDataSource {
+public:
+  int getCount() override {
+    uint64_t len = getPwngridRunTotalPeers();
+    return len > 0 ? len : 1;
+  }
+
+  void formatLabel(int index, char* buf, size_t len) override {
+    if (getPwngridRunTotalPeers() == 0) {
+      strlcpy(buf, "No friends yet...", len);
+      return;
+    }
+    int i = getPwngridNearbyPeer(index);
+    if (i < 0) {
+      buf[0] = '\0';
+      return;
+    }
+    pwngrid_peer& peer = getPwngridPeers()[i];
+    if (peer.gone) {
+      snprintf(buf, len, "%s (gone)", peer.name.c_str());
+      return;
+    }
+    int8_t level = getRssiLevel(peer.rssi_avg);
+    snprintf(buf, len, "%s [%.*s]", peer.name.c_str(), level, "||||");
+  }
+
+  // Average RSSI per minute over the last half hour, gaps where the peer was away
+  int drawRowGraphic(int index, M5Canvas* canvas, int right, int y, int h, uint16_t color) override {
+    static PeerHistoryBucket buckets[SPARKLINE_MINUTES];
+    int i = getPwngridRunTotalPeers() > 0 ? getPwngridNearbyPeer(index) : -1;
+    int width = min(SPARKLINE_MINUTES, (int)canvas->width() / 5);
+    int n = i >= 0 ? getPeerHistory(i, PEER_HISTORY_1M, buckets, width) : 0;
+    if (n == 0 || h < 4) {
+      return 0;
+    }
+    int x = right - n;
+    int prev_y = -1;
+    for (int b = 0; b < n; b++, x++) {
+      if (buckets[b].beacons == 0) {
+        prev_y = -1;
+        continue;
+      }
+      int rssi = constrain(buckets[b].rssi_sum / buckets[b].beacons, SPARKLINE_RSSI_MIN, SPARKLINE_RSSI_MAX);
+      int py = y + h - 1 - (rssi - SPARKLINE_RSSI_MIN) * (h - 1) / (SPARKLINE_RSSI_MAX - SPARKLINE_RSSI_MIN);
+      if (prev_y < 0) {
+        canvas->drawPixel(x, py, color);
+      } else {
+        canvas->drawLine(x - 1, prev_y, x, py, color);
+      }
+      prev_y = py;
+    }
+    return n + 4;
+  }
+
+  uint32_t getRevision() override { return getPwngridPeersRevision(); }
+};
+
+// Every friend ever met, read record by record from the friends table
+class FriendsHistorySource : public MenuDataSource {
+public:
+  int getCount() override {
+    if (friendsHistory.isStale()) {
+      friendsHistory.begin();
+      friendsHistory.end();
+    }
+    return friendsHistory.count() > 0 ? friendsHistory.count() : 1;
+  }
+
+  uint32_t getRevision() override { return friendsHistory.getRevision(); }
+
+  void beginRows() override { friendsHistory.begin(); }
+  void endRows() override { friendsHistory.end(); }
+
+  void formatLabel(int index, char* buf, size_t len) override {
+    if (friendsHistory.count() == 0) {
+      strlcpy(buf, "No friends met yet...", len);
+      return;
+    }
+    if (!readRecord(index)) {
+      strlcpy(buf, "?", len);
+      return;
+    }
+    snprintf(buf, len, "%s (ch %d)", doc["name"] | "?", doc["channel"] | 0);
+  }
+
+  void onSelect(int index) override {
+    friendsHistory.begin();
+    bool found = friendsHistory.count() > 0 && readRecord(index);
+    friendsHistory.end();
+    if (!found) {
+      return;
+    }
+
+    char body[160];
+    snprintf(body, sizeof(body), "Version: %s\nChannel: %d\nRSSI: %d\nIdentity: %.16s...",
+             doc["version"] | "?", doc["channel"] | 0, doc["rssi"] | 0, doc["identity"] | "?");
+    historyMenu->showMessage(doc["name"] | "?", body);
+  }
+
+private:
+  char line[512];
+  StaticJsonDocument<512> doc;
+
+  bool readRecord(int index) {
+    doc.clear();
+    return friendsHistory.readLine(index, line, sizeof(line)) && !deserializeJson(doc, line);
+  }
+};
+
+// Live view of the metrics registry, refreshed once a second while open
+class MetricsSource : public MenuDataSource {
+public:
+  int getCount() override { return METRICS_ROWS; }
+
+  uint32_t getRevision() override { return millis() / 1000; }
+
+  void beginRows() override {
+    uint32_t now = millis();
+    uint64_t frames = getMetricCounter(METRIC_SNIFFER_FRAMES);
+    if (now - rate_ms >= 1000) {
+      frames_per_sec = rate_ms ? (frames - rate_frames) * 1000 / (now - rate_ms) : 0;
+      rate_frames = frames;
+      rate_ms = now;
+    }
+  }
+
+  void formatLabel(int index, char* buf, size_t len) override {
+    MetricHistogramSnapshot h;
+    char a[12], b[12];
+    switch (index) {
+      case 0:
+        snprintf(buf, len, "Frames: %u/s", (unsigned)frames_per_sec);
+        break;
+      case 1:
+        getMetricHistogram(METRIC_SNIFFER_CALLBACK, &h);
+        snprintf(buf, len, "Sniffer: %s p99 %s", fmtUs(a, metricMeanUs(h)), fmtUs(b, metricQuantileUs(h, 0.99f)));
+        break;
+      case 2:
+        snprintf(buf, len, "Queues: pkt %d fr %d drop %u", (int)getMetricGauge(METRIC_PACKET_QUEUE_DEPTH),
+                 (int)getMetricGauge(METRIC_FRIEND_QUEUE_DEPTH), (unsigned)getMetricCounter(METRIC_QUEUE_DROPS));
+        break;
+      case 3:
+        getMetricHistogram(METRIC_DB_PACKET_WRITE, &h);
+        snprintf(buf, len, "DB write: %s p99 %s", fmtUs(a, metricMeanUs(h)), fmtUs(b, metricQuantileUs(h, 0.99f)));
+        break;
+      case 4:
+        getMetricHistogram(METRIC_DB_QUEUE_LATENCY, &h);
+        snprintf(buf, len, "To DB: %s p99 %s", fmtUs(a, metricMeanUs(h)), fmtUs(b, metricQuantileUs(h, 0.99f)));
+        break;
+      case 5:
+        getMetricHistogram(METRIC_UI_FRAME, &h);
+        snprintf(buf, len, "UI frame: %s p99 %s", fmtUs(a, metricMeanUs(h)), fmtUs(b, metricQuantileUs(h, 0.99f)));
+        break;
+      case 6:
+        getMetricHistogram(METRIC_ADVERTISE, &h);
+        snprintf(buf, len, "Advertise: %s err %u", fmtUs(a, metricQuantileUs(h, 0.99f)),
+                 (unsigned)getMetricCounter(METRIC_ADVERTISE_ERRORS));
+        break;
+      default:
+        snprintf(buf, len, "Heap: %uk (min %uk)", (unsigned)(ESP.getFreeHeap() / 1024),
+                 (unsigned)(ESP.getMinFreeHeap() / 1024));
+        break;
+    }
+  }
+
+private:
+  static const int METRICS_ROWS = 8;
+  uint64_t rate_frames = 0;
+  uint32_t rate_ms = 0;
+  uint32_t frames_per_sec = 0;
+
+  static const char* fmtUs(char* buf, uint32_t us) {
+    if (us < 1000) {
+      snprintf(buf, 12, "%uus", (unsigned)us);
+    } else if (us < 1000000) {
+      snprintf(buf, 12, "%ums", (unsigned)(us / 1000));
+    } else {
+      snprintf(buf, 12, "%u.%us", (unsigned)(us / 1000000), (unsigned)(us / 100000 % 10));
+    }
+    return buf;
+  }
+};
+
+static NearbyPeersSource nearby_source;
+static FriendsHistorySource history_source;
+static MetricsSource metrics_source;
+
 // Initialize all menus
 void initMenus() {
   mainMenu = new MenuSystem(&canvas_main);
@@ -123,6 +525,14 @@ void initMenus() {
   nearbyMenu = new MenuSystem(&canvas_main);
   nearbyMenu->setTitle("NEARBY");
   nearbyMenu->setColors(TFT_GREEN, TFT_DARKGREEN, TFT_BLACK, TFT_YELLOW);
+  nearbyMenu->setDataSource(&nearby_source);
+  nearbyMenu->addBackItem(openMainMenu);
+  
+  historyMenu = new MenuSystem(&canvas_main);
+  historyMenu->setTitle("HISTORY");
+  historyMenu->setColors(TFT_GREEN, TFT_DARKGREEN, TFT_BLACK, TFT_YELLOW);
+  historyMenu->setDataSource(&history_source);
+  historyMenu->addBackItem(openMainMenu);
   
   personalityMenu = new MenuSystem(&canvas_main);
   personalityMenu->setTitle("PERSONALITY");
@@ -132,8 +542,15 @@ void initMenus() {
   storageMenu->setTitle("STORAGE");
   storageMenu->setColors(TFT_GREEN, TFT_DARKGREEN, TFT_BLACK, TFT_YELLOW);
   
+  metricsMenu = new MenuSystem(&canvas_main);
+  metricsMenu->setTitle("METRICS");
+  metricsMenu->setColors(TFT_GREEN, TFT_DARKGREEN, TFT_BLACK, TFT_YELLOW);
+  metricsMenu->setDataSource(&metrics_source);
+  metricsMenu->addBackItem(openSettingsMenu);
+  
   // Build main menu
   mainMenu->addItem("Friends", openFriendsMenu);
+  mainMenu->addItem("History", openHistoryMenu);
   mainMenu->addItem("Settings", openSettingsMenu);
   mainMenu->addItem("About", openAboutMenu);
   mainMenu->addBackItem(closeMenu);
@@ -142,6 +559,7 @@ void initMenus() {
   settingsMenu->addItem("Config (AP)", openAPConfigMenu);
   settingsMenu->addItem("Personality", openPersonalityMenu);
   settingsMenu->addItem("Storage", openStorageMenu);
+  settingsMenu->addItem("Metrics", openMetricsMenu);
   settingsMenu->addItem("Ninja Mode", toggleNinjaMode);
   settingsMenu->addBackItem(openMainMenu);
   
@@ -166,26 +584,16 @@ void openMainMenu() {
 
 void openFriendsMenu() {
   activeMenuState = MENU_FRIENDS;
-  
-  // Rebuild nearby menu with current peers
-  nearbyMenu->clearItems();
-  
-  pwngrid_peer* pwngrid_peers = getPwngridPeers();
-  uint64_t len = getPwngridRunTotalPeers();
-  
-  if (len == 0) {
-    nearbyMenu->addItem("No friends yet...", [](){});
-  } else {
-    for (uint8_t i = 0; i < len && i < 20; i++) {  // Limit to 20 items
-      String peerLabel = String(pwngrid_peers[i].name) + " [" + getRssiBars(pwngrid_peers[i].rssi) + "]";
-      nearbyMenu->addItem(peerLabel, [](){});  // No action for now
-    }
-  }
-  
-  nearbyMenu->addBackItem(openMainMenu);
+  // Rows come straight from the peer table, nothing to rebuild
   currentMenu = nearbyMenu;
 }
 
+void openHistoryMenu() {
+  activeMenuState = MENU_HISTORY;
+  historyMenu->setCurrentIndex(0);
+  currentMenu = historyMenu;
+}
+
 void openSettingsMenu() {
   activeMenuState = MENU_SETTINGS;
   currentMenu = settingsMenu;
@@ -194,37 +602,20 @@ void openSettingsMenu() {
 void openAboutMenu() {
   activeMenuState = MENU_ABOUT;
   
-  // Show about screen (not a menu)
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(TFT_YELLOW);
-  canvas_main.setTextSize(2);
-  canvas_main.setTextDatum(top_center);
-  canvas_main.drawString("Palnagotchi", canvas_center_x, 10);
-  
-  canvas_main.setTextColor(TFT_GREEN);
-  canvas_main.setTextSize(1);
-  canvas_main.setTextDatum(top_left);
-  canvas_main.setCursor(10, 40);
-  canvas_main.println("AI-powered WiFi companion");
-  canvas_main.println("");
-  canvas_main.println("Features:");
-  canvas_main.println("- RL-based channel hopping");
-  canvas_main.println("- Handshake collection");
-  canvas_main.println("- Friend discovery");
-  canvas_main.println("");
-  canvas_main.setTextColor(TFT_DARKGREY);
-  canvas_main.println("Hold button to go back");
-  
-  canvas_main.pushSprite(0, canvas_top_h);
-  
-  // Wait for button press to go back
-  delay(300);  // Debounce
-  while (!toggleMenuBtnPressed()) {
-    M5.update();
-    delay(10);
-  }
-  
-  openMainMenu();
+  // Show about screen as a dialog on top of the main menu
+  mainMenu->showMessage("Palnagotchi",
+                        "AI-powered WiFi companion\n"
+                        "Features:\n"
+                        "- RL-based channel hopping\n"
+                        "- Handshake collection\n"
+                        "- Friend discovery",
+                        0, openMainMenu);
+}
+
+void openMetricsMenu() {
+  activeMenuState = MENU_SETTINGS;  // Part of settings
+  metricsMenu->setCurrentIndex(0);
+  currentMenu = metricsMenu;
 }
 
 void openPersonalityMenu() {
@@ -243,45 +634,21 @@ void toggleNinjaMode() {
   setNinjaMode(ninjaMode);
   
   // Show confirmation
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(TFT_YELLOW);
-  canvas_main.setTextSize(2);
-  canvas_main.setTextDatum(middle_center);
-  canvas_main.drawString(ninjaMode ? "Ninja: ON" : "Ninja: OFF", canvas_center_x, canvas_h / 2);
-  canvas_main.pushSprite(0, canvas_top_h);
-  delay(1000);
-  
-  openSettingsMenu();
+  settingsMenu->showMessage("", ninjaMode ? "Ninja: ON" : "Ninja: OFF", 1000, openSettingsMenu, TFT_YELLOW);
 }
 
 void setPersonalityFriendly() {
   setPersonality(FRIENDLY);
   
   // Show confirmation
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(TFT_GREEN);
-  canvas_main.setTextSize(2);
-  canvas_main.setTextDatum(middle_center);
-  canvas_main.drawString("Set: Friendly", canvas_center_x, canvas_h / 2);
-  canvas_main.pushSprite(0, canvas_top_h);
-  delay(1000);
-  
-  openPersonalityMenu();
+  personalityMenu->showMessage("", "Set: Friendly", 1000, openPersonalityMenu);
 }
 
 void setPersonalityAI() {
   setPersonality(AI);
   
   // Show confirmation
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(TFT_GREEN);
-  canvas_main.setTextSize(2);
-  canvas_main.setTextDatum(middle_center);
-  canvas_main.drawString("Set: AI", canvas_center_x, canvas_h / 2);
-  canvas_main.pushSprite(0, canvas_top_h);
-  delay(1000);
-  
-  openPersonalityMenu();
+  personalityMenu->showMessage("", "Set: AI", 1000, openPersonalityMenu);
 }
 
 void openStorageMenu() {
@@ -317,145 +684,79 @@ void openStorageMenu() {
   currentMenu = storageMenu;
 }
 
+// Long storage operations run on a worker task so neither loop() nor the UI stall
+struct StorageJob {
+  bool (*run)();
+  volatile bool running;
+  volatile bool success;
+  const char* ok_text;
+  const char* fail_text;
+};
+StorageJob storage_job = {nullptr, false, false, "", ""};
+
+static void storageJobTask(void* pv) {
+  storage_job.success = storage_job.run();
+  storage_job.running = false;
+  vTaskDelete(NULL);
+}
+
+static void runStorageJob(const char* title, bool (*run)(), const char* ok_text, const char* fail_text) {
+  if (storage_job.running) {
+    return;
+  }
+
+  storage_job.run = run;
+  storage_job.ok_text = ok_text;
+  storage_job.fail_text = fail_text;
+  storage_job.success = false;
+  storage_job.running = true;
+  if (!startTask(TASK_STORAGE_JOB, storageJobTask)) {
+    storage_job.running = false;
+    storageMenu->showMessage("", "Failed!", 2000, openStorageMenu, TFT_RED);
+    return;
+  }
+
+  storageMenu->showProgress(title,
+    [](int& percent) {
+      percent = storage.getProgress();
+      return !storage_job.running;
+    },
+    []() {
+      storageMenu->showMessage("", storage_job.success ? storage_job.ok_text : storage_job.fail_text, 2000,
+                               openStorageMenu, storage_job.success ? TFT_GREEN : TFT_RED);
+    });
+}
+
 void showStorageInfo() {
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(TFT_YELLOW);
-  canvas_main.setTextSize(2);
-  canvas_main.setTextDatum(top_center);
-  canvas_main.drawString("STORAGE INFO", canvas_center_x, 5);
-  
-  canvas_main.setTextColor(TFT_GREEN);
-  canvas_main.setTextSize(1);
-  canvas_main.setTextDatum(top_left);
-  canvas_main.setCursor(10, 30);
-  
-  canvas_main.printf("Active: %s\n", storage.getStorageTypeName());
-  canvas_main.println();
+  char info[256];
+  int n = snprintf(info, sizeof(info), "Active: %s\n\n", storage.getStorageTypeName());
   
   if (storage.isSDAvailable()) {
-    canvas_main.println("SD Card:");
-    canvas_main.printf("  Size: %llu MB\n", storage.getSDCardSize());
-    canvas_main.printf("  Used: %llu MB\n", storage.getSDCardUsed());
-    canvas_main.printf("  Free: %llu MB\n", storage.getSDCardFree());
-    canvas_main.printf("  Status: %s\n", storage.isSDFormatted() ? "OK" : "Not formatted");
+    snprintf(info + n, sizeof(info) - n,
+             "SD Card:\n  Size: %llu MB\n  Used: %llu MB\n  Free: %llu MB\n  Status: %s",
+             storage.getSDCardSize(), storage.getSDCardUsed(), storage.getSDCardFree(),
+             storage.isSDFormatted() ? "OK" : "Not formatted");
   } else {
-    canvas_main.println("SD Card: Not detected");
-  }
-  
-  canvas_main.setTextColor(TFT_DARKGREY);
-  canvas_main.setCursor(10, canvas_h - 15);
-  canvas_main.println("Hold button to go back");
-  
-  canvas_main.pushSprite(0, canvas_top_h);
-  
-  // Wait for button
-  delay(300);
-  while (!toggleMenuBtnPressed()) {
-    M5.update();
-    delay(10);
+    snprintf(info + n, sizeof(info) - n, "SD Card: Not detected");
   }
   
-  openStorageMenu();
+  storageMenu->showMessage("STORAGE INFO", info, 0, openStorageMenu);
 }
 
 void formatSDCard() {
-  // Confirmation dialog
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(TFT_YELLOW);
-  canvas_main.setTextSize(2);
-  canvas_main.setTextDatum(middle_center);
-  canvas_main.drawString("FORMAT SD?", canvas_center_x, canvas_h / 3);
-  
-  canvas_main.setTextColor(TFT_RED);
-  canvas_main.setTextSize(1);
-  canvas_main.drawString("All data will be lost!", canvas_center_x, canvas_h / 2);
-  
-  canvas_main.setTextColor(TFT_GREEN);
-  canvas_main.drawString("Short press: Cancel", canvas_center_x, canvas_h - 30);
-  canvas_main.drawString("Long press: Format", canvas_center_x, canvas_h - 15);
-  
-  canvas_main.pushSprite(0, canvas_top_h);
-  
-  delay(500);  // Debounce
-  
-  // Wait for user input
-  unsigned long startWait = millis();
-  bool formatConfirmed = false;
-  
-  while (millis() - startWait < 10000) {  // 10 second timeout
-    M5.update();
-    
-    if (isNextPressed()) {
-      // Cancel
-      break;
-    }
-    
-    if (toggleMenuBtnPressed()) {
-      formatConfirmed = true;
-      break;
-    }
-    
-    delay(10);
-  }
-  
-  if (formatConfirmed) {
-    // Show formatting message
-    canvas_main.fillSprite(TFT_BLACK);
-    canvas_main.setTextColor(TFT_YELLOW);
-    canvas_main.setTextSize(2);
-    canvas_main.setTextDatum(middle_center);
-    canvas_main.drawString("Formatting...", canvas_center_x, canvas_h / 2);
-    canvas_main.pushSprite(0, canvas_top_h);
-    
-    bool success = storage.formatSD();
-    
-    // Show result
-    canvas_main.fillSprite(TFT_BLACK);
-    canvas_main.setTextColor(success ? TFT_GREEN : TFT_RED);
-    canvas_main.drawString(success ? "Success!" : "Failed!", canvas_center_x, canvas_h / 2);
-    canvas_main.pushSprite(0, canvas_top_h);
-    delay(2000);
-  }
-  
-  openStorageMenu();
+  storageMenu->showConfirm("FORMAT SD?", "All data will be lost!",
+    []() {
+      runStorageJob("Formatting...", []() { return storage.formatSD(); }, "Success!", "Failed!");
+    },
+    openStorageMenu);
 }
 
 void switchToSDStorage() {
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(TFT_YELLOW);
-  canvas_main.setTextSize(2);
-  canvas_main.setTextDatum(middle_center);
-  canvas_main.drawString("Switching...", canvas_center_x, canvas_h / 2);
-  canvas_main.pushSprite(0, canvas_top_h);
-  
-  bool success = storage.switchToSD();
-  
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(success ? TFT_GREEN : TFT_RED);
-  canvas_main.drawString(success ? "Using SD Card" : "Failed!", canvas_center_x, canvas_h / 2);
-  canvas_main.pushSprite(0, canvas_top_h);
-  delay(2000);
-  
-  openStorageMenu();
+  runStorageJob("Switching...", []() { return storage.switchToSD(); }, "Using SD Card", "Failed!");
 }
 
 void switchToInternalStorage() {
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(TFT_YELLOW);
-  canvas_main.setTextSize(2);
-  canvas_main.setTextDatum(middle_center);
-  canvas_main.drawString("Switching...", canvas_center_x, canvas_h / 2);
-  canvas_main.pushSprite(0, canvas_top_h);
-  
-  bool success = storage.switchToLittleFS();
-  
-  canvas_main.fillSprite(TFT_BLACK);
-  canvas_main.setTextColor(success ? TFT_GREEN : TFT_RED);
-  canvas_main.drawString(success ? "Using Internal" : "Failed!", canvas_center_x, canvas_h / 2);
-  canvas_main.pushSprite(0, canvas_top_h);
-  delay(2000);
-  
-  openStorageMenu();
+  runStorageJob("Switching...", []() { return storage.switchToLittleFS(); }, "Using Internal", "Failed!");
 }
 
 // Long press to toggle menu or select item
@@ -492,8 +793,138 @@ bool isPrevPressed() {
 #endif
 }
 
+static int8_t getRssiLevel(signed int rssi) {
+  if (rssi == -1000) {
+    return 0;
+  }
+  if (rssi >= -67) {
+    return 4;
+  } else if (rssi >= -70) {
+    return 3;
+  } else if (rssi >= -80) {
+    return 2;
+  }
+  return 1;
+}
+
+// Refresh top canvas inputs, returns true if it has to be redrawn
+static bool topCanvasChanged() {
+  uint32_t now = millis();
+  if (ui_battery_level < 0 || now - ui_battery_polled_at > UI_BATTERY_POLL_MS) {
+    ui_battery_level = M5.Power.getBatteryLevel();
+    ui_battery_polled_at = now;
+  }
+
+  int channel = wifi_get_channel();
+  uint32_t uptime_s = now / 1000;
+  int personality = getPersonality();
+
+  if (top_state.valid && top_state.channel == channel && top_state.uptime_s == uptime_s &&
+      top_state.battery == ui_battery_level && top_state.personality == personality) {
+    return false;
+  }
+
+  top_state.valid = true;
+  top_state.channel = channel;
+  top_state.uptime_s = uptime_s;
+  top_state.battery = ui_battery_level;
+  top_state.personality = personality;
+  return true;
+}
+
+// Refresh bottom canvas inputs, returns true if it has to be redrawn
+static bool bottomCanvasChanged() {
+  uint64_t friends_run = getPwngridRunTotalPeers();
+  uint64_t friends_tot = getPwngridTotalPeers();
+  uint64_t pwned_run = getPwngridRunPwned();
+  uint64_t pwned_tot = getPwngridTotalPwned();
+  int personality = getPersonality();
+
+  if (bot_state.valid && bot_state.friends_run == friends_run && bot_state.friends_tot == friends_tot &&
+      bot_state.pwned_run == pwned_run && bot_state.pwned_tot == pwned_tot &&
+      bot_state.personality == personality) {
+    return false;
+  }
+
+  bot_state.valid = true;
+  bot_state.friends_run = friends_run;
+  bot_state.friends_tot = friends_tot;
+  bot_state.pwned_run = pwned_run;
+  bot_state.pwned_tot = pwned_tot;
+  bot_state.personality = personality;
+  return true;
+}
+
+// Mood to show: a posted mood while it is held, the current mood otherwise
+static void getDisplayedMood(String& face, String& phrase, bool& broken) {
+  if (mood_override.active && (int32_t)(millis() - mood_override.until_ms) >= 0) {
+    mood_override.active = false;
+  }
+
+  if (mood_override.active) {
+    face = mood_override.face;
+    phrase = mood_override.phrase;
+    broken = mood_override.broken;
+  } else {
+    MoodSnapshot mood;  // Copied in one go, setMood() runs on other tasks
+    getMoodSnapshot(mood);
+    face = mood.face;
+    phrase = mood.phrase;
+    broken = mood.broken;
+  }
+}
+
+// Refresh main canvas inputs, returns true if it has to be redrawn
+static bool mainCanvasChanged() {
+  MainView view = VIEW_MOOD;
+  if (getDeviceState() == STATE_AP_CONFIG) {
+    view = VIEW_AP_CONFIG;
+  } else if (menu_open || isAPModeActive()) {
+    view = VIEW_MENU;
+  }
+
+  if (view == VIEW_MENU) {
+    uint32_t menu_revision = currentMenu != nullptr ? currentMenu->getRevision() : 0;
+    if (main_state.valid && main_state.view == view && main_state.menu == currentMenu &&
+        main_state.menu_revision == menu_revision) {
+      return false;
+    }
+    main_state.menu = currentMenu;
+    main_state.menu_revision = menu_revision;
+  } else if (view == VIEW_MOOD) {
+    String face;
+    String phrase;
+    bool broken;
+    getDisplayedMood(face, phrase, broken);
+    String friend_name = getPwngridLastFriendName();
+    int8_t rssi_level = getRssiLevel(getPwngridClosestRssi());
+    if (main_state.valid && main_state.view == view && main_state.face == face &&
+        main_state.phrase == phrase && main_state.broken == broken &&
+        main_state.friend_name == friend_name && main_state.rssi_level == rssi_level) {
+      return false;
+    }
+  } else if (main_state.valid && main_state.view == view) {
+    return false;
+  }
+
+  main_state.view = view;
+  main_state.valid = true;
+  return true;
+}
+
+// Push a canvas to the panel, through DMA when a front buffer is available
+static uint32_t pushCanvas(M5Canvas& canvas, uint16_t* front, int32_t y) {
+  if (front) {
+    memcpy(front, canvas.getBuffer(), canvas.bufferLength());
+    M5.Display.pushImageDMA(0, y, canvas.width(), canvas.height(), (const lgfx::swap565_t*)front);
+  } else {
+    canvas.pushSprite(0, y);
+  }
+  return canvas.bufferLength();
+}
+
 void updateUi(bool show_toolbars) {
-  ////Serial.println("UI - updateUi.");
+  TRACE_SCOPE("updateUi");
 
   if ((M5.BtnA.wasClicked() || M5.BtnB.wasClicked() || M5.BtnA.wasHold() || M5.BtnB.wasHold()) && !isDisplayOn) {
     setIsDisplayOn(true);
@@ -520,6 +951,7 @@ void updateUi(bool show_toolbars) {
     if (isAPModeActive()) {
       exitAPConfigMode();
       menu_open = false;
+      invalidateUi();
       return;
     }
 
@@ -547,33 +979,80 @@ void updateUi(bool show_toolbars) {
     displayOnSince = millis();
   }
 
-  uint8_t mood_id = getCurrentMoodId();
-  String mood_face = getCurrentMoodFace();
-  String mood_phrase = getCurrentMoodPhrase();
-  bool mood_broken = isCurrentMoodBroken();
+  // Dialog timeouts and background job progress
+  if (menu_open && currentMenu != nullptr) {
+    currentMenu->update();
+  }
+
+  // Input is polled on every call, rendering is capped to UI_MAX_FPS
+  uint32_t now = millis();
+  if (now - ui_last_frame_ms < ui_frame_interval_ms) {
+    return;
+  }
+  ui_last_frame_ms = now;
+  uint32_t frame_start = micros();
 
   //Serial.println("UI - Draw canvas.");
 
-  drawTopCanvas(wifi_get_channel());
-  drawBottomCanvas(getPwngridRunTotalPeers(), getPwngridTotalPeers(), getPwngridRunPwned(), getPwngridTotalPwned());
+  bool top_dirty = show_toolbars && topCanvasChanged();
+  bool bot_dirty = show_toolbars && bottomCanvasChanged();
+  bool main_dirty = mainCanvasChanged();
+
+  if (top_dirty) {
+    drawTopCanvas(top_state.channel);
+  }
+  if (bot_dirty) {
+    drawBottomCanvas(bot_state.friends_run, bot_state.friends_tot, bot_state.pwned_run, bot_state.pwned_tot);
+  }
 
   //Serial.println("UI - Menu or Mood.");
 
-  if (menu_open || isAPModeActive()) {
-    drawMenu();
-  } else {
-    drawMood(mood_face, mood_phrase, mood_broken, getPwngridLastFriendName(), getPwngridClosestRssi());
+  if (main_dirty) {
+    if (main_state.view == VIEW_MOOD) {
+      String face;
+      String phrase;
+      bool broken;
+      getDisplayedMood(face, phrase, broken);
+      drawMood(face, phrase, broken, getPwngridLastFriendName(), getPwngridClosestRssi());
+    } else {
+      drawMenu();
+    }
   }
 
   //Serial.println("UI - startWrite.");
 
-  M5.Display.startWrite();
-  if (show_toolbars) {
-    canvas_top.pushSprite(0, 0);
-    canvas_bot.pushSprite(0, canvas_top_h + canvas_h);
+  if (top_dirty || bot_dirty || main_dirty) {
+    uint32_t pushed = 0;
+    // Front buffers may still be streaming the previous frame
+    M5.Display.waitDMA();
+    if (!ui_write_open) {
+      M5.Display.startWrite();
+      ui_write_open = true;
+    }
+    if (top_dirty) {
+      pushed += pushCanvas(canvas_top, front_top, 0);
+    }
+    if (bot_dirty) {
+      pushed += pushCanvas(canvas_bot, front_bot, canvas_top_h + canvas_h);
+    }
+    if (main_dirty) {
+      pushed += pushCanvas(canvas_main, front_main, canvas_top_h);
+    }
+    // Without front buffers the pushes were blocking, release the bus now
+    if (!front_main) {
+      finishUiWrite();
+    }
+    ui_spi_bytes_window += pushed;
+  }
+
+  ui_frame_time_us = micros() - frame_start;
+  metricObserve(METRIC_UI_FRAME, ui_frame_time_us);
+  metricInc(METRIC_UI_FRAMES);
+  if (now - ui_spi_window_start >= 1000) {
+    ui_spi_bytes_per_sec = ui_spi_bytes_window * 1000 / (now - ui_spi_window_start);
+    ui_spi_bytes_window = 0;
+    ui_spi_window_start = now;
   }
-  canvas_main.pushSprite(0, canvas_top_h);
-  M5.Display.endWrite();
 
   //Serial.println("UI - Ended updateUi.");
 }
@@ -603,7 +1082,7 @@ void drawTopCanvas(int channel) {
   if (display_w > 128) {
     char right_str[50] = "UPS 0%  UP 00:00:00";
     snprintf(right_str, sizeof(right_str), "UPS %i%% UP %02d:%02d:%02d",
-             M5.Power.getBatteryLevel(), h, m, s);
+             (int)ui_battery_level, h, m, s);
     canvas_top.drawString(right_str, display_w, 3);
   } else {
     char right_str[50] = "UP 00:00:00";
@@ -614,21 +1093,13 @@ void drawTopCanvas(int channel) {
 }
 
 String getRssiBars(signed int rssi) {
-  String rssi_bars = "";
-
-  if (rssi != -1000) {
-    if (rssi >= -67) {
-      rssi_bars = "||||";
-    } else if (rssi >= -70) {
-      rssi_bars = "|||";
-    } else if (rssi >= -80) {
-      rssi_bars = "||";
-    } else {
-      rssi_bars = "|";
-    }
+  switch (getRssiLevel(rssi)) {
+    case 4: return "||||";
+    case 3: return "|||";
+    case 2: return "||";
+    case 1: return "|";
+    default: return "";
   }
-
-  return rssi_bars;
 }
 
 void drawBottomCanvas(uint8_t friends_run, uint8_t friends_tot, uint8_t pwned_run, uint8_t pwned_tot) {
@@ -675,16 +1146,11 @@ void drawMood(String face, String phrase, bool broken,
     return;
   }
 
-  if (broken == true) {
-    canvas_main.setTextColor(RED);
-  } else {
-    canvas_main.setTextColor(GREEN);
-  }
+  uint16_t color = broken ? RED : GREEN;
 
-  canvas_main.setTextSize(4);
-  canvas_main.setTextDatum(middle_center);
   canvas_main.fillSprite(BLACK);
-  canvas_main.drawString(face, canvas_center_x, canvas_h / 3);
+  drawFace(canvas_main, face, canvas_center_x, canvas_h / 3, color);
+  canvas_main.setTextColor(color);
   canvas_main.setTextDatum(bottom_center);
   canvas_main.setTextSize(1);
   canvas_main.drawString(phrase, canvas_center_x, canvas_h - 35);
@@ -702,6 +1168,12 @@ void drawMood(String face, String phrase, bool broken,
     snprintf(friend_txt, sizeof(friend_txt), "[%s] %s", rssi_bars.c_str(), last_friend_name.c_str());
   }
   canvas_main.drawString(friend_txt, 0, canvas_h - 5);
+
+  main_state.face = face;
+  main_state.phrase = phrase;
+  main_state.broken = broken;
+  main_state.friend_name = last_friend_name;
+  main_state.rssi_level = getRssiLevel(rssi);
 }
 
 #define ROW_SIZE 40
@@ -874,9 +1346,6 @@ void drawMenu() {
   // Check if in AP config mode
   uint8_t device_state = getDeviceState();
   if (device_state == STATE_AP_CONFIG) {
-    if (!isAPModeActive()) {
-      startAPMode();
-    }
     drawAPConfigMenu();
     return;
   }
@@ -884,7 +1353,6 @@ void drawMenu() {
   // Draw current menu using new menu system
   if (currentMenu != nullptr) {
     currentMenu->draw();
-    canvas_main.pushSprite(0, canvas_top_h);
   } else {
     // Fallback to main menu if no menu is set
     openMainMenu();
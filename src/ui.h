@@ -1,3 +1,6 @@
+#ifndef _UI_H_
+#define _UI_H_
+
 #ifdef ARDUINO_M5STACK_CARDPUTER
   #include "M5Cardputer.h"
 #endif
@@ -6,11 +9,45 @@
 
 #define SCREEN_TIMEOUT 30000
 
+// Upper bound on how often updateUi() renders; input is still polled every call
+#ifndef UI_MAX_FPS
+#define UI_MAX_FPS 20
+#endif
+
+// UI input polling period (task placement is in task_config.h)
+#define UI_INPUT_POLL_MS 10
+#define UI_QUEUE_LEN 16
+
+// Copy rendered canvases into DMA front buffers so the next frame can be
+// rendered while the previous one is still streaming to the panel
+#ifndef UI_DOUBLE_BUFFER
+#define UI_DOUBLE_BUFFER 1
+#endif
+
+// Battery level is read over I2C, so it is sampled instead of read every frame
+#ifndef UI_BATTERY_POLL_MS
+#define UI_BATTERY_POLL_MS 5000
+#endif
+
 // Forward declarations for state management
 void enterAPConfigMode();
 void exitAPConfigMode();
 uint8_t getDeviceState();
 
+// Events other subsystems post to the UI task instead of drawing directly
+enum UiEventType {
+  UI_EVENT_REDRAW = 0,
+  UI_EVENT_MOOD = 1
+};
+
+typedef struct {
+  uint8_t type;
+  bool broken;
+  uint32_t hold_ms;
+  char face[MOOD_FACE_MAX];
+  char phrase[MOOD_PHRASE_MAX];
+} ui_event_t;
+
 void initUi();
 void initMenus();
 void wakeUp();
@@ -20,9 +57,20 @@ void drawTopCanvas(int channel);
 void drawBottomCanvas(uint8_t friends_run = 0, uint8_t friends_tot = 0, uint8_t pwned_run = 0, uint8_t pwned_tot = 0);
 void drawMenu();
 void updateUi(bool show_toolbars = false);
+void invalidateUi();
+bool uiPostMood(const char* face, const char* phrase, bool broken = false, uint32_t hold_ms = 2000);
+bool uiPostRedraw();
+
+// Render statistics
+void setUiMaxFps(uint8_t fps);
+uint8_t getUiMaxFps();
+uint32_t getUiFrameTimeUs();
+uint32_t getUiSpiBytesPerSec();
 
 void setNinjaMode(bool _ninjaMode);
 bool getNinjaMode();
 
 bool getIsDisplayOn();
-void setIsDisplayOn(bool _isDisplayOn);
\ No newline at end of file
+void setIsDisplayOn(bool _isDisplayOn);
+
+#endif
@@ -0,0 +1,412 @@
+// Generated by scripts/gen_web_assets.py from web/, do not edit
+#ifndef _WEB_ASSETS_H_
+#define _WEB_ASSETS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct WebAsset {
+  const char* type;
+  const char* etag;
+  const uint8_t* data;  // gzip
+  size_t len;
+  size_t raw_len;
+};
+
+// index.html: 10050 -> 3097 bytes
+static const uint8_t WEB_INDEX_HTML_GZ[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x5a, 0x5b, 0x8f, 0xdb, 0xc6,
+  0x15, 0x7e, 0xd7, 0xaf, 0x18, 0xb3, 0x30, 0x24, 0xb5, 0x2b, 0x8a, 0x5a, 0x79, 0x5d, 0x47, 0xbb,
+  0xda, 0x24, 0x5e, 0xaf, 0x2f, 0x81, 0x6f, 0x8d, 0x37, 0x0f, 0x41, 0x62, 0x14, 0x23, 0x72, 0x28,
+  0x4d, 0x96, 0xe2, 0x30, 0x43, 0x6a, 0x65, 0xc5, 0x09, 0x90, 0x87, 0xbe, 0x17, 0x6d, 0x5a, 0x14,
+  0x0d, 0x5a, 0xb4, 0x05, 0xda, 0xfe, 0x86, 0x3e, 0xb5, 0xff, 0xc5, 0x7f, 0xa0, 0xfd, 0x09, 0x3d,
+  0x67, 0x66, 0x48, 0x0e, 0x2f, 0xf2, 0x6a, 0xd7, 0x29, 0x0a, 0x67, 0xa5, 0xe5, 0x70, 0x2e, 0xe7,
+  0xf2, 0x9d, 0xef, 0x9c, 0x33, 0x9b, 0xa3, 0x1b, 0xf7, 0x9e, 0x9d, 0x9c, 0x7d, 0xfa, 0xfc, 0x94,
+  0x2c, 0xb2, 0x65, 0x74, 0xdc, 0x39, 0xc2, 0x2f, 0x12, 0xd1, 0x78, 0x3e, 0x75, 0x58, 0xec, 0xe0,
+  0x00, 0xa3, 0x01, 0x7c, 0x2d, 0x59, 0x46, 0x89, 0xbf, 0xa0, 0x32, 0x65, 0xd9, 0xd4, 0xf9, 0xe4,
+  0xec, 0xfe, 0xe0, 0x8e, 0x93, 0x0f, 0xc7, 0x74, 0xc9, 0xa6, 0xce, 0x05, 0x67, 0xeb, 0x44, 0xc8,
+  0xcc, 0x21, 0xbe, 0x88, 0x33, 0x16, 0xc3, 0xb4, 0x35, 0x0f, 0xb2, 0xc5, 0x34, 0x60, 0x17, 0xdc,
+  0x67, 0x03, 0xf5, 0xb0, 0x47, 0x78, 0xcc, 0x33, 0x4e, 0xa3, 0x41, 0xea, 0xd3, 0x88, 0x4d, 0x47,
+  0xae, 0x87, 0xdb, 0x64, 0x3c, 0x8b, 0xd8, 0xf1, 0x03, 0x91, 0xf9, 0x0b, 0x4e, 0x4e, 0x44, 0x1c,
+  0xf2, 0xf9, 0x4a, 0xd2, 0x8c, 0x8b, 0xf8, 0x68, 0xa8, 0xdf, 0x75, 0x8e, 0xd2, 0x6c, 0x83, 0xdf,
+  0x3f, 0x26, 0xaf, 0x3b, 0x4b, 0x2a, 0xe7, 0x3c, 0x9e, 0x10, 0xef, 0xb0, 0x93, 0xd0, 0x20, 0xe0,
+  0xf1, 0x5c, 0xfd, 0x3e, 0x13, 0xaf, 0x06, 0x29, 0xff, 0x4a, 0x3d, 0xce, 0x84, 0x0c, 0x98, 0x1c,
+  0xc0, 0xd0, 0x61, 0xe7, 0x1b, 0x78, 0x13, 0x6c, 0x60, 0x5d, 0x08, 0x82, 0x0d, 0x42, 0xba, 0xe4,
+  0xd1, 0x66, 0x42, 0xba, 0x27, 0x62, 0x25, 0x39, 0x93, 0xe4, 0x29, 0x5b, 0x77, 0xf7, 0xc8, 0x52,
+  0xc4, 0x22, 0x4d, 0xa8, 0xcf, 0x60, 0x1f, 0xea, 0x9f, 0xcf, 0xa5, 0x58, 0xc5, 0xc1, 0x84, 0x44,
+  0x3c, 0x66, 0x54, 0x0e, 0xe6, 0x92, 0x06, 0x1c, 0x74, 0xea, 0x8d, 0xc6, 0x07, 0x01, 0x9b, 0xef,
+  0x91, 0x1f, 0x79, 0x14, 0xff, 0x11, 0xef, 0x26, 0xfc, 0x3e, 0xa2, 0x23, 0xba, 0xcf, 0xc8, 0xc8,
+  0xf3, 0x6e, 0xf6, 0x0f, 0x3b, 0xbe, 0x88, 0x84, 0x9c, 0xc0, 0x0c, 0x2f, 0x0c, 0x6f, 0x8d, 0x0e,
+  0x3b, 0x4b, 0x1e, 0x0f, 0x16, 0x8c, 0xcf, 0x17, 0xd9, 0x04, 0xa7, 0x5c, 0x2c, 0x2c, 0xa9, 0xf7,
+  0xbd, 0x44, 0x09, 0xe8, 0xa2, 0xcd, 0x28, 0x9c, 0x25, 0x95, 0x7a, 0xaf, 0xb4, 0xb5, 0x26, 0xe4,
+  0xb6, 0xa7, 0x26, 0x14, 0x0a, 0x13, 0xba, 0xca, 0x04, 0x2e, 0x40, 0xb7, 0xa8, 0xc9, 0x19, 0x7b,
+  0x95, 0x0d, 0x68, 0xc4, 0xe7, 0xf0, 0xda, 0x07, 0x09, 0x99, 0xcc, 0xa7, 0x83, 0xf2, 0x59, 0x26,
+  0x96, 0x13, 0x32, 0x56, 0x7b, 0xd4, 0xce, 0xb4, 0x95, 0x94, 0xf3, 0x19, 0xed, 0x79, 0x7b, 0x64,
+  0xff, 0xe0, 0x60, 0x8f, 0xdc, 0x86, 0x1f, 0xcf, 0xf5, 0x0e, 0xfa, 0x68, 0x50, 0x34, 0x22, 0xac,
+  0x48, 0x5e, 0x91, 0x54, 0x44, 0x3c, 0x28, 0x95, 0x32, 0xf6, 0x45, 0xb3, 0xac, 0x52, 0xd4, 0x4b,
+  0x1d, 0x21, 0x52, 0x8e, 0x4e, 0x83, 0x1d, 0x59, 0x04, 0xee, 0xbb, 0x00, 0x63, 0x8a, 0x0b, 0x26,
+  0xc3, 0x48, 0xac, 0x27, 0x64, 0xc1, 0x83, 0x80, 0xc5, 0xa5, 0xf0, 0x93, 0xc9, 0x8c, 0x85, 0x42,
+  0x32, 0x50, 0xc2, 0x20, 0x06, 0x9c, 0xd2, 0xb5, 0x77, 0xa1, 0x33, 0x38, 0x75, 0x95, 0xc1, 0x2e,
+  0x99, 0x48, 0x94, 0x8b, 0x23, 0x16, 0xc2, 0xac, 0x01, 0x5a, 0xfa, 0xb0, 0x63, 0x6c, 0xa4, 0x1f,
+  0x2c, 0x0b, 0xdf, 0x7c, 0xbb, 0x0b, 0xdf, 0xf3, 0x94, 0x07, 0x33, 0x49, 0x63, 0x70, 0xb8, 0x84,
+  0xa1, 0xbd, 0x36, 0x0b, 0x8c, 0xfa, 0x95, 0x39, 0x60, 0x0e, 0x1a, 0xf3, 0x25, 0xd5, 0x92, 0x01,
+  0x7a, 0x63, 0x32, 0x4e, 0x01, 0xcd, 0x21, 0x02, 0x9a, 0xa1, 0x56, 0x1f, 0x9c, 0xb3, 0x4d, 0x28,
+  0x21, 0x16, 0x52, 0xfd, 0xfa, 0x75, 0xc7, 0xbb, 0x49, 0x5e, 0x13, 0x5b, 0x64, 0xf2, 0x4d, 0x07,
+  0xbf, 0x8b, 0xd1, 0x7c, 0x10, 0x4c, 0x32, 0xca, 0xf1, 0x09, 0x08, 0x66, 0x60, 0x72, 0xb6, 0x6c,
+  0x22, 0x49, 0xf9, 0x3a, 0x5d, 0xd0, 0x00, 0xcd, 0xe9, 0xc1, 0x3f, 0x34, 0x7b, 0xfe, 0x7a, 0x4f,
+  0x8d, 0xec, 0x5b, 0x23, 0x0d, 0x20, 0x68, 0x2f, 0x45, 0x2c, 0x03, 0x94, 0x0c, 0x10, 0xec, 0x1a,
+  0x0f, 0x06, 0x82, 0x34, 0xf5, 0x39, 0x1f, 0x50, 0x99, 0x55, 0x25, 0xf1, 0xdc, 0xdb, 0x28, 0x0b,
+  0x5a, 0xb1, 0x84, 0xb1, 0xbb, 0x6f, 0x4b, 0xe7, 0xfb, 0xe3, 0x71, 0x71, 0x98, 0x72, 0xd5, 0xc8,
+  0xe0, 0x3a, 0xa6, 0x17, 0xb0, 0x5b, 0xc0, 0xd3, 0x24, 0xa2, 0x10, 0x73, 0x61, 0xc4, 0x60, 0xf8,
+  0x8b, 0x55, 0x9a, 0xf1, 0x70, 0x33, 0x28, 0xbc, 0x9e, 0xe3, 0x76, 0x4e, 0x93, 0x1c, 0x9e, 0xad,
+  0x10, 0xc6, 0xe5, 0x83, 0xb5, 0xc4, 0x59, 0xf8, 0x99, 0x1f, 0x40, 0x15, 0x82, 0x5a, 0x4c, 0x15,
+  0x30, 0x5f, 0x48, 0xe3, 0xb1, 0x58, 0xc4, 0xcc, 0x0a, 0x02, 0x65, 0x39, 0x13, 0x09, 0x06, 0xe5,
+  0xa3, 0x4b, 0x51, 0x7e, 0x80, 0xd3, 0x15, 0x26, 0x72, 0x80, 0x46, 0x11, 0xd8, 0x67, 0x9c, 0xee,
+  0x16, 0x4e, 0x46, 0xda, 0xc9, 0x02, 0x63, 0x02, 0x64, 0xbe, 0x64, 0xcd, 0x7e, 0xdf, 0x50, 0x9a,
+  0xed, 0x70, 0x10, 0xa1, 0x6d, 0x2e, 0x6e, 0xaf, 0x04, 0x83, 0x80, 0x02, 0x73, 0xa9, 0x5f, 0x21,
+  0x02, 0xd9, 0xa7, 0xbd, 0x01, 0xb8, 0xb7, 0xaf, 0x29, 0x86, 0xca, 0xa0, 0xed, 0xd4, 0x11, 0x6c,
+  0x95, 0xff, 0x78, 0xee, 0x9d, 0xeb, 0xc4, 0x7d, 0x41, 0x2d, 0x07, 0x2d, 0xbe, 0xcb, 0xad, 0x5c,
+  0xd5, 0x44, 0x01, 0x75, 0x8b, 0xd6, 0x20, 0x2c, 0xea, 0x31, 0x40, 0x31, 0x13, 0x8b, 0xef, 0xd5,
+  0x1a, 0x0f, 0xdf, 0x47, 0x74, 0xc6, 0x22, 0x1b, 0x59, 0xb3, 0x48, 0xf8, 0xe7, 0x8d, 0xa3, 0xef,
+  0x28, 0xd4, 0x20, 0x96, 0xd7, 0x06, 0xb9, 0x33, 0x11, 0x05, 0xcd, 0xc0, 0xaa, 0xc0, 0xfd, 0xbd,
+  0x03, 0xc4, 0xbb, 0x02, 0x90, 0x65, 0xd2, 0x55, 0x92, 0x30, 0xe9, 0xd3, 0x94, 0x35, 0x03, 0x68,
+  0xa4, 0xb1, 0xce, 0xe3, 0x64, 0x95, 0x7d, 0x96, 0x6d, 0x12, 0x48, 0x86, 0xb8, 0xda, 0x79, 0x89,
+  0xd9, 0xae, 0x1c, 0x8b, 0x57, 0xcb, 0x19, 0x93, 0xce, 0x4b, 0x10, 0xbb, 0xc2, 0x5c, 0x25, 0x26,
+  0xf7, 0x0b, 0x71, 0xb5, 0x2c, 0xa3, 0xdb, 0x36, 0x3e, 0xdb, 0xbc, 0xd1, 0x82, 0x20, 0xf3, 0x9f,
+  0x82, 0x44, 0x5d, 0xcf, 0x36, 0x3c, 0xef, 0x98, 0x14, 0xdb, 0x61, 0xdf, 0xa6, 0xf5, 0x24, 0x14,
+  0xfe, 0x2a, 0x6d, 0xd7, 0x5d, 0xbf, 0x03, 0x0b, 0x88, 0x55, 0x86, 0x8c, 0x92, 0xc7, 0xe5, 0x55,
+  0x70, 0xfe, 0x36, 0xa5, 0x7f, 0xaa, 0xd1, 0x83, 0x0a, 0x8a, 0x02, 0x3e, 0x35, 0xfa, 0x51, 0x2c,
+  0x12, 0x70, 0xc9, 0x7c, 0xad, 0x0d, 0x18, 0x69, 0xb5, 0x8c, 0x0d, 0xfb, 0x68, 0x1f, 0xb4, 0x51,
+  0x99, 0xd9, 0x54, 0x24, 0xb8, 0xaa, 0xb9, 0xab, 0x4a, 0xc1, 0x03, 0x48, 0x05, 0xcb, 0xb4, 0x24,
+  0xb4, 0x9a, 0x6b, 0x9b, 0x4c, 0xd3, 0xa2, 0xe2, 0xb8, 0xdf, 0xee, 0x27, 0x7f, 0x25, 0x53, 0x74,
+  0x66, 0x22, 0xb8, 0xde, 0x7c, 0x77, 0x22, 0xca, 0xad, 0x33, 0xee, 0x37, 0x14, 0xd9, 0x95, 0x8c,
+  0x46, 0xa5, 0x54, 0x75, 0x50, 0xd5, 0x4d, 0x63, 0xfb, 0x5d, 0xbd, 0x50, 0x90, 0x37, 0x26, 0x95,
+  0x26, 0x81, 0x28, 0x7b, 0xe4, 0x61, 0xa0, 0xc2, 0xb4, 0xc8, 0x2d, 0x77, 0x5a, 0xb5, 0xa5, 0x3e,
+  0x1a, 0xf5, 0xd2, 0xc3, 0x73, 0x62, 0xb0, 0x4a, 0xc4, 0xc6, 0x56, 0xe8, 0x30, 0x38, 0xa7, 0x19,
+  0xe3, 0x1a, 0x8b, 0xf5, 0xf0, 0x8e, 0xe1, 0x1d, 0x8d, 0x6a, 0x3c, 0x92, 0x0f, 0x42, 0x6d, 0xb9,
+  0x02, 0xae, 0x89, 0xb7, 0x07, 0xf5, 0xad, 0xf6, 0xa0, 0xb6, 0xcc, 0x5d, 0x28, 0x53, 0x2a, 0xe7,
+  0x95, 0x60, 0xd1, 0x42, 0x35, 0x95, 0x68, 0xb2, 0x5a, 0x13, 0xb5, 0xef, 0x12, 0xef, 0xbb, 0xf3,
+  0xdf, 0xfe, 0xf6, 0xb4, 0xb8, 0x6b, 0x45, 0xa8, 0x8d, 0x78, 0xe5, 0x8a, 0xf0, 0x00, 0x4d, 0xad,
+  0x4b, 0xa9, 0x03, 0xab, 0x22, 0xf4, 0x4a, 0x34, 0x79, 0x4d, 0x23, 0xd4, 0xeb, 0x43, 0x85, 0x76,
+  0x05, 0xf5, 0xf2, 0x63, 0x7b, 0x46, 0xed, 0x0d, 0x0e, 0xb0, 0xe6, 0xc7, 0xcf, 0x7e, 0x55, 0x6b,
+  0x75, 0x38, 0x96, 0x4b, 0xc0, 0x7d, 0xfa, 0x78, 0xf5, 0x60, 0xa9, 0xa7, 0x62, 0xcd, 0x52, 0xd2,
+  0x88, 0x3b, 0xd6, 0x45, 0x7e, 0x2e, 0xb2, 0x79, 0xac, 0xae, 0xc2, 0x08, 0xad, 0x67, 0xd0, 0x2d,
+  0x1c, 0x79, 0xe7, 0xf2, 0x5a, 0xc0, 0xec, 0x4c, 0x7d, 0xf4, 0x08, 0x36, 0x11, 0xad, 0xd3, 0x3d,
+  0x6b, 0xae, 0x9b, 0x42, 0x2d, 0x15, 0x07, 0x54, 0x6e, 0x6a, 0x5c, 0x61, 0x95, 0xc8, 0xdb, 0xf2,
+  0x4d, 0x6b, 0xea, 0x6a, 0x6e, 0x7c, 0x15, 0x2a, 0x82, 0xb0, 0x87, 0x3a, 0x3b, 0xa5, 0x73, 0x94,
+  0xbe, 0x8c, 0xb5, 0x03, 0xbb, 0x59, 0x52, 0x39, 0xc4, 0xbb, 0x4a, 0x35, 0xa3, 0xeb, 0xbb, 0x96,
+  0x86, 0x6a, 0x07, 0x89, 0xec, 0xe6, 0x00, 0xce, 0x60, 0xf7, 0xc4, 0x3a, 0x56, 0x41, 0x40, 0x18,
+  0x04, 0xcd, 0x00, 0xf2, 0x5d, 0xbd, 0x47, 0x28, 0x66, 0x41, 0xb9, 0x2d, 0xc5, 0x12, 0x93, 0x22,
+  0x46, 0x54, 0xb6, 0x51, 0xa8, 0xdd, 0xe6, 0x41, 0xcf, 0xb8, 0x30, 0x13, 0xf6, 0x82, 0xd1, 0xe1,
+  0x5b, 0x7d, 0x08, 0xe6, 0x82, 0x4e, 0x45, 0x60, 0x3b, 0x7c, 0xb9, 0x7d, 0xad, 0xd6, 0x6f, 0xa0,
+  0x63, 0xeb, 0x56, 0xd3, 0x72, 0xb5, 0xcc, 0x56, 0xb7, 0x79, 0xb5, 0xa0, 0xc2, 0x7a, 0xaa, 0x66,
+  0xea, 0xb1, 0x49, 0xaa, 0x33, 0x95, 0x10, 0x62, 0xf0, 0xe5, 0xe0, 0x82, 0x46, 0x2b, 0x66, 0x27,
+  0x56, 0x1e, 0xab, 0xa6, 0x23, 0x2f, 0xed, 0x80, 0xda, 0x4c, 0xc0, 0xdc, 0xf2, 0xb6, 0x39, 0xaa,
+  0xb5, 0xb0, 0xab, 0xb2, 0x24, 0x38, 0x61, 0xc9, 0x02, 0x4e, 0x49, 0xaf, 0xde, 0x67, 0xf7, 0x55,
+  0x90, 0xa9, 0x9b, 0x82, 0x4a, 0x9f, 0x70, 0xd8, 0xd2, 0x9f, 0x8d, 0x5c, 0x55, 0x25, 0x96, 0x65,
+  0x75, 0x0d, 0x84, 0x79, 0xeb, 0xa3, 0x8b, 0x0a, 0xab, 0x1b, 0xa2, 0xf6, 0x5c, 0x48, 0x75, 0x66,
+  0x7e, 0xd3, 0x60, 0xca, 0x6b, 0x91, 0xa0, 0x38, 0x73, 0xbb, 0x55, 0x8c, 0xfc, 0xfb, 0x15, 0x06,
+  0xa9, 0xf6, 0x35, 0xe3, 0xab, 0x56, 0x1b, 0x8a, 0x20, 0xf5, 0x18, 0xb0, 0x6c, 0x23, 0xe5, 0xda,
+  0x48, 0x4f, 0x78, 0x4c, 0x46, 0xa9, 0x69, 0xb1, 0xb7, 0x76, 0xc3, 0x38, 0xeb, 0xb5, 0x42, 0x2c,
+  0xb1, 0x50, 0x2a, 0x45, 0x86, 0x7c, 0x3a, 0xbe, 0x8d, 0xfd, 0x78, 0x5f, 0xb7, 0xc1, 0x47, 0x43,
+  0x73, 0xcd, 0x73, 0x34, 0x34, 0x17, 0x4f, 0xe8, 0x10, 0xf8, 0x0a, 0xf8, 0x05, 0xf1, 0x23, 0x9a,
+  0xa6, 0x53, 0xa7, 0xb8, 0x2a, 0xc9, 0xaf, 0xa7, 0x98, 0xc4, 0x5f, 0x46, 0xc7, 0x6f, 0xbe, 0xff,
+  0x0b, 0x79, 0xf0, 0xec, 0xec, 0xe4, 0xe1, 0x23, 0x72, 0xf2, 0xec, 0xe9, 0xfd, 0x47, 0x0f, 0x08,
+  0x8c, 0xc0, 0x46, 0xa3, 0xea, 0xfa, 0xa2, 0xcf, 0x85, 0xf5, 0x3d, 0xf2, 0xe6, 0x77, 0xbf, 0x7d,
+  0xf3, 0xed, 0xbf, 0xe0, 0xb3, 0x4f, 0x92, 0x75, 0x8c, 0xb6, 0xce, 0x16, 0x8c, 0x50, 0x2e, 0xd7,
+  0xf4, 0x82, 0xa5, 0x20, 0x07, 0xac, 0xcc, 0xc5, 0x51, 0x07, 0x81, 0x13, 0xe1, 0x93, 0x92, 0x85,
+  0x64, 0xe1, 0xd4, 0x19, 0x3a, 0x70, 0xec, 0xef, 0xff, 0xfd, 0x8f, 0x5f, 0x9a, 0x6b, 0xab, 0xa3,
+  0x21, 0xb5, 0xdf, 0x86, 0x90, 0x5c, 0xe3, 0x20, 0x75, 0x8e, 0xff, 0xf3, 0xa7, 0x5f, 0xfd, 0x8d,
+  0xdc, 0xd7, 0x4f, 0xb5, 0x39, 0x10, 0xc3, 0xe7, 0x2c, 0x53, 0x73, 0xbe, 0xfb, 0x3b, 0x79, 0xae,
+  0x9f, 0x6a, 0x73, 0x68, 0xc2, 0x87, 0xec, 0x15, 0x5e, 0xaf, 0xbd, 0x3f, 0xff, 0x8a, 0x27, 0xd3,
+  0x11, 0xce, 0xfe, 0xf5, 0x3f, 0xc9, 0xa9, 0x1a, 0xd3, 0x93, 0x87, 0x5a, 0x32, 0xdb, 0x52, 0x00,
+  0x4d, 0x34, 0x12, 0xda, 0x9b, 0xf0, 0x40, 0x99, 0x0e, 0x64, 0xbc, 0x0f, 0x8f, 0x4e, 0x75, 0x66,
+  0xd9, 0x6e, 0xe1, 0x0b, 0x5d, 0x44, 0xc1, 0xd8, 0xd4, 0xd1, 0x97, 0x77, 0x3f, 0xc7, 0x2b, 0x3e,
+  0xe7, 0xf8, 0x9e, 0x7a, 0x20, 0x4f, 0xe1, 0xe1, 0x68, 0xa8, 0x26, 0xc1, 0x64, 0x55, 0xee, 0x11,
+  0xab, 0x01, 0x50, 0x27, 0xd9, 0xeb, 0xcc, 0x05, 0x61, 0x65, 0x08, 0x62, 0x2f, 0x62, 0xf1, 0x3c,
+  0x5b, 0x4c, 0x9d, 0xf1, 0xc8, 0x81, 0xea, 0xe0, 0xcb, 0x15, 0x54, 0xe4, 0x01, 0x01, 0x8c, 0xfb,
+  0x6c, 0x01, 0x81, 0xca, 0xe0, 0xf0, 0x53, 0x0c, 0x6a, 0xa2, 0xd7, 0x11, 0x2d, 0x42, 0x45, 0xea,
+  0x9c, 0xd3, 0x1c, 0xa2, 0x50, 0x33, 0x75, 0xec, 0x0a, 0x08, 0xcb, 0x48, 0x98, 0xff, 0x84, 0xbe,
+  0x22, 0xe3, 0x91, 0xba, 0xba, 0x84, 0x74, 0xc7, 0x64, 0xea, 0x92, 0xb3, 0x05, 0x4f, 0x41, 0x48,
+  0xa0, 0x0c, 0x1e, 0x72, 0xc0, 0xe7, 0x06, 0x6a, 0xa0, 0xfc, 0x14, 0xa8, 0xe4, 0xd0, 0xff, 0x31,
+  0xcb, 0xd6, 0x42, 0x9e, 0xbb, 0xa5, 0xff, 0xf5, 0xd7, 0x2e, 0x26, 0x2b, 0x29, 0x0d, 0x5e, 0xdc,
+  0xd3, 0x61, 0x4b, 0xee, 0x16, 0x83, 0x13, 0x72, 0x04, 0xf9, 0x32, 0xce, 0xb7, 0xa9, 0x13, 0xa0,
+  0x36, 0x9f, 0x35, 0x6a, 0x02, 0xdf, 0x39, 0x1e, 0xed, 0xdf, 0x81, 0xf0, 0x80, 0xa5, 0x28, 0x4e,
+  0x9b, 0xf5, 0x21, 0xb4, 0xe6, 0x8d, 0xf5, 0xb9, 0xf5, 0xed, 0x11, 0xa0, 0xd2, 0xa9, 0xe3, 0x29,
+  0x27, 0x4c, 0x1d, 0x20, 0x03, 0x87, 0xa8, 0xa3, 0xa7, 0x0e, 0x1c, 0xe1, 0x74, 0x8c, 0x2d, 0xed,
+  0x72, 0x96, 0xb4, 0x57, 0xdf, 0x24, 0x27, 0x1c, 0xb4, 0x35, 0xa9, 0x97, 0xa8, 0xd7, 0x70, 0xd6,
+  0xc7, 0xa8, 0x01, 0x56, 0x37, 0x3d, 0x11, 0x86, 0x7d, 0x02, 0x8c, 0x01, 0xd2, 0x29, 0xa2, 0xee,
+  0xbb, 0xe4, 0xc3, 0x00, 0x2f, 0x8e, 0xd0, 0xc6, 0x64, 0x46, 0xb1, 0x02, 0xdd, 0x00, 0xef, 0x84,
+  0x8c, 0x5c, 0xa4, 0xe4, 0x82, 0xa7, 0x7c, 0xc6, 0x23, 0x48, 0x85, 0x57, 0xf4, 0xd8, 0xf1, 0x73,
+  0x40, 0x84, 0x88, 0x29, 0x2e, 0x25, 0x4f, 0x44, 0x60, 0xe1, 0xda, 0x5a, 0x68, 0xb5, 0x93, 0x4e,
+  0xdb, 0x1b, 0xdd, 0x7b, 0x38, 0x0d, 0x77, 0x60, 0xef, 0xa3, 0xdc, 0xa1, 0x69, 0x20, 0xda, 0xe4,
+  0xce, 0x48, 0xca, 0x53, 0x0b, 0xdb, 0x97, 0x73, 0xfc, 0x05, 0x03, 0x0e, 0x08, 0xaa, 0xa8, 0x2a,
+  0x5e, 0x43, 0xe0, 0xff, 0xf5, 0x8f, 0x86, 0x4a, 0xa2, 0x0d, 0x19, 0x90, 0x8f, 0xd0, 0x2a, 0x91,
+  0x10, 0xe7, 0x48, 0x5e, 0x68, 0x9d, 0x30, 0xa7, 0x99, 0x5c, 0x95, 0xa6, 0x29, 0x76, 0x94, 0x9b,
+  0xf2, 0xb7, 0x49, 0x0c, 0x6f, 0xab, 0x32, 0xe2, 0x00, 0x10, 0xdd, 0xb7, 0xe4, 0xc3, 0x47, 0x20,
+  0xd7, 0xcf, 0x56, 0x9c, 0x65, 0x20, 0x61, 0x1a, 0xf3, 0x30, 0x44, 0xd9, 0xa8, 0xaa, 0x39, 0x1a,
+  0x62, 0x55, 0xbf, 0x4c, 0x3b, 0xa5, 0x45, 0x49, 0x57, 0xb3, 0x25, 0xcf, 0x0c, 0xd7, 0xbd, 0x00,
+  0x42, 0xae, 0xff, 0x71, 0x40, 0xcf, 0xae, 0x2f, 0xd3, 0x0f, 0x4e, 0xae, 0x6c, 0x51, 0x61, 0x3a,
+  0x10, 0xde, 0x7e, 0xc4, 0xfd, 0x73, 0x50, 0x92, 0xa5, 0x2c, 0xd3, 0x9b, 0xf5, 0xfa, 0x78, 0xc0,
+  0x6f, 0x7e, 0x41, 0x3e, 0xc6, 0x31, 0x04, 0xdd, 0x3d, 0x16, 0xd2, 0x55, 0x84, 0x24, 0x5c, 0xec,
+  0x3f, 0x44, 0xf0, 0x54, 0x4d, 0x89, 0x06, 0x32, 0x45, 0x68, 0x71, 0x54, 0xf1, 0x6c, 0x30, 0x9e,
+  0x67, 0x6d, 0xd5, 0xc4, 0x39, 0xc7, 0x35, 0x5d, 0x53, 0x5f, 0xf2, 0x24, 0x3b, 0xee, 0x0c, 0x87,
+  0xe4, 0x93, 0x24, 0x80, 0x64, 0x48, 0xca, 0x28, 0x25, 0x66, 0xa9, 0x36, 0x36, 0xf6, 0x43, 0xe0,
+  0xe5, 0xf2, 0xf5, 0x23, 0xe5, 0xb0, 0x29, 0x09, 0x84, 0xbf, 0x5a, 0x42, 0x68, 0xba, 0x73, 0x96,
+  0x9d, 0x46, 0x0c, 0x7f, 0xbd, 0xbb, 0x79, 0x14, 0xf4, 0xba, 0xe5, 0xd4, 0xae, 0xba, 0x08, 0xaa,
+  0x2e, 0xcf, 0x69, 0x69, 0xa7, 0x0d, 0x72, 0x0a, 0xc2, 0x8d, 0x6a, 0x12, 0xb8, 0x50, 0xc9, 0x9c,
+  0x5e, 0xc0, 0x9a, 0xc7, 0x3c, 0x85, 0x7e, 0x8d, 0xc9, 0x5e, 0x57, 0x41, 0x09, 0x7a, 0xc9, 0x70,
+  0x15, 0xab, 0x0b, 0x96, 0x9e, 0x2a, 0xab, 0xea, 0x27, 0xbb, 0x98, 0x2a, 0x4e, 0x74, 0x93, 0x07,
+  0x52, 0x64, 0x40, 0xc9, 0xae, 0xd2, 0x14, 0x6a, 0x07, 0x38, 0x06, 0x2c, 0xf2, 0x18, 0x4a, 0x1f,
+  0xe4, 0x14, 0xec, 0x2c, 0x88, 0x6f, 0xbb, 0x1d, 0x49, 0x3a, 0xc1, 0xd2, 0x1f, 0xab, 0x23, 0xa8,
+  0x80, 0x62, 0x68, 0x89, 0x5c, 0x11, 0xe3, 0x13, 0x6c, 0x55, 0x39, 0x57, 0xeb, 0xbd, 0x4c, 0xe7,
+  0x6f, 0xd3, 0xd4, 0x38, 0x0d, 0xd5, 0x83, 0x99, 0x35, 0xc9, 0xba, 0x8f, 0x4d, 0x09, 0x56, 0x11,
+  0xc1, 0x75, 0xdd, 0xae, 0x9e, 0xad, 0x1c, 0xed, 0x06, 0x85, 0x3d, 0xbb, 0xaa, 0x30, 0x83, 0x97,
+  0x21, 0xcb, 0xfc, 0x45, 0xaf, 0xab, 0x52, 0xb7, 0x5e, 0xdb, 0xed, 0x77, 0x5c, 0x48, 0x2e, 0x71,
+  0x0f, 0xc0, 0x97, 0x80, 0x60, 0x8c, 0x4c, 0x8f, 0x41, 0x46, 0x1e, 0x92, 0xde, 0x8d, 0x7c, 0xc8,
+  0x15, 0xe7, 0xc0, 0x7b, 0x0b, 0x29, 0xd6, 0x90, 0x83, 0xd6, 0xe4, 0x54, 0x4a, 0x01, 0x36, 0xbd,
+  0x4f, 0x79, 0x04, 0xc9, 0x11, 0xa0, 0xa9, 0x94, 0xcc, 0xb7, 0x3b, 0xec, 0x48, 0x96, 0xad, 0x64,
+  0x4c, 0x8a, 0xd5, 0x5f, 0xa4, 0xa8, 0x38, 0xda, 0xd0, 0x1c, 0x05, 0xa8, 0xa2, 0xfa, 0x98, 0xad,
+  0xea, 0x5b, 0x79, 0xb9, 0xdb, 0xd7, 0x4e, 0x40, 0x6b, 0xc1, 0x42, 0xd7, 0x7a, 0x45, 0xbe, 0xfe,
+  0x5a, 0xf5, 0xe2, 0x75, 0x24, 0xc1, 0xd4, 0x04, 0xff, 0x2a, 0xf8, 0x28, 0xce, 0xd4, 0x61, 0x56,
+  0x45, 0xdf, 0xc7, 0x35, 0x90, 0x52, 0x0e, 0x3b, 0x3b, 0xa1, 0xb4, 0x38, 0xba, 0x1c, 0x3c, 0xbc,
+  0x14, 0x38, 0xf6, 0x5c, 0x2d, 0x9a, 0xc5, 0x54, 0xf0, 0x5e, 0xcb, 0x64, 0x8f, 0xa1, 0x1e, 0x39,
+  0x99, 0xc2, 0xa1, 0x99, 0x78, 0x2c, 0xd6, 0x4c, 0x9e, 0x40, 0x93, 0xd6, 0x2b, 0x02, 0x45, 0x51,
+  0xe0, 0xdd, 0x2c, 0x7e, 0x0b, 0x6a, 0xac, 0x2d, 0x61, 0x19, 0xfa, 0x30, 0x5f, 0xd4, 0x2f, 0x96,
+  0xbb, 0x86, 0xc9, 0x11, 0xe0, 0x12, 0xa1, 0xdd, 0x02, 0xaf, 0x37, 0x7f, 0xf8, 0xae, 0x4a, 0x6a,
+  0xca, 0xc5, 0x2c, 0x00, 0x53, 0x03, 0x1b, 0x9d, 0xf1, 0x25, 0x83, 0xd6, 0xb1, 0x07, 0x60, 0x46,
+  0x27, 0x92, 0x56, 0xc4, 0x21, 0xb9, 0x74, 0xa1, 0x7e, 0x86, 0xc2, 0xde, 0xf3, 0x3c, 0xe3, 0x7d,
+  0x9f, 0x22, 0xfc, 0x18, 0xe2, 0x47, 0xfb, 0x1f, 0x35, 0x13, 0xb0, 0x90, 0x69, 0x48, 0x29, 0x64,
+  0x4d, 0x20, 0x4e, 0xd5, 0x73, 0x3b, 0xf4, 0xdf, 0x7c, 0xff, 0x67, 0xd2, 0x0a, 0x3d, 0x23, 0xea,
+  0xb5, 0x64, 0x1c, 0xe7, 0x32, 0xc2, 0x8f, 0x0a, 0xf4, 0x87, 0x14, 0x5c, 0xc1, 0x88, 0x2a, 0x52,
+  0x15, 0xe1, 0xa7, 0x29, 0xec, 0xbd, 0x1d, 0x33, 0x65, 0x11, 0x0b, 0xee, 0x03, 0xa5, 0x54, 0x8e,
+  0xb0, 0x03, 0x9f, 0x61, 0xe4, 0x33, 0x37, 0x91, 0x0c, 0x99, 0xc9, 0x90, 0x79, 0xe9, 0x5c, 0xbd,
+  0x40, 0x7b, 0x57, 0xf1, 0xce, 0x97, 0x2b, 0xa8, 0x25, 0x5e, 0xb0, 0x88, 0xf9, 0x19, 0x5a, 0x46,
+  0x73, 0xfe, 0x67, 0x95, 0x0c, 0xf4, 0xb2, 0x24, 0x51, 0x01, 0x88, 0xe3, 0xe0, 0xf8, 0x33, 0xb0,
+  0x15, 0xec, 0x50, 0xec, 0x06, 0x1d, 0x36, 0xf0, 0xdf, 0xc3, 0xb3, 0x27, 0x8f, 0xc1, 0x2a, 0xcd,
+  0x41, 0x34, 0x42, 0xa5, 0xf0, 0x33, 0xad, 0x1d, 0x26, 0x05, 0x55, 0xd4, 0x61, 0x7e, 0x83, 0x67,
+  0xcd, 0x2c, 0xe5, 0x06, 0x60, 0x43, 0x3a, 0x8b, 0x2c, 0x0c, 0xb5, 0xa1, 0xbc, 0xb0, 0x55, 0x4d,
+  0x15, 0x7d, 0x15, 0xdb, 0xcc, 0xe0, 0x2f, 0x27, 0x06, 0x99, 0x79, 0xd4, 0xe5, 0xdb, 0x6a, 0xba,
+  0x40, 0xb6, 0x28, 0x23, 0x7f, 0x42, 0xae, 0x42, 0x1d, 0x6e, 0x26, 0xf9, 0xb2, 0xd7, 0xdf, 0xb3,
+  0x22, 0x77, 0x62, 0x31, 0xc4, 0xee, 0x44, 0x00, 0x5b, 0x58, 0x22, 0x4f, 0x6c, 0x8d, 0x11, 0x38,
+  0x36, 0xbd, 0xa6, 0x50, 0x19, 0x00, 0x92, 0x5f, 0x77, 0x96, 0x2c, 0x5b, 0x88, 0x60, 0x42, 0xba,
+  0xcf, 0x9f, 0xbd, 0x38, 0xeb, 0xee, 0x99, 0x3f, 0x34, 0x83, 0x00, 0xaf, 0xf1, 0xa6, 0x53, 0xe1,
+  0x7a, 0x70, 0x06, 0x7e, 0xed, 0xc2, 0x14, 0x9a, 0x24, 0x50, 0x0a, 0x28, 0x1c, 0x0f, 0x91, 0x36,
+  0xbb, 0x00, 0x4e, 0xd5, 0xfe, 0x4f, 0xc8, 0x47, 0x2f, 0x9e, 0x3d, 0x05, 0x08, 0x4b, 0x70, 0x07,
+  0x0f, 0x37, 0x8a, 0x42, 0xfa, 0x25, 0xa5, 0x5e, 0x99, 0xbd, 0x55, 0xe1, 0x12, 0xaa, 0x38, 0xda,
+  0x89, 0xb3, 0xe1, 0x0d, 0x00, 0xb6, 0x8c, 0xda, 0x77, 0x4c, 0x60, 0xc8, 0x30, 0x5d, 0xf2, 0x13,
+  0x62, 0xf6, 0x2d, 0x2e, 0xce, 0x90, 0x08, 0xab, 0xcc, 0x83, 0x76, 0x0c, 0x6e, 0xe4, 0xdb, 0x6c,
+  0xcd, 0x6c, 0xe5, 0x4b, 0x7d, 0x4b, 0x70, 0x82, 0x5d, 0x01, 0x4e, 0x30, 0x7d, 0x41, 0x77, 0x5b,
+  0x00, 0xd8, 0xa1, 0xb3, 0x05, 0xe3, 0x21, 0x8d, 0xf0, 0x8a, 0xf9, 0x1d, 0x68, 0xe5, 0x1a, 0xd4,
+  0xf7, 0x43, 0x18, 0xb9, 0x42, 0x95, 0x68, 0xc8, 0x06, 0x55, 0x6e, 0x37, 0x1b, 0x1a, 0x6d, 0x7c,
+  0xfb, 0xb2, 0x82, 0xe2, 0xff, 0x68, 0x53, 0x45, 0xd5, 0x39, 0xbf, 0x92, 0x4a, 0xed, 0x9c, 0x87,
+  0x80, 0xd2, 0x56, 0x2e, 0x7b, 0xca, 0x12, 0xba, 0x92, 0xc6, 0x3f, 0x03, 0xc0, 0x77, 0x06, 0x61,
+  0x94, 0xa2, 0x55, 0x02, 0x53, 0x56, 0xbf, 0xff, 0x79, 0xfc, 0x79, 0xac, 0x9a, 0x70, 0xaa, 0x37,
+  0xf4, 0x69, 0x1c, 0x0b, 0x28, 0x2a, 0x18, 0x81, 0xfe, 0x00, 0x4e, 0x77, 0xbb, 0x7d, 0xdc, 0x57,
+  0x07, 0x0a, 0x5e, 0x26, 0xfd, 0x00, 0x0e, 0x52, 0x22, 0x65, 0xef, 0x5a, 0xc8, 0x29, 0xd5, 0x91,
+  0x6a, 0x48, 0x95, 0x6a, 0xc8, 0xf5, 0xd9, 0x41, 0xdb, 0xea, 0x9a, 0xf4, 0xf0, 0x4e, 0xe1, 0xae,
+  0x94, 0xa9, 0x85, 0xfb, 0xf6, 0x88, 0x6e, 0xa0, 0xa7, 0x03, 0xf6, 0xd1, 0x36, 0x94, 0x0c, 0x93,
+  0x99, 0x12, 0x72, 0x8f, 0x8c, 0x0e, 0xfe, 0x87, 0x35, 0x88, 0x12, 0xf9, 0x3a, 0x91, 0xf5, 0x6e,
+  0xe0, 0xc7, 0x7b, 0x49, 0xd3, 0xab, 0x41, 0x4f, 0xa8, 0x6f, 0x24, 0x87, 0xfa, 0xff, 0x98, 0xfb,
+  0x2f, 0x51, 0x87, 0x8f, 0x36, 0x42, 0x27, 0x00, 0x00,
+};
+static const WebAsset WEB_INDEX_HTML = {"text/html", "\"f3c98a1bdd221bb3\"", WEB_INDEX_HTML_GZ, sizeof(WEB_INDEX_HTML_GZ), 10050};
+
+// list.html: 7944 -> 3071 bytes
+static const uint8_t WEB_LIST_HTML_GZ[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x59, 0xdd, 0x72, 0x23, 0x47,
+  0x15, 0xbe, 0xd7, 0x53, 0xf4, 0x2a, 0x1b, 0xcf, 0x88, 0x58, 0x23, 0x69, 0xbd, 0x76, 0x1c, 0xeb,
+  0x67, 0xc9, 0x3a, 0xde, 0x60, 0x58, 0x76, 0xb7, 0xe2, 0x4d, 0x8a, 0x90, 0x4a, 0xe1, 0xd6, 0x4c,
+  0x4b, 0xd3, 0xf1, 0x68, 0x46, 0x4c, 0xb7, 0xac, 0x55, 0x1c, 0x55, 0xe5, 0x0d, 0x28, 0xa0, 0x28,
+  0x0a, 0x6e, 0x20, 0x54, 0x85, 0x3b, 0xee, 0xb9, 0x82, 0x77, 0xc9, 0x0b, 0xc0, 0x23, 0xf0, 0x9d,
+  0xee, 0x9e, 0x1f, 0xc9, 0x76, 0xd6, 0x50, 0x4b, 0xa5, 0xd6, 0x9a, 0xee, 0x39, 0x7d, 0xfa, 0xf4,
+  0x77, 0xbe, 0xf3, 0xd3, 0x93, 0xc1, 0xbd, 0x0f, 0x9e, 0x1f, 0xbf, 0xfc, 0xf4, 0xc5, 0x09, 0x8b,
+  0xf5, 0x2c, 0x19, 0x35, 0x06, 0xf4, 0xc3, 0x12, 0x9e, 0x4e, 0x87, 0x4d, 0x91, 0x36, 0x69, 0x42,
+  0xf0, 0x08, 0x3f, 0x33, 0xa1, 0x39, 0x0b, 0x63, 0x9e, 0x2b, 0xa1, 0x87, 0xcd, 0x8f, 0x5f, 0x3e,
+  0x69, 0x1f, 0x36, 0x8b, 0xe9, 0x94, 0xcf, 0xc4, 0xb0, 0x79, 0x29, 0xc5, 0x72, 0x9e, 0xe5, 0xba,
+  0xc9, 0xc2, 0x2c, 0xd5, 0x22, 0x85, 0xd8, 0x52, 0x46, 0x3a, 0x1e, 0x46, 0xe2, 0x52, 0x86, 0xa2,
+  0x6d, 0x06, 0xbb, 0x4c, 0xa6, 0x52, 0x4b, 0x9e, 0xb4, 0x55, 0xc8, 0x13, 0x31, 0xec, 0x05, 0x5d,
+  0x52, 0xa3, 0xa5, 0x4e, 0xc4, 0xe8, 0xc3, 0x4c, 0x87, 0xb1, 0x1c, 0x74, 0xec, 0xa8, 0x31, 0x50,
+  0x7a, 0x45, 0xbf, 0x3f, 0x60, 0x57, 0x8d, 0x19, 0xcf, 0xa7, 0x32, 0x3d, 0x62, 0xdd, 0x7e, 0x63,
+  0xce, 0xa3, 0x48, 0xa6, 0x53, 0xf3, 0x3c, 0xce, 0x5e, 0xb5, 0x95, 0xfc, 0xd2, 0x0c, 0xc7, 0x59,
+  0x1e, 0x89, 0xbc, 0x8d, 0xa9, 0x7e, 0x63, 0x8d, 0x37, 0xd1, 0x0a, 0xeb, 0x26, 0x30, 0xa5, 0x3d,
+  0xe1, 0x33, 0x99, 0xac, 0x8e, 0x98, 0x77, 0x9c, 0x2d, 0x72, 0x29, 0x72, 0xf6, 0x4c, 0x2c, 0xbd,
+  0x5d, 0x36, 0xcb, 0xd2, 0x4c, 0xcd, 0x79, 0x28, 0xa0, 0x87, 0x87, 0x17, 0xd3, 0x3c, 0x5b, 0xa4,
+  0xd1, 0x11, 0x4b, 0x64, 0x2a, 0x78, 0xde, 0x9e, 0xe6, 0x3c, 0x92, 0x38, 0x85, 0xdf, 0xdb, 0xdb,
+  0x8f, 0xc4, 0x74, 0x97, 0xbd, 0xd5, 0xe5, 0xf4, 0x1f, 0xeb, 0xbe, 0x8d, 0xe7, 0x1e, 0xef, 0xf1,
+  0x07, 0x82, 0xf5, 0xba, 0xdd, 0xb7, 0x5b, 0xfd, 0x46, 0x98, 0x25, 0x59, 0x7e, 0x04, 0x89, 0xee,
+  0x64, 0xf2, 0xb0, 0xd7, 0x6f, 0xcc, 0x64, 0xda, 0x8e, 0x85, 0x9c, 0xc6, 0xfa, 0x88, 0x44, 0x2e,
+  0xe3, 0x9a, 0xd5, 0x0f, 0xba, 0x73, 0x63, 0x60, 0x40, 0x28, 0x71, 0xec, 0x95, 0x9b, 0xe3, 0xbd,
+  0xb2, 0xf8, 0x1c, 0xb1, 0xf7, 0xba, 0x46, 0xa0, 0x3c, 0x30, 0xe3, 0x0b, 0x9d, 0xd1, 0x02, 0x72,
+  0x84, 0x11, 0xd6, 0xe2, 0x95, 0x6e, 0xf3, 0x44, 0x4e, 0xf1, 0x3a, 0x84, 0x85, 0x22, 0x2f, 0xc4,
+  0x71, 0x78, 0xad, 0xb3, 0x19, 0x36, 0xd9, 0x27, 0x1d, 0x5b, 0x7b, 0xd6, 0x0f, 0x99, 0x4f, 0xc7,
+  0xdc, 0xef, 0xee, 0x42, 0x70, 0x7f, 0x97, 0x1d, 0xe0, 0x5f, 0x37, 0xe8, 0xee, 0xb7, 0x08, 0x50,
+  0x02, 0x11, 0x2b, 0xe6, 0xaf, 0x98, 0xca, 0x12, 0x19, 0x55, 0x87, 0x72, 0xf8, 0x12, 0x2c, 0x0b,
+  0x45, 0xe7, 0xb2, 0xe7, 0x88, 0x7b, 0x05, 0xcc, 0x70, 0x84, 0xc0, 0x7c, 0x70, 0x28, 0x66, 0xd7,
+  0x21, 0x31, 0x46, 0xab, 0x98, 0x47, 0xd9, 0x92, 0x0e, 0xd5, 0x35, 0xeb, 0xab, 0xd7, 0x89, 0xd0,
+  0x38, 0x47, 0x9b, 0xdc, 0x61, 0x2d, 0xb6, 0xca, 0x53, 0x7e, 0x09, 0xed, 0x91, 0x54, 0xf3, 0x84,
+  0xc3, 0x81, 0x93, 0x44, 0x60, 0xfa, 0x8b, 0x85, 0xd2, 0x72, 0xb2, 0x6a, 0x3b, 0x9a, 0x55, 0x20,
+  0x4c, 0xf9, 0x1c, 0xfb, 0xef, 0x57, 0xf0, 0x6d, 0xe1, 0x41, 0xcb, 0xdb, 0xcb, 0x9c, 0xa4, 0xe8,
+  0x6f, 0xb1, 0x01, 0xc7, 0x16, 0x37, 0x9a, 0x1b, 0x89, 0x30, 0xcb, 0xb9, 0x96, 0x19, 0x80, 0x4e,
+  0xb3, 0x54, 0xd4, 0x10, 0x35, 0xd6, 0x3b, 0x58, 0x1d, 0x64, 0xbd, 0xd7, 0x42, 0x66, 0x8c, 0xd0,
+  0x39, 0x4f, 0x95, 0xb4, 0x4a, 0x79, 0x92, 0x00, 0xf8, 0x3d, 0x75, 0x37, 0xdf, 0x38, 0x6b, 0x8f,
+  0xe2, 0xec, 0xd2, 0xf0, 0xe0, 0x35, 0x6b, 0x1e, 0xb4, 0x5c, 0x7c, 0xd4, 0x41, 0x87, 0x09, 0x37,
+  0xc9, 0x92, 0x7a, 0x63, 0xd8, 0x24, 0xcb, 0x01, 0x97, 0x79, 0x4c, 0xb8, 0x16, 0x9f, 0xfa, 0x6d,
+  0x78, 0xc2, 0xec, 0x1d, 0x24, 0xf2, 0x52, 0xdc, 0x91, 0x7d, 0x06, 0x97, 0x1a, 0x27, 0xba, 0xc1,
+  0x7b, 0x9b, 0x9c, 0x08, 0xc3, 0xbd, 0xbd, 0x52, 0x69, 0x90, 0x4d, 0x26, 0x14, 0x74, 0x35, 0x37,
+  0x1c, 0x1c, 0x1c, 0xd8, 0x18, 0xe1, 0x79, 0x44, 0x27, 0xbd, 0xc6, 0xca, 0x1b, 0xce, 0xb0, 0xd7,
+  0xba, 0x06, 0xf8, 0xe1, 0x46, 0x14, 0xf4, 0x0e, 0xeb, 0x81, 0xd5, 0x23, 0x65, 0xdd, 0x1b, 0x90,
+  0xef, 0x41, 0x6d, 0xf1, 0xaf, 0x1b, 0xbc, 0xdb, 0xba, 0xcd, 0x65, 0x3c, 0x95, 0x33, 0x47, 0x8e,
+  0x09, 0x22, 0xf3, 0x34, 0x35, 0xf3, 0x4c, 0x70, 0x25, 0xda, 0xd9, 0x42, 0x93, 0xfd, 0x3f, 0xbc,
+  0x10, 0xab, 0x49, 0x8e, 0xec, 0xa8, 0x0a, 0x11, 0x84, 0x4a, 0x9e, 0xcd, 0xf0, 0x93, 0x11, 0xd3,
+  0xf5, 0xca, 0x64, 0xb1, 0x9b, 0x91, 0x27, 0x8a, 0x19, 0xe4, 0x75, 0x56, 0x97, 0xef, 0xdd, 0x26,
+  0xdf, 0x35, 0xc2, 0x0e, 0xb4, 0x8a, 0x24, 0x16, 0x91, 0x6d, 0x7e, 0xdf, 0x2d, 0x17, 0x6c, 0x92,
+  0x87, 0xdc, 0x7a, 0x1b, 0xd1, 0xdc, 0xb6, 0xed, 0x32, 0x49, 0x6d, 0xc5, 0xac, 0x21, 0x4c, 0x5b,
+  0x6a, 0x31, 0x53, 0x15, 0x6d, 0xae, 0xc5, 0xa3, 0x0d, 0xe0, 0xee, 0x0d, 0x01, 0xdc, 0x2b, 0xb3,
+  0x26, 0xed, 0x62, 0x0a, 0xc4, 0x76, 0xda, 0xe9, 0x11, 0xc5, 0xcc, 0xcc, 0xd2, 0xa5, 0xde, 0x71,
+  0x96, 0x44, 0xd7, 0x33, 0x11, 0x94, 0x8c, 0x79, 0x34, 0x15, 0x75, 0x23, 0x65, 0x4a, 0x04, 0x6c,
+  0x8f, 0x93, 0x2c, 0xbc, 0xb8, 0x29, 0xa2, 0x6f, 0x09, 0x99, 0x2d, 0xba, 0x3d, 0xdc, 0xa0, 0x1b,
+  0x46, 0xce, 0xec, 0x8d, 0x48, 0x38, 0xdc, 0xbf, 0x29, 0x14, 0x5e, 0xe3, 0x8f, 0x5e, 0x0d, 0xe2,
+  0x08, 0x25, 0x57, 0x26, 0x6a, 0x23, 0x69, 0x59, 0x25, 0xd7, 0x23, 0xce, 0x9c, 0xaa, 0xac, 0x44,
+  0x81, 0x0d, 0x2a, 0x38, 0x34, 0x4d, 0x32, 0x1e, 0xb5, 0xf1, 0xf6, 0xe2, 0x76, 0x14, 0x9c, 0x07,
+  0x74, 0x56, 0xfa, 0xa4, 0x3c, 0xda, 0x21, 0x1d, 0xed, 0xe0, 0x0e, 0x35, 0xa5, 0xd7, 0xea, 0xdf,
+  0x35, 0xb5, 0xbe, 0x91, 0x34, 0xba, 0x7d, 0xba, 0xff, 0x57, 0xae, 0xc4, 0x3e, 0x62, 0x36, 0xd7,
+  0xab, 0xb6, 0xd2, 0x88, 0xbd, 0x5b, 0xb2, 0x62, 0xc5, 0x84, 0xaa, 0x58, 0x7c, 0x8f, 0xcb, 0x1c,
+  0x83, 0xeb, 0xb9, 0x2e, 0xe2, 0x2a, 0x16, 0x77, 0x4d, 0x76, 0xbd, 0x3b, 0x15, 0x79, 0x17, 0xac,
+  0x84, 0x10, 0x6c, 0xbb, 0x8b, 0xe5, 0x37, 0x46, 0x90, 0x5b, 0x7f, 0x74, 0xc4, 0x27, 0xda, 0x00,
+  0x5c, 0x16, 0x63, 0x2f, 0x08, 0x02, 0x6f, 0x23, 0x3b, 0x46, 0x99, 0x56, 0x38, 0xdd, 0xbe, 0x62,
+  0x4a, 0x8b, 0xb9, 0xf2, 0x1f, 0xee, 0x32, 0x91, 0x46, 0x2d, 0xd0, 0x6d, 0x42, 0xcd, 0xa0, 0xd8,
+  0xca, 0x94, 0x46, 0xfc, 0xaa, 0x41, 0x6d, 0xd6, 0x83, 0xee, 0xdb, 0xec, 0x8a, 0xd5, 0x54, 0x7b,
+  0x7d, 0xb6, 0x6e, 0x3c, 0xdc, 0x9e, 0xb5, 0xd3, 0x07, 0xb4, 0x82, 0x1a, 0xb2, 0xad, 0x97, 0xf6,
+  0x2d, 0xb6, 0x98, 0x89, 0x48, 0x72, 0xe6, 0xd7, 0x7a, 0xad, 0x03, 0xea, 0xb5, 0x5a, 0x26, 0x4b,
+  0x9a, 0x6e, 0x71, 0xa3, 0xbc, 0xdf, 0xdc, 0xdc, 0x3c, 0x24, 0x1f, 0x55, 0x95, 0xa9, 0x5a, 0xe1,
+  0x3a, 0x96, 0x32, 0xb7, 0x6c, 0x04, 0xe3, 0xbb, 0x26, 0xe8, 0x4b, 0xe1, 0x3d, 0xf8, 0xf6, 0xd0,
+  0xca, 0xaf, 0x1b, 0x83, 0x8e, 0xeb, 0x73, 0x07, 0x1d, 0xd7, 0x6b, 0x93, 0x35, 0xf8, 0x89, 0xe4,
+  0x25, 0x0b, 0x13, 0xae, 0xd4, 0xb0, 0x59, 0xf6, 0x8a, 0x45, 0x47, 0x2e, 0x72, 0x7a, 0xe8, 0x31,
+  0x19, 0x0d, 0x9b, 0x26, 0x1b, 0x36, 0x47, 0xdf, 0xfd, 0xf1, 0x1b, 0x68, 0xe8, 0x15, 0x7a, 0x8c,
+  0x04, 0x1a, 0x06, 0xfc, 0xe5, 0x2c, 0xce, 0xc5, 0x64, 0xd8, 0xec, 0x90, 0xd0, 0x1f, 0xfe, 0xf5,
+  0xf7, 0x5f, 0xb1, 0xe3, 0x0c, 0xd8, 0x4f, 0x07, 0x1d, 0x5e, 0x7f, 0x3b, 0x41, 0x6f, 0x9c, 0x46,
+  0xaa, 0x39, 0xfa, 0xf7, 0x9f, 0x7e, 0xfd, 0x2d, 0x7b, 0x62, 0x47, 0x5b, 0x32, 0xa8, 0x42, 0x17,
+  0x42, 0x1b, 0x99, 0xdf, 0xfe, 0x95, 0xbd, 0xb0, 0xa3, 0x2d, 0x19, 0x3e, 0x97, 0x1d, 0xf1, 0x8a,
+  0xae, 0x02, 0x8f, 0xa6, 0x5f, 0xca, 0xf9, 0xb0, 0x47, 0xd2, 0xbf, 0xf9, 0x07, 0x3b, 0x31, 0x73,
+  0x56, 0xb8, 0x63, 0x2d, 0xa3, 0x23, 0xd2, 0x11, 0xa8, 0x0d, 0x68, 0x16, 0x87, 0x35, 0x8d, 0x86,
+  0xeb, 0x09, 0xcc, 0x46, 0xdf, 0x90, 0xbd, 0xa9, 0x08, 0x35, 0xc0, 0x83, 0x3f, 0x07, 0x1d, 0x2c,
+  0xdb, 0x58, 0xac, 0x74, 0xb5, 0xd8, 0x12, 0xb3, 0x39, 0x7a, 0x6a, 0x1f, 0x0a, 0x61, 0xf7, 0xa3,
+  0xc2, 0x5c, 0xce, 0xf5, 0x88, 0xe8, 0xaa, 0x34, 0x7b, 0xf1, 0xfe, 0x87, 0x27, 0xbf, 0x38, 0x3b,
+  0xfd, 0xf9, 0x09, 0x1b, 0x82, 0x6b, 0xfd, 0x46, 0xa7, 0xc3, 0x1e, 0x67, 0x3a, 0x66, 0xa4, 0x11,
+  0x6c, 0xc5, 0x6d, 0x47, 0x30, 0x1d, 0x4b, 0xc5, 0xe6, 0x7c, 0x2a, 0x76, 0xf1, 0x28, 0xf0, 0x84,
+  0xf7, 0x5a, 0x24, 0x48, 0xc0, 0xcb, 0x58, 0x86, 0x31, 0x43, 0xf2, 0x62, 0xa8, 0xd0, 0x2a, 0xce,
+  0x96, 0x4e, 0xeb, 0xcb, 0xd3, 0x97, 0x4f, 0x49, 0x23, 0xd2, 0xa8, 0x89, 0x80, 0x80, 0xd6, 0xd0,
+  0x1d, 0x89, 0x0d, 0x87, 0x43, 0xe6, 0x15, 0x18, 0x7a, 0xec, 0x11, 0xf3, 0x5e, 0x14, 0xcf, 0xa0,
+  0xaa, 0x43, 0x1c, 0xc1, 0x13, 0x65, 0xe1, 0x62, 0x06, 0xfe, 0x06, 0xb6, 0xd0, 0x0d, 0xd9, 0xf9,
+  0xfd, 0x2b, 0xa3, 0x75, 0xcd, 0xda, 0xcc, 0xde, 0x92, 0xce, 0x6b, 0x52, 0x53, 0xa1, 0x4f, 0x12,
+  0x41, 0x8f, 0x8f, 0x57, 0xa7, 0x91, 0xef, 0x99, 0x55, 0x5e, 0x2b, 0xa0, 0xd0, 0x3e, 0xb6, 0x91,
+  0x40, 0x3a, 0x40, 0x10, 0x56, 0xea, 0xc1, 0xe0, 0xfb, 0x54, 0x10, 0x02, 0xd7, 0x35, 0x38, 0x4c,
+  0x4b, 0x2d, 0xe7, 0x06, 0xb2, 0x27, 0x02, 0x06, 0x19, 0x88, 0x14, 0x4b, 0xc5, 0x52, 0x00, 0x82,
+  0x89, 0xcc, 0xf1, 0x97, 0x2b, 0x03, 0x19, 0x0e, 0x05, 0x77, 0x9a, 0x47, 0x52, 0xcb, 0xe0, 0x83,
+  0x8c, 0xf0, 0x93, 0x29, 0x70, 0xa3, 0x5b, 0x63, 0x63, 0xb2, 0x48, 0x43, 0x42, 0x8a, 0x91, 0xf7,
+  0xfc, 0x45, 0x9e, 0xec, 0xb2, 0x1c, 0xab, 0x44, 0xde, 0xb2, 0x99, 0x05, 0x8b, 0x68, 0xe5, 0x49,
+  0x02, 0x23, 0x5e, 0x63, 0x72, 0xdf, 0xc9, 0x2b, 0xcc, 0x83, 0x3f, 0x1b, 0x2b, 0xc2, 0x5c, 0x20,
+  0x5b, 0xbb, 0x45, 0xbe, 0x07, 0x46, 0x90, 0x3c, 0xae, 0x1e, 0xc4, 0x36, 0xdc, 0x6b, 0x21, 0xdb,
+  0xb5, 0x63, 0x9d, 0x69, 0x4e, 0x4b, 0xd3, 0x45, 0x92, 0xd8, 0x99, 0xf1, 0x42, 0xad, 0x30, 0x31,
+  0xe1, 0x89, 0x42, 0xc2, 0xe2, 0x6a, 0x95, 0x86, 0xac, 0x34, 0x3b, 0x05, 0x4c, 0x3e, 0xd9, 0x2a,
+  0x27, 0xcc, 0x37, 0x92, 0x5f, 0x7d, 0xc5, 0x7c, 0xab, 0xe4, 0xde, 0xd0, 0xaa, 0x61, 0x3b, 0x3b,
+  0xc5, 0x36, 0xa3, 0xa1, 0xdd, 0xa0, 0xd5, 0xc2, 0x31, 0xf5, 0x22, 0x4f, 0x91, 0xb6, 0xad, 0x7a,
+  0x9d, 0x2f, 0x04, 0xd5, 0xb6, 0x55, 0x79, 0xee, 0x1c, 0xb3, 0x7c, 0xc9, 0x25, 0x30, 0x25, 0x98,
+  0x7d, 0x30, 0x01, 0xf8, 0xac, 0x1f, 0x59, 0x55, 0xc3, 0xfb, 0x57, 0xf6, 0x61, 0xbd, 0x93, 0xc8,
+  0x99, 0xa4, 0x71, 0xc9, 0xe9, 0xf5, 0x8e, 0x42, 0xb8, 0xe1, 0xf6, 0xad, 0xc2, 0x73, 0x1c, 0x93,
+  0x4c, 0xbb, 0x97, 0x07, 0xd9, 0x45, 0x0b, 0x9e, 0xc8, 0xb3, 0x25, 0xb9, 0x8a, 0x9d, 0xe4, 0x79,
+  0x96, 0xfb, 0xde, 0x13, 0x34, 0x14, 0xa8, 0x33, 0x70, 0x87, 0xd9, 0x84, 0x50, 0x29, 0x10, 0x98,
+  0xd3, 0x8d, 0xff, 0x14, 0x70, 0xe5, 0x81, 0xcd, 0x2a, 0x8a, 0x80, 0xf7, 0xbd, 0x9f, 0xb5, 0x5f,
+  0x92, 0x44, 0x1b, 0x57, 0xea, 0x14, 0xb0, 0xd3, 0x81, 0xbd, 0xae, 0x47, 0x09, 0xb8, 0x74, 0x41,
+  0xc4, 0x35, 0x2f, 0xad, 0xcf, 0x83, 0x2f, 0x54, 0x96, 0xfa, 0xce, 0x90, 0x02, 0x6f, 0x60, 0xd3,
+  0x25, 0xdc, 0xac, 0x77, 0x03, 0x13, 0xc3, 0xcf, 0x4c, 0xa4, 0x30, 0xcf, 0xeb, 0x17, 0xd3, 0x12,
+  0xc1, 0x9f, 0xff, 0xe8, 0xe5, 0x4f, 0x9f, 0xba, 0x69, 0x73, 0x94, 0xf7, 0xf3, 0x9c, 0xaf, 0x02,
+  0xa9, 0xcc, 0xaf, 0x4f, 0x7b, 0x19, 0x23, 0xee, 0xd1, 0x53, 0x90, 0x88, 0x74, 0xaa, 0xe3, 0x9a,
+  0xe6, 0x0d, 0x15, 0xf5, 0xcc, 0x5a, 0x2b, 0xe3, 0x26, 0xd7, 0xfc, 0x8d, 0x3d, 0xcb, 0xac, 0xe5,
+  0xfc, 0x12, 0xa8, 0xf0, 0x31, 0xe2, 0x6f, 0x25, 0x74, 0x30, 0x18, 0xe7, 0xa3, 0x81, 0x9a, 0x51,
+  0xab, 0x61, 0xd2, 0xf5, 0xb0, 0x59, 0x25, 0x78, 0xdb, 0x6c, 0xb1, 0x5a, 0xc3, 0x64, 0xea, 0x07,
+  0x2b, 0x1a, 0x2b, 0xdb, 0x50, 0x35, 0x47, 0x67, 0x9a, 0xe7, 0x9a, 0xc5, 0x0b, 0x62, 0xe6, 0x94,
+  0x71, 0x84, 0x45, 0x98, 0xe1, 0xac, 0x54, 0xb2, 0x19, 0xf5, 0xf0, 0xf9, 0x3d, 0xd4, 0x02, 0xda,
+  0x62, 0x64, 0xd3, 0x15, 0x8e, 0x9a, 0x8d, 0x95, 0xc8, 0xd1, 0xc2, 0x04, 0xd0, 0x15, 0xda, 0x24,
+  0x48, 0x18, 0x16, 0xb4, 0x59, 0x17, 0xe7, 0x33, 0x65, 0xd8, 0x2f, 0x48, 0x6f, 0x6a, 0x3c, 0x22,
+  0xf3, 0x23, 0xea, 0xb2, 0x22, 0xd0, 0x6f, 0x36, 0x16, 0xf9, 0x2e, 0xc3, 0x95, 0x01, 0x84, 0xa3,
+  0x29, 0x0a, 0x4c, 0x0e, 0x0f, 0x65, 0xa9, 0xa7, 0x19, 0x4a, 0x19, 0x08, 0x87, 0xf0, 0x94, 0x39,
+  0x43, 0xf3, 0x84, 0x9c, 0xda, 0x30, 0x20, 0x42, 0xfc, 0x84, 0x83, 0x72, 0x3e, 0xb5, 0xed, 0xbb,
+  0x4c, 0xb6, 0xd8, 0x70, 0xe4, 0xe2, 0xd2, 0x4d, 0x59, 0x92, 0xb4, 0x59, 0x0f, 0xff, 0x0a, 0x9f,
+  0xbe, 0x03, 0xc1, 0x16, 0x0c, 0x28, 0x86, 0xc3, 0x2a, 0xcb, 0x6e, 0xf8, 0xbe, 0x0c, 0x02, 0xba,
+  0xdc, 0xdc, 0x7c, 0xca, 0xe2, 0x38, 0x41, 0x2e, 0x66, 0xe8, 0xe3, 0x7c, 0x7b, 0xc1, 0x81, 0xbd,
+  0x94, 0x6f, 0x7c, 0x41, 0xdc, 0x2d, 0x12, 0x44, 0x96, 0x88, 0x40, 0x58, 0x32, 0x1b, 0x4e, 0x1f,
+  0x81, 0x8a, 0x56, 0xa0, 0xa2, 0xb2, 0xdd, 0xf8, 0x56, 0x4c, 0xff, 0x1b, 0xa6, 0x14, 0x1c, 0xd8,
+  0xba, 0x5d, 0x51, 0x7b, 0xb4, 0x77, 0xd0, 0x67, 0x5b, 0x63, 0x2a, 0xbb, 0x7f, 0xa6, 0xb2, 0x5b,
+  0xc5, 0x19, 0x25, 0x3a, 0x43, 0xb3, 0x1a, 0xb1, 0x46, 0xc7, 0xb1, 0x00, 0x13, 0xdc, 0x71, 0x8c,
+  0xb7, 0x5c, 0xaf, 0x1f, 0x5c, 0xe3, 0xc5, 0x1a, 0x29, 0x36, 0xc5, 0x0c, 0x25, 0x8a, 0xcd, 0xd4,
+  0x64, 0x1c, 0xff, 0x13, 0x21, 0xe6, 0x6c, 0x9a, 0x11, 0xcd, 0x50, 0xa5, 0x12, 0x61, 0x92, 0x6f,
+  0x99, 0x12, 0x25, 0x75, 0x62, 0x12, 0x4c, 0xbe, 0x94, 0x4a, 0x82, 0xe0, 0x45, 0xaa, 0x01, 0x10,
+  0xd0, 0x53, 0xa2, 0x8e, 0x38, 0x7f, 0x4c, 0x8d, 0x24, 0xb4, 0x1c, 0x27, 0xf4, 0x29, 0xec, 0x23,
+  0x87, 0x14, 0x79, 0xb1, 0x94, 0x92, 0xca, 0x15, 0x67, 0x1c, 0x0c, 0x29, 0x8e, 0x94, 0x04, 0x08,
+  0x01, 0x36, 0x60, 0x4b, 0x99, 0xa2, 0x99, 0x76, 0x80, 0x9a, 0x3b, 0x48, 0xcb, 0x65, 0x4a, 0xb2,
+  0xd2, 0xee, 0x59, 0xf8, 0x82, 0x72, 0x2d, 0xf2, 0xd1, 0x29, 0xf5, 0x9f, 0x4a, 0x98, 0xac, 0xfa,
+  0xdc, 0xbd, 0xf2, 0x7d, 0x6c, 0x85, 0xd2, 0xa8, 0x0c, 0xff, 0x6c, 0x8e, 0x75, 0x33, 0x81, 0x42,
+  0xfc, 0xf8, 0x82, 0xe6, 0x05, 0x0c, 0xa9, 0x56, 0xa7, 0xd3, 0x56, 0x6d, 0xaf, 0x56, 0xcd, 0xe7,
+  0xee, 0xa1, 0x1e, 0x2a, 0x95, 0x4d, 0x40, 0xee, 0x29, 0x35, 0x1f, 0xa8, 0xef, 0xa8, 0x11, 0x94,
+  0x86, 0xcd, 0xf5, 0xe1, 0xcc, 0x2c, 0x6d, 0x9f, 0x51, 0x15, 0x3c, 0xb9, 0xc4, 0x5f, 0x65, 0x7b,
+  0x81, 0x31, 0xd2, 0x28, 0xb4, 0x99, 0x98, 0x32, 0x10, 0x28, 0x74, 0x03, 0x4c, 0xd2, 0xcf, 0x32,
+  0xad, 0x15, 0x35, 0x49, 0xdc, 0x2d, 0x33, 0xba, 0x78, 0x4d, 0x15, 0xbb, 0x14, 0xb5, 0x2a, 0x66,
+  0xae, 0x17, 0x43, 0xea, 0x68, 0xd1, 0xae, 0x7a, 0x6d, 0xb0, 0x7a, 0x2e, 0x70, 0x46, 0xf4, 0x94,
+  0x78, 0x5a, 0xa6, 0x22, 0xb2, 0x4f, 0xb6, 0x8b, 0x30, 0xcf, 0x20, 0x2b, 0xf5, 0xbd, 0x1e, 0x5b,
+  0x97, 0x4a, 0xd0, 0x9a, 0x40, 0x87, 0xef, 0xf0, 0x13, 0x5b, 0x79, 0xd6, 0xec, 0xd8, 0xa7, 0xe9,
+  0xad, 0x6a, 0x6f, 0x3b, 0xaf, 0x18, 0xd5, 0xde, 0x98, 0x11, 0x84, 0x31, 0xda, 0x86, 0xaf, 0xff,
+  0xc2, 0x5e, 0x90, 0x05, 0xe5, 0xac, 0xb1, 0xc7, 0xbd, 0x20, 0x83, 0xaa, 0x17, 0x34, 0x72, 0x2f,
+  0xac, 0x7d, 0xd5, 0x2b, 0x3b, 0x5e, 0x9f, 0xb3, 0x77, 0x1a, 0xbe, 0x9d, 0x22, 0xb3, 0xd1, 0x10,
+  0x9d, 0x1b, 0xf9, 0x42, 0x8e, 0x26, 0x21, 0x44, 0xc7, 0x21, 0xff, 0x14, 0x07, 0x02, 0xa6, 0x38,
+  0x8e, 0x5e, 0xcd, 0xd1, 0x93, 0x4d, 0x52, 0x73, 0x2c, 0x70, 0x01, 0xcd, 0xb5, 0x71, 0xce, 0x53,
+  0xc4, 0xb1, 0x00, 0xe5, 0x9c, 0x80, 0x2f, 0xec, 0xb9, 0x21, 0xe9, 0xff, 0xf8, 0xec, 0xf9, 0xb3,
+  0xc0, 0x54, 0x34, 0x5f, 0x04, 0xa6, 0x64, 0xb4, 0xfa, 0x06, 0x1e, 0xb8, 0x9f, 0xad, 0x4b, 0xd4,
+  0xd1, 0xc7, 0x58, 0x3a, 0x1a, 0x7d, 0x67, 0xd9, 0x22, 0x0f, 0x85, 0xef, 0xd9, 0xbe, 0xd6, 0xb8,
+  0x9f, 0xac, 0xc1, 0x8e, 0x68, 0xfd, 0x28, 0xc5, 0x54, 0xd8, 0xb2, 0x9b, 0xb0, 0x2d, 0x5a, 0x59,
+  0xba, 0x86, 0x80, 0x88, 0xa9, 0xef, 0xc5, 0x68, 0x1f, 0x33, 0xb8, 0xd2, 0x8f, 0xcc, 0xb2, 0xe7,
+  0xe3, 0x2f, 0x28, 0x68, 0xb0, 0x0c, 0x97, 0x30, 0x0b, 0xc7, 0x2e, 0x8b, 0x4c, 0x0e, 0x85, 0x70,
+  0x18, 0x73, 0x70, 0x2b, 0xa9, 0xc4, 0xaf, 0x58, 0xe1, 0x0e, 0xe2, 0x11, 0x7e, 0xac, 0xe9, 0x46,
+  0x96, 0x8a, 0xb1, 0xc8, 0xaf, 0xc9, 0x7e, 0x16, 0x05, 0x17, 0x9f, 0x1b, 0xe9, 0xcb, 0x4a, 0x58,
+  0x09, 0x91, 0x5e, 0xd7, 0x6a, 0xfc, 0x60, 0x1a, 0xce, 0x28, 0xa0, 0x9e, 0x75, 0xcd, 0x48, 0x8e,
+  0xf9, 0x34, 0xce, 0x61, 0xe1, 0x3a, 0x7a, 0x3c, 0x6b, 0x9d, 0x57, 0x5a, 0xa6, 0x00, 0xe1, 0x2e,
+  0x5a, 0x12, 0x31, 0xd1, 0xb5, 0x65, 0xa4, 0x8a, 0x96, 0xd9, 0x55, 0xe5, 0xac, 0xa0, 0xbe, 0xaa,
+  0x9a, 0xdf, 0xd4, 0xe6, 0xcd, 0xa4, 0x52, 0x20, 0x98, 0xf3, 0x81, 0x55, 0x46, 0x15, 0xd0, 0x96,
+  0x86, 0x32, 0xde, 0xd0, 0xf0, 0xf8, 0x8a, 0xe2, 0xcd, 0x56, 0x49, 0x76, 0x86, 0x5c, 0x91, 0x4e,
+  0x7d, 0xc5, 0x1e, 0x3d, 0x22, 0x22, 0xa1, 0x9a, 0xa0, 0x2a, 0xc3, 0xa3, 0x9d, 0xcf, 0x76, 0x06,
+  0xa3, 0xa6, 0xf7, 0x79, 0x67, 0xba, 0xcb, 0x66, 0xb4, 0x9f, 0x7f, 0xd5, 0xf0, 0x76, 0x3c, 0xb0,
+  0x6d, 0x87, 0xcf, 0xe6, 0x7d, 0x6f, 0xb7, 0xe1, 0x0d, 0xcc, 0x28, 0xd1, 0x66, 0x30, 0x32, 0x83,
+  0xa9, 0x1d, 0x34, 0xcd, 0xe0, 0x97, 0x8b, 0xcc, 0x0c, 0x9b, 0x5e, 0x93, 0x86, 0x6f, 0xed, 0xbd,
+  0xd7, 0xf7, 0x1a, 0xeb, 0xcf, 0x66, 0x9f, 0xb7, 0x8c, 0x69, 0x94, 0xaa, 0x6e, 0xbb, 0x05, 0xb8,
+  0xdb, 0x96, 0x67, 0x9a, 0x14, 0x6a, 0x7b, 0x2d, 0xc1, 0x8a, 0x69, 0x60, 0x80, 0xec, 0xe2, 0x42,
+  0xd6, 0xf5, 0x53, 0xaf, 0xef, 0x65, 0xa3, 0x4d, 0xfa, 0xd1, 0x25, 0xd5, 0x2b, 0x58, 0x6d, 0xf7,
+  0x36, 0xe8, 0x40, 0xb3, 0x71, 0x8b, 0xe9, 0xda, 0x3e, 0x4e, 0x2f, 0x52, 0xe4, 0xab, 0x2a, 0xe9,
+  0xc8, 0xa8, 0x26, 0x26, 0x23, 0x4a, 0x94, 0xda, 0x74, 0xb4, 0xde, 0xb3, 0xce, 0xfb, 0xc0, 0x4f,
+  0x2d, 0xc6, 0xca, 0x42, 0x4a, 0x5f, 0x49, 0x0f, 0x5a, 0x28, 0xf9, 0xee, 0xd2, 0x6f, 0xd7, 0x4f,
+  0x00, 0x6e, 0x4d, 0x83, 0x19, 0xd2, 0x6a, 0xff, 0xbb, 0xdf, 0xff, 0xee, 0xbb, 0xaf, 0xff, 0x89,
+  0xbf, 0xad, 0x6a, 0xb3, 0x69, 0x2e, 0xa3, 0x4f, 0x4c, 0xfe, 0x2f, 0xe4, 0x69, 0xe6, 0x17, 0xc8,
+  0xb7, 0x8a, 0x7c, 0x59, 0xee, 0x5a, 0xc8, 0x5f, 0x6e, 0xc8, 0xde, 0x2a, 0x46, 0xfc, 0x82, 0x1c,
+  0xc9, 0x98, 0xc7, 0x7b, 0xae, 0x09, 0x2f, 0x32, 0xcc, 0x19, 0x42, 0x8d, 0x27, 0x47, 0xc8, 0x34,
+  0x85, 0x08, 0x11, 0xdb, 0xa6, 0x9a, 0x42, 0x87, 0x8b, 0x3c, 0xa7, 0xa6, 0x18, 0x6d, 0x6b, 0x3a,
+  0x8e, 0x0b, 0x2d, 0x4e, 0x62, 0x5d, 0x68, 0x89, 0x36, 0x7a, 0x89, 0xf3, 0xcd, 0x0b, 0x7d, 0xf5,
+  0xb1, 0x94, 0xae, 0xf4, 0x6a, 0xce, 0xd3, 0x8d, 0x57, 0xee, 0x4e, 0x7f, 0xff, 0x8a, 0xd0, 0x5b,
+  0x63, 0x03, 0x13, 0x45, 0x68, 0x03, 0x20, 0xb8, 0x25, 0x6f, 0x3e, 0x38, 0x34, 0x47, 0xa7, 0x1f,
+  0x90, 0x1d, 0x32, 0xaa, 0x84, 0x6a, 0xd7, 0xe4, 0xba, 0x6a, 0xd7, 0x53, 0x60, 0xdb, 0x0f, 0x81,
+  0x34, 0x2d, 0x72, 0x3e, 0xb0, 0xb9, 0xfa, 0x13, 0x0b, 0x29, 0xcd, 0x03, 0xdd, 0x35, 0x8e, 0x46,
+  0xe0, 0xdc, 0xbf, 0x2a, 0x4e, 0x57, 0xe8, 0xbd, 0xc3, 0xed, 0x91, 0xcf, 0xe7, 0xe0, 0xf2, 0x31,
+  0x1a, 0x90, 0x08, 0xf9, 0xc1, 0x16, 0xe2, 0xef, 0x0f, 0x8a, 0xe2, 0x6a, 0xbc, 0x15, 0x14, 0xc5,
+  0xb4, 0x0d, 0x0a, 0xba, 0x1c, 0x86, 0x69, 0xf6, 0x26, 0x63, 0x63, 0x8b, 0xf2, 0x94, 0x29, 0xec,
+  0x1e, 0x65, 0x0d, 0x55, 0x1b, 0x22, 0x66, 0x68, 0x38, 0x1d, 0xcb, 0x08, 0x11, 0x82, 0x6a, 0xa1,
+  0x97, 0x59, 0x7e, 0x51, 0x23, 0xf6, 0x78, 0x6b, 0xc9, 0xb8, 0x5c, 0xb3, 0x41, 0x54, 0xfa, 0x66,
+  0x42, 0xec, 0xa8, 0x9d, 0xb3, 0x53, 0x7c, 0xc2, 0x7c, 0x24, 0x23, 0x5c, 0xe8, 0x44, 0x1a, 0x66,
+  0x91, 0xf8, 0xf8, 0xa3, 0xd3, 0xe3, 0x6c, 0x36, 0x47, 0xb6, 0xc5, 0x91, 0x64, 0xd4, 0xa2, 0xbb,
+  0xf7, 0x1b, 0x20, 0x98, 0xa9, 0xf1, 0x28, 0xb7, 0xaa, 0x4e, 0x9c, 0x37, 0xc3, 0xae, 0xc7, 0x67,
+  0x67, 0x76, 0x95, 0x39, 0x79, 0xc9, 0x9b, 0xf2, 0x3b, 0xd1, 0xfd, 0x2b, 0xfa, 0x5d, 0x97, 0x5f,
+  0x6e, 0x36, 0x3e, 0xdc, 0x1a, 0xcb, 0xbe, 0x65, 0x1f, 0xb8, 0x39, 0x16, 0xc4, 0xe1, 0x83, 0x07,
+  0xdd, 0x6e, 0xd7, 0x7c, 0x3d, 0xfa, 0x9f, 0xa9, 0x07, 0xe3, 0xdd, 0xf7, 0x9f, 0x41, 0xc7, 0x7d,
+  0x64, 0xeb, 0xd8, 0xff, 0xef, 0xfd, 0x1f, 0xbd, 0x89, 0xae, 0xaf, 0x08, 0x1f, 0x00, 0x00,
+};
+static const WebAsset WEB_LIST_HTML = {"text/html", "\"2e670613ea49bdbc\"", WEB_LIST_HTML_GZ, sizeof(WEB_LIST_HTML_GZ), 7944};
+
+#endif
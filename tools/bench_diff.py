@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""Compares two microbenchmark runs (see src/microbench.h).
+
+    python3 tools/bench_diff.py before.json after.json [--threshold 5]
+
+Each file is the JSON from `program bench --out`, or a serial log holding it
+between "=== BENCH BEGIN ===" and "=== BENCH END ===". Prints time per
+iteration (and cycles, for device runs) side by side and exits with 1 when
+a case got slower by more than the threshold in percent. Only the Python
+standard library is used.
+"""
+
+import argparse
+import json
+import sys
+
+BEGIN = "=== BENCH BEGIN ==="
+END = "=== BENCH END ==="
+
+
+def load(path):
+    with open(path, encoding="utf-8", errors="replace") as f:
+        text = f.read()
+    if BEGIN in text:
+        text = text.split(BEGIN, 1)[1].split(END, 1)[0]
+    results = {}
+    for bench in json.loads(text)["benchmarks"]:
+        results[bench["name"]] = bench
+    return results
+
+
+def change(old, new):
+    return (new - old) / old * 100 if old else 0.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("before")
+    parser.add_argument("after")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="percent slower that counts as a regression")
+    args = parser.parse_args()
+
+    before, after = load(args.before), load(args.after)
+    regressions = 0
+    print("%-32s %12s %12s %8s %10s" % ("benchmark", "before ns", "after ns", "time", "cycles"))
+    for name in list(before) + [n for n in after if n not in before]:
+        old, new = before.get(name), after.get(name)
+        if old is None or new is None:
+            print("%-32s %s" % (name, "only before" if new is None else "only after"))
+            continue
+        if old.get("error_occurred") or new.get("error_occurred"):
+            print("%-32s %s" % (name, new.get("error_message") or old.get("error_message")))
+            continue
+        time_pct = change(old["real_time"], new["real_time"])
+        cycles = ""
+        if "cycles_per_iteration" in old and "cycles_per_iteration" in new:
+            cycles = "%+.1f%%" % change(old["cycles_per_iteration"], new["cycles_per_iteration"])
+        flag = ""
+        if time_pct > args.threshold:
+            flag = "  <-- slower"
+            regressions += 1
+        print("%-32s %12.1f %12.1f %+7.1f%% %10s%s" %
+              (name, old["real_time"], new["real_time"], time_pct, cycles, flag))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Builds the capture corpus for the native sniffer replay benchmark.
+
+    python3 tools/gen_replay_corpus.py
+
+writes radiotap pcap files to tools/replay_corpus/, then replay them with
+
+    .pio/build/native/program replay tools/replay_corpus/mix.pcap --loops 20
+
+The pwngrid beacons are built from pwngrid_beacon.hexdump, a single frame
+captured from a real pwnagotchi, with the identity, name and session of each
+synthetic peer swapped in. The output is deterministic, so the corpus only
+changes when this script does. Only the Python standard library is used.
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import random
+import struct
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "pwngrid_beacon.hexdump")
+OUT_DIR = os.path.join(ROOT, "tools", "replay_corpus")
+
+PWNGRID_IE = 222
+BEACON_INTERVAL_US = 102400
+
+
+def radiotap(channel, rssi):
+    """Flags, channel and dBm signal, the fields the replay harness reads."""
+    freq = 2484 if channel == 14 else 2407 + 5 * channel
+    present = (1 << 1) | (1 << 3) | (1 << 5)
+    # Header, flags, pad to 2, channel freq + flags (2.4 GHz OFDM), signal
+    body = struct.pack("<BBHHb", 0, 0, freq, 0x00C0, rssi)
+    return struct.pack("<BBHI", 0, 0, 8 + len(body), present) + body
+
+
+def mgmt_header(subtype, da, sa, bssid, seq):
+    fc = subtype << 4
+    return struct.pack("<HH", fc, 0) + da + sa + bssid + struct.pack("<H", (seq & 0xFFF) << 4)
+
+
+def ie(tag, data):
+    return bytes([tag, len(data)]) + data
+
+
+def parse_source():
+    """Returns the 802.11 header + fixed fields and the JSON of the sample beacon."""
+    with open(SOURCE, "rb") as f:
+        raw = f.read()
+    rt_len = struct.unpack_from("<H", raw, 2)[0]
+    flags = raw[24]  # Flags field, right after the 8 byte aligned TSFT
+    frame = raw[rt_len:-4] if flags & 0x10 else raw[rt_len:]
+    head = frame[:36]
+    pos, payload = 36, b""
+    while pos + 2 <= len(frame):
+        tag, length = frame[pos], frame[pos + 1]
+        if tag == PWNGRID_IE:
+            payload += frame[pos + 2:pos + 2 + length]
+        pos += 2 + length
+    return frame, head, json.loads(payload.decode("utf-8"))
+
+
+def pwngrid_beacon(head, advert, seq):
+    data = json.dumps(advert, separators=(",", ":"), ensure_ascii=False).encode("utf-8")
+    ies = b"".join(ie(PWNGRID_IE, data[i:i + 255]) for i in range(0, len(data), 255))
+    return head[:22] + struct.pack("<H", (seq & 0xFFF) << 4) + head[24:] + ies
+
+
+def peer_advert(template, index, rng):
+    advert = dict(template)
+    advert["identity"] = hashlib.sha256(("peer-%d" % index).encode()).hexdigest()
+    advert["name"] = "peer%02d" % index
+    advert["session_id"] = ":".join("%02x" % b for b in [0x02] + [rng.randrange(256) for _ in range(5)])
+    advert["pwnd_tot"] = rng.randrange(500)
+    advert["uptime"] = rng.randrange(100000)
+    return advert
+
+
+def ap_beacon(bssid, ssid, channel, seq):
+    fixed = struct.pack("<QHH", 0, 100, 0x0431)
+    rates = ie(1, bytes([0x82, 0x84, 0x8B, 0x96, 0x0C, 0x12, 0x18, 0x24]))
+    rsn = ie(48, bytes.fromhex("0100000fac040100000fac040100000fac020000"))
+    body = fixed + ie(0, ssid.encode()) + rates + ie(3, bytes([channel])) + rsn
+    return mgmt_header(8, b"\xff" * 6, bssid, bssid, seq) + body
+
+
+def probe_request(client, ssid, seq):
+    rates = ie(1, bytes([0x02, 0x04, 0x0B, 0x16]))
+    return mgmt_header(4, b"\xff" * 6, client, b"\xff" * 6, seq) + ie(0, ssid.encode()) + rates
+
+
+def random_mac(rng, local=True):
+    mac = [rng.randrange(256) for _ in range(6)]
+    mac[0] = (mac[0] & 0xFC) | (0x02 if local else 0x00)
+    return bytes(mac)
+
+
+def write_pcap(path, records):
+    """records: (timestamp us, channel, rssi, frame), written in time order."""
+    records.sort(key=lambda r: r[0])
+    with open(path, "wb") as f:
+        f.write(struct.pack("<IHHiIII", 0xA1B2C3D4, 2, 4, 0, 0, 65535, 127))
+        for ts, channel, rssi, frame in records:
+            data = radiotap(channel, rssi) + frame
+            f.write(struct.pack("<IIII", ts // 1000000, ts % 1000000, len(data), len(data)))
+            f.write(data)
+    print("%-40s %5d frames, %7d bytes" % (os.path.relpath(path, ROOT), len(records), os.path.getsize(path)))
+
+
+def pwngrid_records(head, template, rng, peers, duration_us, start_us, interval_us):
+    records = []
+    for p in range(peers):
+        advert = peer_advert(template, p, rng)
+        channel = rng.choice([1, 6, 11])
+        base_rssi = rng.randrange(-85, -40)
+        t = start_us + rng.randrange(interval_us)
+        seq = rng.randrange(4096)
+        while t < start_us + duration_us:
+            rssi = max(-95, min(-20, base_rssi + rng.randrange(-6, 7)))
+            records.append((t, channel, rssi, pwngrid_beacon(head, advert, seq)))
+            seq += 1
+            t += interval_us + rng.randrange(-interval_us // 10, interval_us // 10)
+    return records
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--out", default=OUT_DIR)
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+    os.makedirs(args.out, exist_ok=True)
+
+    original, head, template = parse_source()
+    start_us = 1683387465 * 1000000  # The sample's own timestamp
+
+    # The captured beacon as is, on its channel and signal
+    write_pcap(os.path.join(args.out, "pwngrid_beacon.pcap"), [(start_us, 10, -37, original)])
+
+    # Sixteen peers advertising once a second for 10 s
+    rng = random.Random(args.seed)
+    write_pcap(os.path.join(args.out, "pwngrid_peers.pcap"),
+               pwngrid_records(head, template, rng, 16, 10 * 1000000, start_us, 1000000))
+
+    # A busy spot: 30 APs beaconing, phones probing, four pwnagotchis around
+    rng = random.Random(args.seed + 1)
+    duration_us = 5 * 1000000
+    records = []
+    for a in range(30):
+        bssid = random_mac(rng, local=False)
+        ssid = "net-%02d" % a if a % 7 else ""
+        channel = rng.choice([1, 6, 11, 1, 6, 11, 3, 9])
+        rssi = rng.randrange(-90, -35)
+        seq = rng.randrange(4096)
+        t = start_us + rng.randrange(BEACON_INTERVAL_US)
+        while t < start_us + duration_us:
+            records.append((t, channel, rssi, ap_beacon(bssid, ssid, channel, seq)))
+            seq += 1
+            t += BEACON_INTERVAL_US
+    clients = [random_mac(rng) for _ in range(12)]
+    for _ in range(100):
+        ssid = rng.choice(["", "", "home", "CoffeeShop", "eduroam", "net-03"])
+        records.append((start_us + rng.randrange(duration_us), rng.choice([1, 6, 11]),
+                        rng.randrange(-90, -50), probe_request(rng.choice(clients), ssid, rng.randrange(4096))))
+    records += pwngrid_records(head, template, rng, 4, duration_us, start_us, 1000000)
+    write_pcap(os.path.join(args.out, "mix.pcap"), records)
+
+    # A probe request burst: 1000 frames in half a second from random MACs
+    rng = random.Random(args.seed + 2)
+    records = []
+    for i in range(1000):
+        ssid = rng.choice(["", "", "", "home", "guest", "AndroidAP"])
+        records.append((start_us + i * 500, 6, rng.randrange(-85, -45),
+                        probe_request(random_mac(rng), ssid, i)))
+    write_pcap(os.path.join(args.out, "probe_burst.pcap"), records)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Latency and concurrency benchmark for the Gotchi AP config portal.
+
+Connect to the Gotchi access point, then run for example:
+
+    python3 tools/http_bench.py --host 192.168.4.1 --clients 4 --requests 50
+
+Each client keeps one HTTP/1.1 connection alive and issues requests over it,
+cycling through the given paths. With --slow, one extra client opens a
+connection and trickles a request byte by byte, to check that a slow peer
+does not stall the others. Only the Python standard library is used.
+"""
+
+import argparse
+import http.client
+import socket
+import statistics
+import threading
+import time
+
+DEFAULT_PATHS = ["/api/config", "/api/friends?limit=20", "/api/packets?limit=20", "/"]
+
+
+def percentile(values, pct):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    k = min(len(values) - 1, max(0, int(round(pct / 100.0 * (len(values) - 1)))))
+    return values[k]
+
+
+def client_worker(host, port, paths, count, timeout, results, lock):
+    latencies = []
+    errors = 0
+    reconnects = 0
+    conn = http.client.HTTPConnection(host, port, timeout=timeout)
+    for i in range(count):
+        path = paths[i % len(paths)]
+        start = time.perf_counter()
+        try:
+            conn.request("GET", path, headers={"Connection": "keep-alive"})
+            resp = conn.getresponse()
+            resp.read()
+            if resp.status != 200:
+                errors += 1
+            latencies.append((time.perf_counter() - start) * 1000.0)
+            if resp.will_close:
+                conn.close()
+                reconnects += 1
+        except (OSError, http.client.HTTPException):
+            errors += 1
+            conn.close()
+            reconnects += 1
+            conn = http.client.HTTPConnection(host, port, timeout=timeout)
+    conn.close()
+    with lock:
+        results["latencies"].extend(latencies)
+        results["errors"] += errors
+        results["reconnects"] += reconnects
+
+
+def slow_client(host, port, stop, delay):
+    request = b"GET /api/config HTTP/1.1\r\nHost: %s\r\n\r\n" % host.encode()
+    try:
+        with socket.create_connection((host, port), timeout=30) as s:
+            for b in request:
+                if stop.is_set():
+                    return
+                s.send(bytes([b]))
+                time.sleep(delay)
+    except OSError:
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="192.168.4.1")
+    parser.add_argument("--port", type=int, default=80)
+    parser.add_argument("--clients", type=int, default=4, help="concurrent keep-alive connections")
+    parser.add_argument("--requests", type=int, default=50, help="requests per client")
+    parser.add_argument("--timeout", type=float, default=10.0)
+    parser.add_argument("--path", action="append", help="path to request, may be repeated")
+    parser.add_argument("--slow", action="store_true", help="add a slow client trickling its request")
+    args = parser.parse_args()
+
+    paths = args.path or DEFAULT_PATHS
+    results = {"latencies": [], "errors": 0, "reconnects": 0}
+    lock = threading.Lock()
+    stop = threading.Event()
+
+    slow = None
+    if args.slow:
+        slow = threading.Thread(target=slow_client, args=(args.host, args.port, stop, 0.2), daemon=True)
+        slow.start()
+
+    threads = [
+        threading.Thread(target=client_worker,
+                         args=(args.host, args.port, paths, args.requests, args.timeout, results, lock))
+        for _ in range(args.clients)
+    ]
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.perf_counter() - start
+    stop.set()
+
+    lat = results["latencies"]
+    total = args.clients * args.requests
+    print("clients:     %d%s" % (args.clients, " (+1 slow)" if slow else ""))
+    print("requests:    %d in %.2f s (%.1f req/s)" % (total, elapsed, len(lat) / elapsed if elapsed else 0))
+    print("errors:      %d, reconnects: %d" % (results["errors"], results["reconnects"]))
+    if lat:
+        print("latency ms:  p50 %.1f  p95 %.1f  p99 %.1f  max %.1f  mean %.1f" % (
+            percentile(lat, 50), percentile(lat, 95), percentile(lat, 99), max(lat), statistics.mean(lat)))
+
+
+if __name__ == "__main__":
+    main()